@@ -21,6 +21,8 @@
 #include <utility> // std::move
 #include <type_traits> // std::enable_if
 #include <istream> // std::basic_istream
+#include <atomic> // std::atomic
+#include <functional> // std::hash
 #include <jsoncons/json_fwd.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/config/version.hpp>
@@ -29,11 +31,14 @@
 #include <jsoncons/pretty_print.hpp>
 #include <jsoncons/json_object.hpp>
 #include <jsoncons/json_array.hpp>
+#include <jsoncons/small_vector.hpp>
+#include <jsoncons/interned_key.hpp>
 #include <jsoncons/bigint.hpp>
 #include <jsoncons/json_options.hpp>
 #include <jsoncons/json_encoder.hpp>
 #include <jsoncons/json_decoder.hpp>
 #include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_parse_context.hpp>
 #include <jsoncons/json_type_traits.hpp>
 #include <jsoncons/byte_string.hpp>
 #include <jsoncons/json_error.hpp>
@@ -59,6 +64,12 @@ namespace jsoncons {
         template <class Container>
         using 
         container_const_object_iterator_type_t = decltype(Container::const_object_iterator_type);
+        template <class Container>
+        using 
+        container_node_size_t = decltype(Container::node_size);
+        template <class Container>
+        using 
+        container_copy_on_write_t = decltype(Container::copy_on_write);
 
         namespace detail {
 
@@ -80,6 +91,42 @@ namespace jsoncons {
 
     namespace detail {
 
+        // The size of a basic_json with this policy, Policy::node_size if defined, otherwise 16
+
+        template <class Policy,class Enable = void>
+        struct json_node_size : std::integral_constant<std::size_t,16> {};
+
+        template <class Policy>
+        struct json_node_size<Policy,typename std::enable_if<extension_traits::is_detected<extension_traits::container_node_size_t,Policy>::value>::type>
+            : std::integral_constant<std::size_t,Policy::node_size> {};
+
+        // True if Policy::copy_on_write is defined and true
+
+        template <class Policy,class Enable = void>
+        struct json_copy_on_write : std::false_type {};
+
+        template <class Policy>
+        struct json_copy_on_write<Policy,typename std::enable_if<extension_traits::is_detected<extension_traits::container_copy_on_write_t,Policy>::value>::type>
+            : std::integral_constant<bool,Policy::copy_on_write> {};
+
+        // An array or object with a count of the basic_json values that share it
+
+        template <class T>
+        struct shared_node
+        {
+            T value;
+            std::atomic<std::size_t> refs;
+
+            template <class... Args>
+            explicit shared_node(Args&&... args)
+                : value(std::forward<Args>(args)...), refs(1)
+            {
+            }
+
+            shared_node(const shared_node&) = delete;
+            shared_node& operator=(const shared_node&) = delete;
+        };
+
         template <class Iterator,class Enable = void>
         class random_access_iterator_wrapper
         {
@@ -255,13 +302,23 @@ namespace jsoncons {
         };
     } // namespace detail
 
+    // Sequence containers for the elements of arrays and the members of objects. Arrays of up to 
+    // two elements, and objects with one member with a std::string key, need no allocation
+    // beyond the array or object itself.
+
+    template <class T,class Allocator>
+    using json_array_container = small_vector<T,Allocator,32>;
+
+    template <class T,class Allocator>
+    using json_object_container = small_vector<T,Allocator,48>;
+
     struct sorted_policy 
     {
         template <class KeyT,class Json>
-        using object = sorted_json_object<KeyT,Json,std::vector>;
+        using object = sorted_json_object<KeyT,Json,json_object_container>;
 
         template <class Json>
-        using array = json_array<Json,std::vector>;
+        using array = json_array<Json,json_array_container>;
         
         template <class CharT, class CharTraits, class Allocator>
         using member_key = std::basic_string<CharT, CharTraits, Allocator>;
@@ -270,15 +327,51 @@ namespace jsoncons {
     struct order_preserving_policy
     {
         template <class KeyT,class Json>
-        using object = order_preserving_json_object<KeyT,Json,std::vector>;
+        using object = order_preserving_json_object<KeyT,Json,json_object_container>;
 
         template <class Json>
-        using array = json_array<Json,std::vector>;
+        using array = json_array<Json,json_array_container>;
         
         template <class CharT, class CharTraits, class Allocator>
         using member_key = std::basic_string<CharT, CharTraits, Allocator>;
     };
 
+    // Policy with the object and array types and member keys of Policy, and a basic_json of 
+    // NodeSize bytes, which may be 16 (the default), 24 or 32. A basic_json stores strings 
+    // of up to NodeSize - 3 single byte characters without allocating.
+
+    template <class Policy, std::size_t NodeSize>
+    struct node_size_policy : public Policy
+    {
+        static_assert(NodeSize == 16 || NodeSize == 24 || NodeSize == 32, "NodeSize must be 16, 24 or 32");
+
+        static constexpr std::size_t node_size = NodeSize;
+    };
+
+    template <class Policy, std::size_t NodeSize>
+    constexpr std::size_t node_size_policy<Policy,NodeSize>::node_size;
+
+    // Policy with the object and array types and member keys of Policy, and arrays and objects 
+    // that are shared by copies of a basic_json until one of them is modified
+
+    template <class Policy>
+    struct copy_on_write_policy : public Policy
+    {
+        static constexpr bool copy_on_write = true;
+    };
+
+    template <class Policy>
+    constexpr bool copy_on_write_policy<Policy>::copy_on_write;
+
+    // Policy with the object and array types of Policy, and interned member keys
+
+    template <class Policy>
+    struct interned_key_policy : public Policy
+    {
+        template <class CharT, class CharTraits, class Allocator>
+        using member_key = basic_interned_key<CharT, CharTraits, Allocator>;
+    };
+
     template<class Policy, class KeyT,class Json, class Enable=void>
     struct object_iterator_typedefs
     {
@@ -603,31 +696,44 @@ namespace jsoncons {
             uint8_t small_string_length_:4;
             semantic_tag tag_;
         private:
-            static constexpr size_t capacity = (2*sizeof(uint64_t) - 2*sizeof(uint8_t))/sizeof(char_type);
+            static constexpr size_t capacity = (detail::json_node_size<Policy>::value - 2*sizeof(uint8_t))/sizeof(char_type);
+            // Beyond 16 bytes, the length no longer fits in small_string_length_, and the last element
+            // holds max_length - length instead, which is the null terminator when the string is full 
+            static constexpr bool length_in_last_element = detail::json_node_size<Policy>::value > 16;
             char_type data_[capacity];
         public:
             static constexpr size_t max_length = capacity - 1;
 
             short_string_storage(semantic_tag tag, const char_type* p, uint8_t length)
-                : storage_kind_(static_cast<uint8_t>(json_storage_kind::short_string_value)), small_string_length_(length), tag_(tag)
+                : storage_kind_(static_cast<uint8_t>(json_storage_kind::short_string_value)), 
+                  small_string_length_(length_in_last_element ? 0 : length), tag_(tag)
             {
                 JSONCONS_ASSERT(length <= max_length);
                 std::memcpy(data_,p,length*sizeof(char_type));
                 data_[length] = 0;
+                if (length_in_last_element)
+                {
+                    data_[max_length] = static_cast<char_type>(max_length - length);
+                }
             }
 
             short_string_storage(const short_string_storage& other)
                 : storage_kind_(other.storage_kind_), small_string_length_(other.small_string_length_), tag_(other.tag_)
             {
-                std::memcpy(data_,other.data_,other.small_string_length_*sizeof(char_type));
-                data_[small_string_length_] = 0;
+                std::memcpy(data_,other.data_,other.length()*sizeof(char_type));
+                data_[other.length()] = 0;
+                if (length_in_last_element)
+                {
+                    data_[max_length] = other.data_[max_length];
+                }
             }
            
             short_string_storage& operator=(const short_string_storage& other) = delete;
 
             uint8_t length() const
             {
-                return small_string_length_;
+                return length_in_last_element ? static_cast<uint8_t>(max_length - static_cast<std::size_t>(data_[max_length])) 
+                                              : small_string_length_;
             }
 
             const char_type* data() const
@@ -899,32 +1005,114 @@ namespace jsoncons {
             uint8_t small_string_length_:4;
             semantic_tag tag_;
         private:
-            using array_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<array>;
-            using pointer = typename std::allocator_traits<array_allocator>::pointer;
+            // With a copy on write policy, the array is held in a reference counted node 
+            // that copies share until one of them is modified
+            using node_type = typename std::conditional<detail::json_copy_on_write<Policy>::value,detail::shared_node<array>,array>::type;
+            using node_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type>;
+            using pointer = typename std::allocator_traits<node_allocator>::pointer;
+            using copy_on_write = std::integral_constant<bool,detail::json_copy_on_write<Policy>::value>;
 
             pointer ptr_;
 
             template <typename... Args>
-            void create(array_allocator alloc, Args&& ... args)
+            void create(node_allocator alloc, Args&& ... args)
             {
-                ptr_ = std::allocator_traits<array_allocator>::allocate(alloc, 1);
+                pointer ptr = std::allocator_traits<node_allocator>::allocate(alloc, 1);
                 JSONCONS_TRY
                 {
-                    std::allocator_traits<array_allocator>::construct(alloc, extension_traits::to_plain_pointer(ptr_), 
+                    std::allocator_traits<node_allocator>::construct(alloc, extension_traits::to_plain_pointer(ptr), 
                         std::forward<Args>(args)...);
                 }
                 JSONCONS_CATCH(...)
                 {
-                    std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr,1);
                     JSONCONS_RETHROW;
                 }
+                ptr_ = ptr;
+            }
+
+            void copy(std::false_type, const array_storage& other, const Allocator& alloc)
+            {
+                create(node_allocator(alloc), other.value());
+            }
+
+            void copy(std::true_type, const array_storage& other, const Allocator& alloc)
+            {
+                if (other.get_allocator() == alloc)
+                {
+                    ptr_ = other.ptr_;
+                    ptr_->refs.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    create(node_allocator(alloc), other.value());
+                }
+            }
+
+            static void release(std::false_type, pointer ptr) noexcept
+            {
+                node_allocator alloc(ptr->get_allocator());
+                std::allocator_traits<node_allocator>::destroy(alloc, extension_traits::to_plain_pointer(ptr));
+                std::allocator_traits<node_allocator>::deallocate(alloc, ptr,1);
+            }
+
+            static void release(std::true_type, pointer ptr) noexcept
+            {
+                if (ptr->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    node_allocator alloc(ptr->value.get_allocator());
+                    std::allocator_traits<node_allocator>::destroy(alloc, extension_traits::to_plain_pointer(ptr));
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr,1);
+                }
             }
 
             void destroy() noexcept
             {
-                array_allocator alloc(ptr_->get_allocator());
-                std::allocator_traits<array_allocator>::destroy(alloc, extension_traits::to_plain_pointer(ptr_));
-                std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
+                release(copy_on_write(), ptr_);
+            }
+
+            void unshare(std::false_type)
+            {
+            }
+
+            void unshare(std::true_type)
+            {
+                if (ptr_->refs.load(std::memory_order_acquire) > 1)
+                {
+                    pointer ptr = ptr_;
+                    create(node_allocator(ptr->value.get_allocator()), ptr->value);
+                    release(copy_on_write(), ptr);
+                }
+            }
+
+            bool is_shared(std::false_type) const noexcept
+            {
+                return false;
+            }
+
+            bool is_shared(std::true_type) const noexcept
+            {
+                return ptr_->refs.load(std::memory_order_acquire) > 1;
+            }
+
+            static array& node_value(array& node) noexcept
+            {
+                return node;
+            }
+
+            static const array& node_value(const array& node) noexcept
+            {
+                return node;
+            }
+
+            static array& node_value(detail::shared_node<array>& node) noexcept
+            {
+                return node.value;
+            }
+
+            static const array& node_value(const detail::shared_node<array>& node) noexcept
+            {
+                return node.value;
             }
         public:
             array_storage(const array& val, semantic_tag tag)
@@ -942,7 +1130,7 @@ namespace jsoncons {
             array_storage(const array_storage& other)
                 : storage_kind_(other.storage_kind_), small_string_length_(0), tag_(other.tag_)
             {
-                create(other.ptr_->get_allocator(), *(other.ptr_));
+                copy(copy_on_write(), other, other.get_allocator());
             }
 
             array_storage(semantic_tag tag, pointer ptr)
@@ -965,7 +1153,7 @@ namespace jsoncons {
             array_storage(const array_storage& other, const Allocator& alloc)
                 : storage_kind_(other.storage_kind_), small_string_length_(0), tag_(other.tag_)
             {
-                create(array_allocator(alloc), *(other.ptr_));
+                copy(copy_on_write(), other, alloc);
             }
 
             array_storage(array_storage&& other, const Allocator& alloc)
@@ -982,7 +1170,7 @@ namespace jsoncons {
                 }
                 else
                 {
-                    create(array_allocator(alloc), *(other.ptr_));
+                    create(node_allocator(alloc), node_value(*(other.ptr_)));
                 }
             }
 
@@ -1001,17 +1189,18 @@ namespace jsoncons {
 
             void assign(std::true_type, const array_storage& other)
             {
-                tag_ = other.tag_;
-                destroy();
-                create(array_allocator(other.get_allocator()), *(other.ptr_));
+                pointer ptr = ptr_;
+                copy(copy_on_write(), other, other.get_allocator());
+                tag_ = other.tag_; // before release, other may live in the released node
+                release(copy_on_write(), ptr);
             }
 
             void assign(std::false_type, const array_storage& other)
             {
-                auto alloc = get_allocator();
-                tag_ = other.tag_;
-                destroy();
-                create(array_allocator(alloc), *(other.ptr_));
+                pointer ptr = ptr_;
+                copy(copy_on_write(), other, get_allocator());
+                tag_ = other.tag_; // before release, other may live in the released node
+                release(copy_on_write(), ptr);
             }
 
             void assign(array_storage&& other)
@@ -1025,6 +1214,18 @@ namespace jsoncons {
                 std::swap(tag_, other.tag_);
             }
 
+            // True if this and other hold the same array
+            bool shares(const array_storage& other) const noexcept
+            {
+                return ptr_ == other.ptr_;
+            }
+
+            // True if the array is also held by another basic_json
+            bool is_shared() const noexcept
+            {
+                return is_shared(copy_on_write());
+            }
+
             semantic_tag tag() const
             {
                 return tag_;
@@ -1032,17 +1233,18 @@ namespace jsoncons {
 
             allocator_type get_allocator() const
             {
-                return ptr_->get_allocator();
+                return node_value(*ptr_).get_allocator();
             }
 
             array& value()
             {
-                return *ptr_;
+                unshare(copy_on_write());
+                return node_value(*ptr_);
             }
 
             const array& value() const
             {
-                return *ptr_;
+                return node_value(*ptr_);
             }
         };
 
@@ -1054,24 +1256,108 @@ namespace jsoncons {
             uint8_t small_string_length_:4;
             semantic_tag tag_;
         private:
-            using object_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<object>;
-            using pointer = typename std::allocator_traits<object_allocator>::pointer;
+            // With a copy on write policy, the object is held in a reference counted node 
+            // that copies share until one of them is modified
+            using node_type = typename std::conditional<detail::json_copy_on_write<Policy>::value,detail::shared_node<object>,object>::type;
+            using node_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type>;
+            using pointer = typename std::allocator_traits<node_allocator>::pointer;
+            using copy_on_write = std::integral_constant<bool,detail::json_copy_on_write<Policy>::value>;
 
             pointer ptr_;
 
             template <typename... Args>
-            void create(object_allocator alloc, Args&& ... args)
+            void create(node_allocator alloc, Args&& ... args)
             {
-                ptr_ = std::allocator_traits<object_allocator>::allocate(alloc, 1);
+                pointer ptr = std::allocator_traits<node_allocator>::allocate(alloc, 1);
                 JSONCONS_TRY
                 {
-                    std::allocator_traits<object_allocator>::construct(alloc, extension_traits::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                    std::allocator_traits<node_allocator>::construct(alloc, extension_traits::to_plain_pointer(ptr), std::forward<Args>(args)...);
                 }
                 JSONCONS_CATCH(...)
                 {
-                    std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr,1);
                     JSONCONS_RETHROW;
                 }
+                ptr_ = ptr;
+            }
+
+            void copy(std::false_type, const object_storage& other, const Allocator& alloc)
+            {
+                create(node_allocator(alloc), other.value());
+            }
+
+            void copy(std::true_type, const object_storage& other, const Allocator& alloc)
+            {
+                if (other.get_allocator() == alloc)
+                {
+                    ptr_ = other.ptr_;
+                    ptr_->refs.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    create(node_allocator(alloc), other.value());
+                }
+            }
+
+            static void release(std::false_type, pointer ptr) noexcept
+            {
+                node_allocator alloc(ptr->get_allocator());
+                std::allocator_traits<node_allocator>::destroy(alloc, extension_traits::to_plain_pointer(ptr));
+                std::allocator_traits<node_allocator>::deallocate(alloc, ptr,1);
+            }
+
+            static void release(std::true_type, pointer ptr) noexcept
+            {
+                if (ptr->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    node_allocator alloc(ptr->value.get_allocator());
+                    std::allocator_traits<node_allocator>::destroy(alloc, extension_traits::to_plain_pointer(ptr));
+                    std::allocator_traits<node_allocator>::deallocate(alloc, ptr,1);
+                }
+            }
+
+            void unshare(std::false_type)
+            {
+            }
+
+            void unshare(std::true_type)
+            {
+                if (ptr_->refs.load(std::memory_order_acquire) > 1)
+                {
+                    pointer ptr = ptr_;
+                    create(node_allocator(ptr->value.get_allocator()), ptr->value);
+                    release(copy_on_write(), ptr);
+                }
+            }
+
+            bool is_shared(std::false_type) const noexcept
+            {
+                return false;
+            }
+
+            bool is_shared(std::true_type) const noexcept
+            {
+                return ptr_->refs.load(std::memory_order_acquire) > 1;
+            }
+
+            static object& node_value(object& node) noexcept
+            {
+                return node;
+            }
+
+            static const object& node_value(const object& node) noexcept
+            {
+                return node;
+            }
+
+            static object& node_value(detail::shared_node<object>& node) noexcept
+            {
+                return node.value;
+            }
+
+            static const object& node_value(const detail::shared_node<object>& node) noexcept
+            {
+                return node.value;
             }
         public:
             object_storage(const object& val, semantic_tag tag)
@@ -1095,13 +1381,13 @@ namespace jsoncons {
             explicit object_storage(const object_storage& other)
                 : storage_kind_(other.storage_kind_), small_string_length_(0), tag_(other.tag_), ptr_(nullptr)
             {
-                create(other.ptr_->get_allocator(), *(other.ptr_));
+                copy(copy_on_write(), other, other.get_allocator());
             }
 
             object_storage(const object_storage& other, const Allocator& alloc)
                 : storage_kind_(other.storage_kind_), small_string_length_(0), tag_(other.tag_), ptr_(nullptr)
             {
-                create(object_allocator(alloc), *(other.ptr_));
+                copy(copy_on_write(), other, alloc);
             }
 
             explicit object_storage(object_storage&& other) noexcept
@@ -1128,7 +1414,7 @@ namespace jsoncons {
                 }
                 else
                 {
-                    create(object_allocator(alloc), *(other.ptr_));
+                    create(node_allocator(alloc), node_value(*(other.ptr_)));
                 }
             }
 
@@ -1147,19 +1433,18 @@ namespace jsoncons {
 
             void assign(std::true_type, const object_storage& other)
             {
-                tag_ = other.tag_;
-                destroy();
-                ptr_ = nullptr;
-                create(object_allocator(other.get_allocator()), *(other.ptr_));
+                pointer ptr = ptr_;
+                copy(copy_on_write(), other, other.get_allocator());
+                tag_ = other.tag_; // before release, other may live in the released node
+                release(copy_on_write(), ptr);
             }
 
             void assign(std::false_type, const object_storage& other)
             {
-                auto alloc = get_allocator();
-                tag_ = other.tag_;
-                destroy();
-                ptr_ = nullptr;
-                create(object_allocator(alloc), *(other.ptr_));
+                pointer ptr = ptr_;
+                copy(copy_on_write(), other, get_allocator());
+                tag_ = other.tag_; // before release, other may live in the released node
+                release(copy_on_write(), ptr);
             }
 
             void assign(object_storage&& other)
@@ -1173,6 +1458,18 @@ namespace jsoncons {
                 std::swap(tag_, other.tag_);
             }
 
+            // True if this and other hold the same object
+            bool shares(const object_storage& other) const noexcept
+            {
+                return ptr_ == other.ptr_;
+            }
+
+            // True if the object is also held by another basic_json
+            bool is_shared() const noexcept
+            {
+                return is_shared(copy_on_write());
+            }
+
             semantic_tag tag() const
             {
                 return tag_;
@@ -1181,27 +1478,26 @@ namespace jsoncons {
             object& value()
             {
                 JSONCONS_ASSERT(ptr_ != nullptr);
-                return *ptr_;
+                unshare(copy_on_write());
+                return node_value(*ptr_);
             }
 
             const object& value() const
             {
                 JSONCONS_ASSERT(ptr_ != nullptr);
-                return *ptr_;
+                return node_value(*ptr_);
             }
 
             allocator_type get_allocator() const
             {
                 JSONCONS_ASSERT(ptr_ != nullptr);
-                return ptr_->get_allocator();
+                return node_value(*ptr_).get_allocator();
             }
         private:
 
             void destroy() noexcept
             {
-                object_allocator alloc(ptr_->get_allocator());
-                std::allocator_traits<object_allocator>::destroy(alloc, extension_traits::to_plain_pointer(ptr_));
-                std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
+                release(copy_on_write(), ptr_);
             }
         };
     private:
@@ -2626,6 +2922,24 @@ namespace jsoncons {
             uninitialized_copy(other);
         }
 
+        // other may be an element or member of this array or object, so it is copied before
+        // the array or object is destroyed
+        template <class TypeR>
+        void copy_assignment_l_r(identity<array_storage>,identity<TypeR>,const basic_json& other)
+        {
+            basic_json temp(other);
+            destroy();
+            uninitialized_move(std::move(temp));
+        }
+
+        template <class TypeR>
+        void copy_assignment_l_r(identity<object_storage>,identity<TypeR>,const basic_json& other)
+        {
+            basic_json temp(other);
+            destroy();
+            uninitialized_move(std::move(temp));
+        }
+
         void copy_assignment_l_r(identity<long_string_storage>,identity<long_string_storage>,const basic_json& other)
         {
             cast<long_string_storage>().assign(other.cast<long_string_storage>());
@@ -3109,9 +3423,23 @@ namespace jsoncons {
                                 }
                             }
                             
-                            // compare big numbers as double
-                            auto r = as<double>() - rhs.as<double>();
-                            return r == 0 ? 0 : (r < 0.0 ? -1 : 1);
+                            // compare big numbers as double, or as text if either is not a number
+                            double x, y;
+                            if (text_to_double(x) && rhs.number_to_double(y))
+                            {
+                                auto r = x - y;
+                                return r == 0 ? 0 : (r < 0.0 ? -1 : 1);
+                            }
+                            switch (rhs.storage_kind())
+                            {
+                                case json_storage_kind::short_string_value:
+                                case json_storage_kind::long_string_value:
+                                    return as_string_view().compare(rhs.as_string_view());
+                                case json_storage_kind::json_const_pointer:
+                                    return compare(*(rhs.cast<json_const_pointer_storage>().value()));
+                                default:
+                                    return static_cast<int>(storage_kind()) - static_cast<int>((int)rhs.storage_kind());
+                            }
                         }
                         default:
                         {
@@ -3119,8 +3447,11 @@ namespace jsoncons {
                             switch (rhs.storage_kind())
                             {
                                 case json_storage_kind::short_string_value:
-                                    return as_string_view().compare(rhs.as_string_view());
                                 case json_storage_kind::long_string_value:
+                                    if (rhs.tag() == semantic_tag::bigint || rhs.tag() == semantic_tag::bigdec || rhs.tag() == semantic_tag::bigfloat)
+                                    {
+                                        return -rhs.compare(*this);
+                                    }
                                     return as_string_view().compare(rhs.as_string_view());
                                 case json_storage_kind::json_const_pointer:
                                     return compare(*(rhs.cast<json_const_pointer_storage>().value()));
@@ -3148,10 +3479,10 @@ namespace jsoncons {
                     {
                         case json_storage_kind::array_value:
                         {
-                            if (cast<array_storage>().value() == rhs.cast<array_storage>().value())
+                            // Shared storage is equal without comparing elements, even if they contain NaN
+                            if (cast<array_storage>().shares(rhs.cast<array_storage>()))
                                 return 0; 
-                            else 
-                                return cast<array_storage>().value() < rhs.cast<array_storage>().value() ? -1 : 1;
+                            return compare_elements(cast<array_storage>().value(), rhs.cast<array_storage>().value());
                         }
                         case json_storage_kind::json_const_pointer:
                             return compare(*(rhs.cast<json_const_pointer_storage>().value()));
@@ -3166,10 +3497,10 @@ namespace jsoncons {
                             return empty() ? 0 : 1;
                         case json_storage_kind::object_value:
                         {
-                            if (cast<object_storage>().value() == rhs.cast<object_storage>().value())
+                            // Shared storage is equal without comparing members, even if they contain NaN
+                            if (cast<object_storage>().shares(rhs.cast<object_storage>()))
                                 return 0; 
-                            else 
-                                return cast<object_storage>().value() < rhs.cast<object_storage>().value() ? -1 : 1;
+                            return compare_members(cast<object_storage>().value(), rhs.cast<object_storage>().value());
                         }
                         case json_storage_kind::json_const_pointer:
                             return compare(*(rhs.cast<json_const_pointer_storage>().value()));
@@ -3183,6 +3514,13 @@ namespace jsoncons {
             }
         }
 
+        // A structural hash, consistent with compare: values that compare equal have equal hashes.
+        // Numbers, including big numbers, are hashed by their double value, and tags are ignored. 
+        std::size_t hash() const noexcept
+        {
+            return static_cast<std::size_t>(hash_value());
+        }
+
         void swap(basic_json& other) noexcept
         {
             if (this == &other)
@@ -3218,7 +3556,7 @@ namespace jsoncons {
             parse(const Source& source, 
               const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
         {
-            json_decoder<basic_json> decoder;
+            json_decoder<basic_json> decoder(options.duplicate_keys());
             basic_json_parser<char_type> parser(options);
 
             auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
@@ -3244,7 +3582,7 @@ namespace jsoncons {
             parse(const allocator_set<allocator_type,TempAllocator>& alloc_set, const Source& source, 
               const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
         {
-            json_decoder<basic_json> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+            json_decoder<basic_json> decoder(options.duplicate_keys(), alloc_set.get_allocator(), alloc_set.get_temp_allocator());
             basic_json_parser<char_type,TempAllocator> parser(options, alloc_set.get_temp_allocator());
 
             auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
@@ -3264,6 +3602,40 @@ namespace jsoncons {
             return decoder.get_result();
         }
 
+        // with a parse context, reused between documents
+
+        template <class Source, class TempAllocator>
+        static
+        typename std::enable_if<extension_traits::is_sequence_of<Source,char_type>::value,basic_json>::type
+        parse(json_parse_context<basic_json,TempAllocator>& context, const Source& source)
+        {
+            context.reset();
+            auto& decoder = context.decoder();
+            auto& parser = context.parser();
+
+            auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
+            if (!(r.encoding == unicode_traits::encoding_kind::utf8 || r.encoding == unicode_traits::encoding_kind::undetected))
+            {
+                JSONCONS_THROW(ser_error(json_errc::illegal_unicode_character,parser.line(),parser.column()));
+            }
+            std::size_t offset = (r.ptr - source.data());
+            parser.update(source.data()+offset,source.size()-offset);
+            parser.parse_some(decoder);
+            parser.finish_parse(decoder);
+            parser.check_done();
+            if (!decoder.is_valid())
+            {
+                JSONCONS_THROW(ser_error(json_errc::source_error, "Failed to parse json string"));
+            }
+            return decoder.get_result();
+        }
+
+        template <class TempAllocator>
+        static basic_json parse(json_parse_context<basic_json,TempAllocator>& context, const char_type* source)
+        {
+            return parse(context, jsoncons::basic_string_view<char_type>(source));
+        }
+
         static basic_json parse(const char_type* source, 
             const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
         {
@@ -3295,7 +3667,7 @@ namespace jsoncons {
         static basic_json parse(std::basic_istream<char_type>& is, 
             const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>())
         {
-            json_decoder<basic_json> decoder;
+            json_decoder<basic_json> decoder(options.duplicate_keys());
             basic_json_reader<char_type,stream_source<char_type>,Allocator> reader(is, decoder, options);
             reader.read_next();
             reader.check_done();
@@ -3310,7 +3682,7 @@ namespace jsoncons {
         static basic_json parse(const allocator_set<allocator_type,TempAllocator>& alloc_set, std::basic_istream<char_type>& is, 
             const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>())
         {
-            json_decoder<basic_json> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+            json_decoder<basic_json> decoder(options.duplicate_keys(), alloc_set.get_allocator(), alloc_set.get_temp_allocator());
             basic_json_reader<char_type,stream_source<char_type>,Allocator> reader(is, decoder, options, alloc_set.get_temp_allocator());
             reader.read_next();
             reader.check_done();
@@ -3327,7 +3699,7 @@ namespace jsoncons {
         static basic_json parse(InputIt first, InputIt last, 
                                 const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>())
         {
-            json_decoder<basic_json> decoder;
+            json_decoder<basic_json> decoder(options.duplicate_keys());
             basic_json_reader<char_type,iterator_source<InputIt>,Allocator> reader(iterator_source<InputIt>(std::forward<InputIt>(first),
                 std::forward<InputIt>(last)), decoder, options);
             reader.read_next();
@@ -3343,7 +3715,7 @@ namespace jsoncons {
         static basic_json parse(const allocator_set<allocator_type,TempAllocator>& alloc_set, InputIt first, InputIt last, 
                                 const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>())
         {
-            json_decoder<basic_json> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+            json_decoder<basic_json> decoder(options.duplicate_keys(), alloc_set.get_allocator(), alloc_set.get_temp_allocator());
             basic_json_reader<char_type,iterator_source<InputIt>,Allocator> reader(iterator_source<InputIt>(std::forward<InputIt>(first),
                 std::forward<InputIt>(last)), 
                 decoder, options, alloc_set.get_temp_allocator());
@@ -3360,7 +3732,7 @@ namespace jsoncons {
             const basic_json_decode_options<char_type>& options, 
             std::function<bool(json_errc,const ser_context&)> err_handler)
         {
-            json_decoder<basic_json> decoder;
+            json_decoder<basic_json> decoder(options.duplicate_keys());
             basic_json_reader<char_type,stream_source<char_type>> reader(is, decoder, options, err_handler);
             reader.read_next();
             reader.check_done();
@@ -3381,7 +3753,7 @@ namespace jsoncons {
                                 const basic_json_decode_options<char_type>& options, 
                                 std::function<bool(json_errc,const ser_context&)> err_handler)
         {
-            json_decoder<basic_json> decoder;
+            json_decoder<basic_json> decoder(options.duplicate_keys());
             basic_json_reader<char_type,iterator_source<InputIt>> reader(iterator_source<InputIt>(std::forward<InputIt>(first),std::forward<InputIt>(last)), decoder, options, err_handler);
             reader.read_next();
             reader.check_done();
@@ -3399,7 +3771,7 @@ namespace jsoncons {
               const basic_json_decode_options<char_type>& options, 
               std::function<bool(json_errc,const ser_context&)> err_handler)
         {
-            json_decoder<basic_json> decoder;
+            json_decoder<basic_json> decoder(options.duplicate_keys());
             basic_json_parser<char_type> parser(options,err_handler);
 
             auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
@@ -3638,6 +4010,26 @@ namespace jsoncons {
         {
         }
 
+        // Moves the elements of an rvalue container rather than copying them
+
+        template <class T,
+                  class = typename std::enable_if<!std::is_lvalue_reference<T>::value && !std::is_const<T>::value && 
+                                                  !is_proxy_of<T,basic_json>::value && !extension_traits::is_basic_json<T>::value &&
+                                                  jsoncons::detail::is_movable_container_type<basic_json,T>::value>::type>
+        basic_json(T&& val)
+            : basic_json(json_type_traits<basic_json,T>::to_json(std::move(val)))
+        {
+        }
+
+        template <class T,
+                  class = typename std::enable_if<!std::is_lvalue_reference<T>::value && !std::is_const<T>::value && 
+                                                  !is_proxy_of<T,basic_json>::value && !extension_traits::is_basic_json<T>::value &&
+                                                  jsoncons::detail::is_movable_container_type<basic_json,T>::value>::type>
+        basic_json(T&& val, const Allocator& alloc)
+            : basic_json(json_type_traits<basic_json,T>::to_json(std::move(val),alloc))
+        {
+        }
+
         basic_json(const string_type& s)
             : basic_json(s.data(), s.size(), semantic_tag::none, s.get_allocator())
         {
@@ -3834,6 +4226,16 @@ namespace jsoncons {
             return *this;
         }
 
+        template <class T>
+        typename std::enable_if<!std::is_lvalue_reference<T>::value && !std::is_const<T>::value && 
+                                !is_proxy_of<T,basic_json>::value && !extension_traits::is_basic_json<T>::value &&
+                                jsoncons::detail::is_movable_container_type<basic_json,T>::value,basic_json&>::type
+        operator=(T&& val)
+        {
+            *this = json_type_traits<basic_json,T>::to_json(std::move(val));
+            return *this;
+        }
+
         basic_json& operator=(const char_type* s)
         {
             *this = basic_json(s, char_traits_type::length(s), semantic_tag::none);
@@ -4395,6 +4797,19 @@ namespace jsoncons {
             }
         }
 
+        bool is_shared() const noexcept
+        {
+            switch (storage_kind())
+            {
+                case json_storage_kind::array_value:
+                    return cast<array_storage>().is_shared();
+                case json_storage_kind::object_value:
+                    return cast<object_storage>().is_shared();
+                default:
+                    return false;
+            }
+        }
+
         std::size_t capacity() const
         {
             switch (storage_kind())
@@ -4479,12 +4894,23 @@ namespace jsoncons {
 
         template<class T>
         typename std::enable_if<is_json_type_traits_specialized<basic_json,T>::value,T>::type
-        as() const
+        as() const &
         {
             T val = json_type_traits<basic_json,T>::as(*this);
             return val;
         }
 
+        // Moves the elements, members and nested arrays and objects of this value into the result 
+        // where json_type_traits provides an rvalue conversion
+
+        template<class T>
+        typename std::enable_if<is_json_type_traits_specialized<basic_json,T>::value,T>::type
+        as() &&
+        {
+            T val = json_type_traits<basic_json,T>::as(std::move(*this));
+            return val;
+        }
+
         template<class T>
         typename std::enable_if<(!extension_traits::is_string<T>::value && 
                                  extension_traits::is_back_insertable_byte_container<T>::value) ||
@@ -6055,6 +6481,245 @@ namespace jsoncons {
 
     private:
 
+        // Compares elements in order, stopping at the first that differs
+        static int compare_elements(const array& lhs, const array& rhs) noexcept
+        {
+            auto it1 = lhs.begin();
+            auto it2 = rhs.begin();
+            for (; it1 != lhs.end() && it2 != rhs.end(); ++it1, ++it2)
+            {
+                int diff = (*it1).compare(*it2);
+                if (diff != 0)
+                {
+                    return diff;
+                }
+            }
+            return it1 != lhs.end() ? 1 : (it2 != rhs.end() ? -1 : 0);
+        }
+
+        static int compare_members(const object& lhs, const object& rhs) noexcept
+        {
+            auto it1 = lhs.begin();
+            auto it2 = rhs.begin();
+            for (; it1 != lhs.end() && it2 != rhs.end(); ++it1, ++it2)
+            {
+                if (!((*it1).key() == (*it2).key()))
+                {
+                    return (*it1).key() < (*it2).key() ? -1 : 1;
+                }
+                int diff = (*it1).value().compare((*it2).value());
+                if (diff != 0)
+                {
+                    return diff;
+                }
+            }
+            return it1 != lhs.end() ? 1 : (it2 != rhs.end() ? -1 : 0);
+        }
+
+        static uint64_t hash_mix(uint64_t h) noexcept
+        {
+            h ^= h >> 30;
+            h *= 0xbf58476d1ce4e5b9ull;
+            h ^= h >> 27;
+            h *= 0x94d049bb133111ebull;
+            h ^= h >> 31;
+            return h;
+        }
+
+        template <class T>
+        static uint64_t hash_chars(const T* s, std::size_t length) noexcept
+        {
+            // FNV-1a
+            uint64_t h = 14695981039346656037ull;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                h ^= static_cast<uint64_t>(static_cast<typename std::make_unsigned<T>::type>(s[i]));
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        static uint64_t hash_number(double val) noexcept
+        {
+            if (val == 0.0)
+            {
+                val = 0.0; // -0.0 == 0.0
+            }
+            uint64_t bits;
+            std::memcpy(&bits, &val, sizeof(bits));
+            return hash_mix(bits);
+        }
+
+        // Checks that text is a decimal or hexadecimal floating point number, with nothing before or after
+        static bool is_number_text(const char_type* s, std::size_t length) noexcept
+        {
+            const char_type* p = s;
+            const char_type* end = s + length;
+            if (p != end && (*p == '-' || *p == '+'))
+            {
+                ++p;
+            }
+            bool hex = end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X');
+            if (hex)
+            {
+                p += 2;
+            }
+            auto is_digit = [hex](char_type c) -> bool
+            {
+                return (c >= '0' && c <= '9') || (hex && ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')));
+            };
+            std::size_t digits = 0;
+            for (; p != end && is_digit(*p); ++p, ++digits)
+            {
+            }
+            if (p != end && *p == '.')
+            {
+                for (++p; p != end && is_digit(*p); ++p, ++digits)
+                {
+                }
+            }
+            if (digits == 0)
+            {
+                return false;
+            }
+            if (p != end && (hex ? (*p == 'p' || *p == 'P') : (*p == 'e' || *p == 'E')))
+            {
+                ++p;
+                if (p != end && (*p == '-' || *p == '+'))
+                {
+                    ++p;
+                }
+                const char_type* exponent = p;
+                for (; p != end && *p >= '0' && *p <= '9'; ++p)
+                {
+                }
+                if (p == exponent)
+                {
+                    return false;
+                }
+            }
+            return p == end;
+        }
+
+        // Converts a string that is the text of a number, without throwing
+        bool text_to_double(double& val) const noexcept
+        {
+            auto sv = as_string_view();
+            if (!is_number_text(sv.data(), sv.size()))
+            {
+                return false;
+            }
+            bool converted = false;
+            JSONCONS_TRY
+            {
+                jsoncons::detail::chars_to to_double;
+                val = to_double(as_cstring(), sv.size());
+                converted = true;
+            }
+            JSONCONS_CATCH(...)
+            {
+                converted = false;
+            }
+            return converted;
+        }
+
+        bool number_to_double(double& val) const noexcept
+        {
+            switch (storage_kind())
+            {
+                case json_storage_kind::int64_value:
+                    val = static_cast<double>(cast<int64_storage>().value());
+                    return true;
+                case json_storage_kind::uint64_value:
+                    val = static_cast<double>(cast<uint64_storage>().value());
+                    return true;
+                case json_storage_kind::half_value:
+                    val = binary::decode_half(cast<half_storage>().value());
+                    return true;
+                case json_storage_kind::double_value:
+                    val = cast<double_storage>().value();
+                    return true;
+                case json_storage_kind::short_string_value:
+                case json_storage_kind::long_string_value:
+                    return text_to_double(val);
+                case json_storage_kind::json_const_pointer:
+                    return cast<json_const_pointer_storage>().value()->number_to_double(val);
+                default:
+                    return false;
+            }
+        }
+
+        uint64_t hash_value() const noexcept
+        {
+            // Distinguishes the kinds of value that never compare equal
+            const uint64_t null_seed = 0x6a09e667f3bcc908ull;
+            const uint64_t bool_seed = 0xbb67ae8584caa73bull;
+            const uint64_t bytes_seed = 0x3c6ef372fe94f82bull;
+            const uint64_t array_seed = 0xa54ff53a5f1d36f1ull;
+            const uint64_t object_seed = 0x510e527fade682d1ull;
+
+            switch (storage_kind())
+            {
+                case json_storage_kind::null_value:
+                    return null_seed;
+                case json_storage_kind::bool_value:
+                    return hash_mix(bool_seed + (cast<bool_storage>().value() ? 1 : 0));
+                case json_storage_kind::int64_value:
+                    return hash_number(static_cast<double>(cast<int64_storage>().value()));
+                case json_storage_kind::uint64_value:
+                    return hash_number(static_cast<double>(cast<uint64_storage>().value()));
+                case json_storage_kind::half_value:
+                    return hash_number(binary::decode_half(cast<half_storage>().value()));
+                case json_storage_kind::double_value:
+                    return hash_number(cast<double_storage>().value());
+                case json_storage_kind::short_string_value:
+                case json_storage_kind::long_string_value:
+                {
+                    // A big number equals a string with the same text, and a number with the same 
+                    // value, so any string that is the text of a number hashes as that number
+                    double val;
+                    if (text_to_double(val))
+                    {
+                        return hash_number(val);
+                    }
+                    auto sv = as_string_view();
+                    return hash_mix(hash_chars(sv.data(), sv.size()));
+                }
+                case json_storage_kind::byte_string_value:
+                {
+                    auto bytes = as_byte_string_view();
+                    return hash_mix(bytes_seed ^ hash_chars(bytes.data(), bytes.size()));
+                }
+                case json_storage_kind::array_value:
+                {
+                    uint64_t h = array_seed;
+                    for (const auto& item : cast<array_storage>().value())
+                    {
+                        h = hash_mix(h ^ item.hash_value());
+                    }
+                    return h;
+                }
+                case json_storage_kind::empty_object_value:
+                    return object_seed;
+                case json_storage_kind::object_value:
+                {
+                    // Members are combined in any order, so that the hash does not depend on 
+                    // whether the object sorts its members
+                    uint64_t h = object_seed;
+                    for (const auto& member : cast<object_storage>().value())
+                    {
+                        h += hash_mix(hash_chars(member.key().data(), member.key().size()) ^ member.value().hash_value());
+                    }
+                    return h;
+                }
+                case json_storage_kind::json_const_pointer:
+                    return cast<json_const_pointer_storage>().value()->hash_value();
+                default:
+                    JSONCONS_UNREACHABLE();
+                    break;
+            }
+        }
+
         void dump_noflush(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
         {
             const ser_context context{};
@@ -6471,4 +7136,17 @@ namespace jsoncons {
 
 } // namespace jsoncons
 
+namespace std {
+
+    template <class CharT,class Policy,class Allocator>
+    struct hash<jsoncons::basic_json<CharT,Policy,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_json<CharT,Policy,Allocator>& val) const noexcept
+        {
+            return val.hash();
+        }
+    };
+
+} // namespace std
+
 #endif
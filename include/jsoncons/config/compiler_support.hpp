@@ -338,6 +338,20 @@ namespace jsoncons {
 }
 #endif
     
+// SSE2 is part of the x86-64 baseline, so it can be used without runtime dispatch
+#if !defined(JSONCONS_HAS_SSE2) && !defined(JSONCONS_NO_SSE2)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSONCONS_HAS_SSE2
+#endif
+#endif
+
+// POSIX file descriptors and writev
+#if !defined(JSONCONS_HAS_POSIX_IO) && !defined(JSONCONS_NO_POSIX_IO)
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#define JSONCONS_HAS_POSIX_IO
+#endif
+#endif
+
 #if defined(_MSC_VER) && _MSC_VER <= 1900
     #define JSONCONS_COPY(first,last,d_first) std::copy(first, last, stdext::make_checked_array_iterator(d_first, static_cast<std::size_t>(std::distance(first, last))))
 #else 
@@ -28,7 +28,7 @@ namespace jsoncons {
     {
         using char_type = typename Source::value_type;
 
-        jsoncons::json_decoder<T> decoder;
+        jsoncons::json_decoder<T> decoder(options.duplicate_keys());
         basic_json_reader<char_type, string_source<char_type>> reader(s, decoder, options);
         reader.read();
         if (!decoder.is_valid())
@@ -62,7 +62,7 @@ namespace jsoncons {
     decode_json(std::basic_istream<CharT>& is,
                 const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
     {
-        jsoncons::json_decoder<T> decoder;
+        jsoncons::json_decoder<T> decoder(options.duplicate_keys());
         basic_json_reader<CharT, stream_source<CharT>> reader(is, decoder, options);
         reader.read();
         if (!decoder.is_valid())
@@ -97,7 +97,7 @@ namespace jsoncons {
     {
         using char_type = typename std::iterator_traits<InputIt>::value_type;
 
-        jsoncons::json_decoder<T> decoder;
+        jsoncons::json_decoder<T> decoder(options.duplicate_keys());
         basic_json_reader<char_type, iterator_source<InputIt>> reader(iterator_source<InputIt>(first,last), decoder, options);
         reader.read();
         if (!decoder.is_valid())
@@ -137,7 +137,7 @@ namespace jsoncons {
     {
         using char_type = typename Source::value_type;
 
-        json_decoder<T,TempAllocator> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+        json_decoder<T,TempAllocator> decoder(options.duplicate_keys(), alloc_set.get_allocator(), alloc_set.get_temp_allocator());
 
         basic_json_reader<char_type, string_source<char_type>,TempAllocator> reader(s, decoder, options, alloc_set.get_temp_allocator());
         reader.read();
@@ -175,7 +175,7 @@ namespace jsoncons {
                 std::basic_istream<CharT>& is,
                 const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
     {
-        json_decoder<T,TempAllocator> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+        json_decoder<T,TempAllocator> decoder(options.duplicate_keys(), alloc_set.get_allocator(), alloc_set.get_temp_allocator());
 
         basic_json_reader<CharT, stream_source<CharT>,TempAllocator> reader(is, decoder, options, alloc_set.get_temp_allocator());
         reader.read();
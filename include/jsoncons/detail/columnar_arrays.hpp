@@ -0,0 +1,671 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_COLUMNAR_ARRAYS_HPP
+#define JSONCONS_DETAIL_COLUMNAR_ARRAYS_HPP
+
+#include <cstdint>
+#include <cmath> // std::isfinite, std::fabs
+#include <string>
+#include <vector>
+#include <memory> // std::allocator
+#include <limits> // std::numeric_limits
+#include <system_error>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/config/binary_config.hpp>
+#include <jsoncons/json_type.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/item_event_visitor.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // An array of at least two objects that have the same keys in the same order,
+    // and only untagged scalar values that are not half precision, can be written
+    // column by column as a block
+    //
+    //     [[key_1, ..., key_n], column_1, ..., column_n]
+    //
+    // where column_i is an array holding the values of key_i, row by row.
+    // Integer and floating point columns are written as typed arrays of the
+    // narrowest element type that holds every value exactly. The binary
+    // formats embed the block in a tagged byte string.
+
+    template <class Json>
+    bool is_columnar_array(const Json& j)
+    {
+        if (!j.is_array() || j.size() < 2 || j.tag() != semantic_tag::none)
+        {
+            return false;
+        }
+        const Json& first = j.at(0);
+        if (!first.is_object() || first.empty())
+        {
+            return false;
+        }
+        for (const auto& row : j.array_range())
+        {
+            if (!row.is_object() || row.size() != first.size() || row.tag() != semantic_tag::none)
+            {
+                return false;
+            }
+            auto it = first.object_range().begin();
+            for (const auto& member : row.object_range())
+            {
+                // Tags and half precision storage would not survive the round trip
+                const Json& val = member.value();
+                if (val.is_object() || val.is_array() || val.tag() != semantic_tag::none ||
+                    val.type() == json_type::half_value || member.key() != it->key())
+                {
+                    return false;
+                }
+                ++it;
+            }
+        }
+        return true;
+    }
+
+    template <class Json>
+    void dump_scalar(const Json& j, basic_json_visitor<typename Json::char_type>& visitor, std::error_code& ec)
+    {
+        const ser_context context{};
+        switch (j.type())
+        {
+            case json_type::bool_value:
+                visitor.bool_value(j.as_bool(), j.tag(), context, ec);
+                break;
+            case json_type::int64_value:
+                visitor.int64_value(j.template as_integer<int64_t>(), j.tag(), context, ec);
+                break;
+            case json_type::uint64_value:
+                visitor.uint64_value(j.template as_integer<uint64_t>(), j.tag(), context, ec);
+                break;
+            case json_type::half_value:
+                // half to double is exact, so encoding it again recovers the original bits
+                visitor.half_value(binary::encode_half(j.as_double()), j.tag(), context, ec);
+                break;
+            case json_type::double_value:
+                visitor.double_value(j.as_double(), j.tag(), context, ec);
+                break;
+            case json_type::string_value:
+                visitor.string_value(j.as_string_view(), j.tag(), context, ec);
+                break;
+            case json_type::byte_string_value:
+                if (j.tag() == semantic_tag::ext)
+                {
+                    visitor.byte_string_value(j.as_byte_string_view(), j.ext_tag(), context, ec);
+                }
+                else
+                {
+                    visitor.byte_string_value(j.as_byte_string_view(), j.tag(), context, ec);
+                }
+                break;
+            default:
+                visitor.null_value(j.tag(), context, ec);
+                break;
+        }
+    }
+
+    template <class Json>
+    class columnar_block_writer
+    {
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+
+        std::vector<const Json*> cells_;
+        std::vector<int64_t> int64_column_;
+        std::vector<uint64_t> uint64_column_;
+        std::vector<double> double_column_;
+        std::vector<float> float_column_;
+    public:
+        void write(const Json& j, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+        {
+            const ser_context context{};
+            const Json& first = j.at(0);
+            const std::size_t num_keys = first.size();
+            const std::size_t num_rows = j.size();
+
+            cells_.clear();
+            cells_.reserve(num_keys*num_rows);
+            for (const auto& row : j.array_range())
+            {
+                for (const auto& member : row.object_range())
+                {
+                    cells_.push_back(std::addressof(member.value()));
+                }
+            }
+
+            visitor.begin_array(num_keys+1, semantic_tag::none, context, ec);
+            visitor.begin_array(num_keys, semantic_tag::none, context, ec);
+            for (const auto& member : first.object_range())
+            {
+                visitor.string_value(string_view_type(member.key().data(), member.key().size()), semantic_tag::none, context, ec);
+            }
+            visitor.end_array(context, ec);
+            for (std::size_t i = 0; i < num_keys && !ec; ++i)
+            {
+                write_column(i, num_keys, num_rows, visitor, ec);
+            }
+            visitor.end_array(context, ec);
+        }
+    private:
+        void write_column(std::size_t col, std::size_t num_keys, std::size_t num_rows,
+                          basic_json_visitor<char_type>& visitor, std::error_code& ec)
+        {
+            const ser_context context{};
+
+            bool is_integer = true;
+            bool is_double = true;
+            bool is_negative = false;
+            for (std::size_t row = 0; row < num_rows && (is_integer || is_double); ++row)
+            {
+                const Json& val = *cells_[row*num_keys + col];
+                switch (val.type())
+                {
+                    case json_type::int64_value:
+                        is_double = false;
+                        if (val.template as_integer<int64_t>() < 0)
+                        {
+                            is_negative = true;
+                        }
+                        break;
+                    case json_type::uint64_value:
+                        is_double = false;
+                        break;
+                    case json_type::double_value:
+                        is_integer = false;
+                        break;
+                    default:
+                        is_integer = is_double = false;
+                        break;
+                }
+            }
+
+            if (is_integer && is_negative)
+            {
+                int64_column_.clear();
+                for (std::size_t row = 0; row < num_rows; ++row)
+                {
+                    const Json& val = *cells_[row*num_keys + col];
+                    if (val.type() == json_type::uint64_value &&
+                        val.template as_integer<uint64_t>() > static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+                    {
+                        is_integer = false;
+                        break;
+                    }
+                    int64_column_.push_back(val.template as_integer<int64_t>());
+                }
+                if (is_integer)
+                {
+                    write_int64_column(visitor, ec);
+                    return;
+                }
+            }
+            else if (is_integer)
+            {
+                uint64_column_.clear();
+                for (std::size_t row = 0; row < num_rows; ++row)
+                {
+                    uint64_column_.push_back(cells_[row*num_keys + col]->template as_integer<uint64_t>());
+                }
+                write_uint64_column(visitor, ec);
+                return;
+            }
+            else if (is_double)
+            {
+                double_column_.clear();
+                bool fits_float = true;
+                for (std::size_t row = 0; row < num_rows; ++row)
+                {
+                    double d = cells_[row*num_keys + col]->as_double();
+                    if (fits_float && !(std::isfinite(d) && std::fabs(d) <= (std::numeric_limits<float>::max)() &&
+                                        static_cast<double>(static_cast<float>(d)) == d))
+                    {
+                        fits_float = false;
+                    }
+                    double_column_.push_back(d);
+                }
+                if (fits_float)
+                {
+                    float_column_.clear();
+                    for (double d : double_column_)
+                    {
+                        float_column_.push_back(static_cast<float>(d));
+                    }
+                    visitor.typed_array(jsoncons::span<const float>(float_column_), semantic_tag::none, context, ec);
+                }
+                else
+                {
+                    visitor.typed_array(jsoncons::span<const double>(double_column_), semantic_tag::none, context, ec);
+                }
+                return;
+            }
+
+            visitor.begin_array(num_rows, semantic_tag::none, context, ec);
+            for (std::size_t row = 0; row < num_rows && !ec; ++row)
+            {
+                dump_scalar(*cells_[row*num_keys + col], visitor, ec);
+            }
+            visitor.end_array(context, ec);
+        }
+
+        void write_uint64_column(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+        {
+            uint64_t max_value = 0;
+            for (auto val : uint64_column_)
+            {
+                if (val > max_value)
+                {
+                    max_value = val;
+                }
+            }
+            if (max_value <= (std::numeric_limits<uint8_t>::max)())
+            {
+                write_narrowed<uint8_t>(uint64_column_, visitor, ec);
+            }
+            else if (max_value <= (std::numeric_limits<uint16_t>::max)())
+            {
+                write_narrowed<uint16_t>(uint64_column_, visitor, ec);
+            }
+            else if (max_value <= (std::numeric_limits<uint32_t>::max)())
+            {
+                write_narrowed<uint32_t>(uint64_column_, visitor, ec);
+            }
+            else
+            {
+                visitor.typed_array(jsoncons::span<const uint64_t>(uint64_column_), semantic_tag::none, ser_context(), ec);
+            }
+        }
+
+        void write_int64_column(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+        {
+            int64_t min_value = 0;
+            int64_t max_value = 0;
+            for (auto val : int64_column_)
+            {
+                if (val < min_value)
+                {
+                    min_value = val;
+                }
+                if (val > max_value)
+                {
+                    max_value = val;
+                }
+            }
+            if (min_value >= (std::numeric_limits<int8_t>::lowest)() && max_value <= (std::numeric_limits<int8_t>::max)())
+            {
+                write_narrowed<int8_t>(int64_column_, visitor, ec);
+            }
+            else if (min_value >= (std::numeric_limits<int16_t>::lowest)() && max_value <= (std::numeric_limits<int16_t>::max)())
+            {
+                write_narrowed<int16_t>(int64_column_, visitor, ec);
+            }
+            else if (min_value >= (std::numeric_limits<int32_t>::lowest)() && max_value <= (std::numeric_limits<int32_t>::max)())
+            {
+                write_narrowed<int32_t>(int64_column_, visitor, ec);
+            }
+            else
+            {
+                visitor.typed_array(jsoncons::span<const int64_t>(int64_column_), semantic_tag::none, ser_context(), ec);
+            }
+        }
+
+        template <class T, class U>
+        static void write_narrowed(const std::vector<U>& values, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+        {
+            std::vector<T> narrowed;
+            narrowed.reserve(values.size());
+            for (auto val : values)
+            {
+                narrowed.push_back(static_cast<T>(val));
+            }
+            visitor.typed_array(jsoncons::span<const T>(narrowed), semantic_tag::none, ser_context(), ec);
+        }
+    };
+
+    // Writes j to visitor, passing arrays that can be written column by column to write_block
+
+    template <class Json, class WriteBlock>
+    void dump_columnar(const Json& j, basic_json_visitor<typename Json::char_type>& visitor,
+                       WriteBlock& write_block, std::error_code& ec)
+    {
+        using string_view_type = typename Json::string_view_type;
+        const ser_context context{};
+
+        switch (j.type())
+        {
+            case json_type::object_value:
+            {
+                visitor.begin_object(j.size(), j.tag(), context, ec);
+                for (const auto& member : j.object_range())
+                {
+                    visitor.key(string_view_type(member.key().data(), member.key().size()), context, ec);
+                    dump_columnar(member.value(), visitor, write_block, ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                }
+                visitor.end_object(context, ec);
+                break;
+            }
+            case json_type::array_value:
+            {
+                if (is_columnar_array(j))
+                {
+                    write_block(j, visitor, ec);
+                }
+                else
+                {
+                    visitor.begin_array(j.size(), j.tag(), context, ec);
+                    for (const auto& item : j.array_range())
+                    {
+                        dump_columnar(item, visitor, write_block, ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                    }
+                    visitor.end_array(context, ec);
+                }
+                break;
+            }
+            default:
+                dump_scalar(j, visitor, ec);
+                break;
+        }
+    }
+
+    // Collects a block written by columnar_block_writer from the events of a parser,
+    // and produces the events of the array of objects that it represents.
+
+    template <class Allocator=std::allocator<char>>
+    class columnar_block_reader : public basic_item_event_visitor<char>
+    {
+        using char_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<char>;
+        using string_type = std::basic_string<char,std::char_traits<char>,char_allocator_type>;
+        using string_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<string_type>;
+
+        enum class cell_kind : uint8_t {null_value,bool_value,int64_value,uint64_value,half_value,double_value,string_value,byte_string_value,ext_value};
+        enum class block_state : uint8_t {start,keys_begin,keys,column_begin,column,end,done,invalid};
+
+        struct cell
+        {
+            cell_kind kind;
+            semantic_tag tag;
+            union
+            {
+                bool bool_val;
+                int64_t int64_val;
+                uint64_t uint64_val;
+                uint16_t half_val;
+                double double_val;
+                std::size_t offset;
+            };
+            std::size_t length;
+            uint64_t ext_tag;
+
+            cell(cell_kind kind, semantic_tag tag) noexcept
+                : kind(kind), tag(tag), uint64_val(0), length(0), ext_tag(0)
+            {
+            }
+        };
+        using cell_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<cell>;
+
+        block_state state_;
+        std::size_t num_rows_;
+        std::size_t row_;
+        std::size_t column_;
+        std::vector<string_type,string_allocator_type> keys_;
+        std::vector<cell,cell_allocator_type> cells_;
+        string_type buffer_;
+    public:
+        columnar_block_reader(const Allocator& alloc = Allocator())
+            : state_(block_state::start), num_rows_(0), row_(0), column_(0),
+              keys_(alloc), cells_(alloc), buffer_(alloc)
+        {
+        }
+
+        void reset()
+        {
+            state_ = block_state::start;
+            num_rows_ = 0;
+            row_ = 0;
+            column_ = 0;
+            keys_.clear();
+            cells_.clear();
+            buffer_.clear();
+        }
+
+        bool done() const
+        {
+            return state_ == block_state::done;
+        }
+
+        std::size_t num_rows() const
+        {
+            return num_rows_;
+        }
+
+        std::size_t num_keys() const
+        {
+            return keys_.size();
+        }
+
+        // Number of events for the rows, excluding the begin and end of the array
+        std::size_t event_count() const
+        {
+            return num_rows_*row_event_count();
+        }
+
+        // begin_object, a key and a value for each key, end_object
+        std::size_t row_event_count() const
+        {
+            return 2*keys_.size() + 2;
+        }
+
+        bool produce_event(std::size_t index, basic_item_event_visitor<char>& visitor,
+                           const ser_context& context, std::error_code& ec) const
+        {
+            const std::size_t per_row = row_event_count();
+            const std::size_t row = index / per_row;
+            const std::size_t pos = index % per_row;
+            if (pos == 0)
+            {
+                return visitor.begin_object(keys_.size(), semantic_tag::none, context, ec);
+            }
+            if (pos == per_row - 1)
+            {
+                return visitor.end_object(context, ec);
+            }
+            const std::size_t i = (pos - 1) / 2;
+            if ((pos - 1) % 2 == 0)
+            {
+                return visitor.string_value(keys_[i], semantic_tag::none, context, ec);
+            }
+            const cell& c = cells_[i*num_rows_ + row];
+            switch (c.kind)
+            {
+                case cell_kind::bool_value:
+                    return visitor.bool_value(c.bool_val, c.tag, context, ec);
+                case cell_kind::int64_value:
+                    return visitor.int64_value(c.int64_val, c.tag, context, ec);
+                case cell_kind::uint64_value:
+                    return visitor.uint64_value(c.uint64_val, c.tag, context, ec);
+                case cell_kind::half_value:
+                    return visitor.half_value(c.half_val, c.tag, context, ec);
+                case cell_kind::double_value:
+                    return visitor.double_value(c.double_val, c.tag, context, ec);
+                case cell_kind::string_value:
+                    return visitor.string_value(string_view(buffer_.data()+c.offset, c.length), c.tag, context, ec);
+                case cell_kind::byte_string_value:
+                    return visitor.byte_string_value(byte_string_view(reinterpret_cast<const uint8_t*>(buffer_.data())+c.offset, c.length),
+                                                     c.tag, context, ec);
+                case cell_kind::ext_value:
+                    return visitor.byte_string_value(byte_string_view(reinterpret_cast<const uint8_t*>(buffer_.data())+c.offset, c.length),
+                                                     c.ext_tag, context, ec);
+                default:
+                    return visitor.null_value(c.tag, context, ec);
+            }
+        }
+
+    private:
+        bool invalid()
+        {
+            state_ = block_state::invalid;
+            return false;
+        }
+
+        bool add_cell(const cell& c)
+        {
+            if (state_ != block_state::column)
+            {
+                return invalid();
+            }
+            cells_.push_back(c);
+            ++row_;
+            return true;
+        }
+
+        bool add_string(cell_kind kind, semantic_tag tag, const char* data, std::size_t length, uint64_t ext_tag = 0)
+        {
+            cell c(kind, tag);
+            c.offset = buffer_.size();
+            c.length = length;
+            c.ext_tag = ext_tag;
+            buffer_.append(data, length);
+            return add_cell(c);
+        }
+
+        void visit_flush() override
+        {
+        }
+
+        bool visit_begin_object(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            return invalid();
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            return invalid();
+        }
+
+        bool visit_begin_array(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            switch (state_)
+            {
+                case block_state::start:
+                    state_ = block_state::keys_begin;
+                    return true;
+                case block_state::keys_begin:
+                    state_ = block_state::keys;
+                    return true;
+                case block_state::column_begin:
+                    state_ = block_state::column;
+                    row_ = 0;
+                    return true;
+                default:
+                    return invalid();
+            }
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            switch (state_)
+            {
+                case block_state::keys:
+                    if (keys_.empty())
+                    {
+                        return invalid();
+                    }
+                    state_ = block_state::column_begin;
+                    return true;
+                case block_state::column:
+                    if (column_ == 0)
+                    {
+                        num_rows_ = row_;
+                    }
+                    else if (row_ != num_rows_)
+                    {
+                        return invalid();
+                    }
+                    ++column_;
+                    state_ = column_ < keys_.size() ? block_state::column_begin : block_state::end;
+                    return true;
+                case block_state::end:
+                    state_ = block_state::done;
+                    return false;
+                default:
+                    return invalid();
+            }
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_cell(cell(cell_kind::null_value, tag));
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            cell c(cell_kind::bool_value, tag);
+            c.bool_val = value;
+            return add_cell(c);
+        }
+
+        bool visit_string(const string_view_type& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            if (state_ == block_state::keys)
+            {
+                keys_.push_back(string_type(value.data(), value.size(), char_allocator_type(keys_.get_allocator())));
+                return true;
+            }
+            return add_string(cell_kind::string_value, tag, value.data(), value.size());
+        }
+
+        bool visit_byte_string(const byte_string_view& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_string(cell_kind::byte_string_value, tag, reinterpret_cast<const char*>(value.data()), value.size());
+        }
+
+        bool visit_byte_string(const byte_string_view& value, uint64_t ext_tag, const ser_context&, std::error_code&) override
+        {
+            return add_string(cell_kind::ext_value, semantic_tag::ext, reinterpret_cast<const char*>(value.data()), value.size(), ext_tag);
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            cell c(cell_kind::uint64_value, tag);
+            c.uint64_val = value;
+            return add_cell(c);
+        }
+
+        bool visit_int64(int64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            cell c(cell_kind::int64_value, tag);
+            c.int64_val = value;
+            return add_cell(c);
+        }
+
+        bool visit_half(uint16_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            cell c(cell_kind::half_value, tag);
+            c.half_val = value;
+            return add_cell(c);
+        }
+
+        bool visit_double(double value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            cell c(cell_kind::double_value, tag);
+            c.double_val = value;
+            return add_cell(c);
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
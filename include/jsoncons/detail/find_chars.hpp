@@ -0,0 +1,249 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_FIND_CHARS_HPP
+#define JSONCONS_DETAIL_FIND_CHARS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <type_traits>
+#include <jsoncons/config/compiler_support.hpp>
+#if defined(JSONCONS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__) && !defined(JSONCONS_NO_SSE2)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    inline
+    int count_trailing_zeros(uint32_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return static_cast<int>(index);
+#else
+        int n = 0;
+        while ((x & 1) == 0)
+        {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    // A set of up to five characters to search for. Unused slots repeat the first character.
+
+    template <class CharT>
+    struct char_set
+    {
+        CharT chars[5];
+        std::size_t size;
+
+        char_set(const CharT* first, std::size_t length) noexcept
+            : size(length <= 5 ? length : 5)
+        {
+            for (std::size_t i = 0; i < 5; ++i)
+            {
+                chars[i] = i < size ? first[i] : first[0];
+            }
+        }
+
+        bool contains(CharT c) const noexcept
+        {
+            return c == chars[0] || c == chars[1] || c == chars[2] || c == chars[3] || c == chars[4];
+        }
+    };
+
+    // Returns a pointer to the first character in [first,last) that is in set, or last.
+    // Single byte characters are compared in blocks of 32 (AVX2) or 16 (SSE2) bytes.
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) == 1,const CharT*>::type
+    find_first_of(const CharT* first, const CharT* last, const char_set<CharT>& set) noexcept
+    {
+#if defined(__AVX2__) && !defined(JSONCONS_NO_SSE2)
+        {
+            const __m256i c0 = _mm256_set1_epi8(static_cast<char>(set.chars[0]));
+            const __m256i c1 = _mm256_set1_epi8(static_cast<char>(set.chars[1]));
+            const __m256i c2 = _mm256_set1_epi8(static_cast<char>(set.chars[2]));
+            const __m256i c3 = _mm256_set1_epi8(static_cast<char>(set.chars[3]));
+            const __m256i c4 = _mm256_set1_epi8(static_cast<char>(set.chars[4]));
+            while (last - first >= 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i eq = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, c0), _mm256_cmpeq_epi8(block, c1)),
+                                             _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, c2), _mm256_cmpeq_epi8(block, c3)),
+                                                             _mm256_cmpeq_epi8(block, c4)));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 32;
+            }
+        }
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i c0 = _mm_set1_epi8(static_cast<char>(set.chars[0]));
+            const __m128i c1 = _mm_set1_epi8(static_cast<char>(set.chars[1]));
+            const __m128i c2 = _mm_set1_epi8(static_cast<char>(set.chars[2]));
+            const __m128i c3 = _mm_set1_epi8(static_cast<char>(set.chars[3]));
+            const __m128i c4 = _mm_set1_epi8(static_cast<char>(set.chars[4]));
+            while (last - first >= 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, c0), _mm_cmpeq_epi8(block, c1)),
+                                          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, c2), _mm_cmpeq_epi8(block, c3)),
+                                                       _mm_cmpeq_epi8(block, c4)));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 16;
+            }
+        }
+#endif
+        while (first != last && !set.contains(*first))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) != 1,const CharT*>::type
+    find_first_of(const CharT* first, const CharT* last, const char_set<CharT>& set) noexcept
+    {
+        while (first != last && !set.contains(*first))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    // True if c must be escaped in a JSON string: a quote, a backslash, a control character,
+    // a solidus if escape_solidus, and a non-ASCII character if escape_all_non_ascii.
+
+    template <class CharT>
+    bool is_json_escape_char(CharT c, bool escape_all_non_ascii, bool escape_solidus) noexcept
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+        const auto u = static_cast<uchar_type>(c);
+        return u <= 0x1f || u == 0x7f || c == '\"' || c == '\\' || (escape_solidus && c == '/') || (escape_all_non_ascii && u >= 0x80);
+    }
+
+    // Returns a pointer to the first character in [first,last) that must be escaped in a JSON string,
+    // or last. Single byte characters are tested in blocks of 32 (AVX2), 16 (SSE2) or 8 bytes.
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) == 1,const CharT*>::type
+    find_json_escape_char(const CharT* first, const CharT* last, bool escape_all_non_ascii, bool escape_solidus) noexcept
+    {
+        // Without escape_solidus, the solidus comparison repeats the quote comparison
+        const char solidus = escape_solidus ? '/' : '\"';
+#if defined(__AVX2__) && !defined(JSONCONS_NO_SSE2)
+        {
+            const __m256i quote = _mm256_set1_epi8('\"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i slash = _mm256_set1_epi8(solidus);
+            const __m256i del = _mm256_set1_epi8(0x7f);
+            const __m256i max_control = _mm256_set1_epi8(0x1f);
+            const uint32_t non_ascii = escape_all_non_ascii ? 0xffffffff : 0;
+            while (last - first >= 32)
+            {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i eq = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)),
+                                             _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, slash), _mm256_cmpeq_epi8(block, del)),
+                                                             _mm256_cmpeq_epi8(_mm256_max_epu8(block, max_control), max_control)));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq)) | (static_cast<uint32_t>(_mm256_movemask_epi8(block)) & non_ascii);
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 32;
+            }
+        }
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i slash = _mm_set1_epi8(solidus);
+            const __m128i del = _mm_set1_epi8(0x7f);
+            const __m128i max_control = _mm_set1_epi8(0x1f);
+            const uint32_t non_ascii = escape_all_non_ascii ? 0xffff : 0;
+            while (last - first >= 16)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),
+                                          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, slash), _mm_cmpeq_epi8(block, del)),
+                                                       _mm_cmpeq_epi8(_mm_max_epu8(block, max_control), max_control)));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq)) | (static_cast<uint32_t>(_mm_movemask_epi8(block)) & non_ascii);
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 16;
+            }
+        }
+#else
+        {
+            // SWAR: a byte of has_zero(x) has its high bit set if the byte of x is zero (or follows one that is),
+            // so a word with any match is finished byte by byte below
+            const uint64_t ones = 0x0101010101010101ull;
+            const uint64_t high_bits = 0x8080808080808080ull;
+            const uint64_t non_ascii = escape_all_non_ascii ? high_bits : 0;
+            auto has_zero = [=](uint64_t x) {return (x - ones) & ~x & high_bits;};
+            while (last - first >= 8)
+            {
+                uint64_t x;
+                std::memcpy(&x, first, 8);
+                uint64_t mask = has_zero(x ^ (ones * '\"')) | has_zero(x ^ (ones * '\\')) |
+                                has_zero(x ^ (ones * static_cast<uint8_t>(solidus))) | has_zero(x ^ (ones * 0x7f)) |
+                                ((x - ones * 0x20) & ~x & high_bits) | (x & non_ascii);
+                if (mask != 0)
+                {
+                    break;
+                }
+                first += 8;
+            }
+        }
+#endif
+        while (first != last && !is_json_escape_char(*first, escape_all_non_ascii, escape_solidus))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) != 1,const CharT*>::type
+    find_json_escape_char(const CharT* first, const CharT* last, bool escape_all_non_ascii, bool escape_solidus) noexcept
+    {
+        while (first != last && !is_json_escape_char(*first, escape_all_non_ascii, escape_solidus))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,55 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_MUL128_HPP
+#define JSONCONS_DETAIL_MUL128_HPP
+
+#include <cstdint>
+#include <jsoncons/config/compiler_support.hpp>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h> // _umul128
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    struct uint64x2
+    {
+        uint64_t hi;
+        uint64_t lo;
+    };
+
+    // The 128 bit product of two 64 bit integers
+    inline
+    uint64x2 mul128(uint64_t x, uint64_t y) noexcept
+    {
+#if defined(JSONCONS_HAS_INT128)
+        const uint128_type p = static_cast<uint128_type>(x) * y;
+        return {static_cast<uint64_t>(p >> 64), static_cast<uint64_t>(p)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+        uint64_t hi;
+        uint64_t lo = _umul128(x, y, &hi);
+        return {hi, lo};
+#else
+        const uint64_t x_lo = x & 0xFFFFFFFF;
+        const uint64_t x_hi = x >> 32;
+        const uint64_t y_lo = y & 0xFFFFFFFF;
+        const uint64_t y_hi = y >> 32;
+
+        const uint64_t lo_lo = x_lo * y_lo;
+        const uint64_t hi_lo = x_hi * y_lo;
+        const uint64_t lo_hi = x_lo * y_hi;
+        const uint64_t hi_hi = x_hi * y_hi;
+
+        const uint64_t mid = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+        return {hi_hi + (hi_lo >> 32) + (mid >> 32), (mid << 32) | (lo_lo & 0xFFFFFFFF)};
+#endif
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
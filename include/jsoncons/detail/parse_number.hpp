@@ -18,6 +18,7 @@
 #include <exception>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/detail/eisel_lemire.hpp>
 #include <cctype>
 
 namespace jsoncons { namespace detail {
@@ -926,6 +927,10 @@ public:
     operator()(const CharT* s, std::size_t len) const
     {
         double val = 0;
+        if (decimal_to_double(s, s+len, val))
+        {
+            return val;
+        }
         const auto res = std::from_chars(s, s+len, val);
         if (res.ec != std::errc())
         {
@@ -938,13 +943,17 @@ public:
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
     operator()(const CharT* s, std::size_t len) const
     {
+        double val = 0;
+        if (decimal_to_double(s, s+len, val))
+        {
+            return val;
+        }
         std::string input(len,'0');
         for (size_t i = 0; i < len; ++i)
         {
             input[i] = static_cast<char>(s[i]);
         }
 
-        double val = 0;
         const auto res = std::from_chars(input.data(), input.data() + len, val);
         if (res.ec != std::errc())
         {
@@ -958,20 +967,33 @@ public:
 class chars_to
 {
 private:
-    _locale_t locale_;
+    mutable _locale_t locale_;
+
+    // Created on first use, most numbers don't need it
+    _locale_t c_locale() const
+    {
+        if (locale_ == nullptr)
+        {
+            locale_ = _create_locale(LC_NUMERIC, "C");
+        }
+        return locale_;
+    }
 public:
     chars_to()
+        : locale_(nullptr)
     {
-        locale_ = _create_locale(LC_NUMERIC, "C");
     }
     ~chars_to() noexcept
     {
-        _free_locale(locale_);
+        if (locale_ != nullptr)
+        {
+            _free_locale(locale_);
+        }
     }
 
     chars_to(const chars_to&)
+        : locale_(nullptr)
     {
-        locale_ = _create_locale(LC_NUMERIC, "C");
     }
 
     chars_to& operator=(const chars_to&) 
@@ -987,10 +1009,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t len) const
     {
+        double val = 0;
+        if (decimal_to_double(s, s+len, val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = _strtod_l(s, &end, locale_);
+        val = _strtod_l(s, &end, c_locale());
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1000,10 +1027,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t len) const
     {
+        double val = 0;
+        if (decimal_to_double(s, s+len, val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = _wcstod_l(s, &end, locale_);
+        val = _wcstod_l(s, &end, c_locale());
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1017,20 +1049,33 @@ public:
 class chars_to
 {
 private:
-    locale_t locale_;
+    mutable locale_t locale_;
+
+    // Created on first use, most numbers don't need it
+    locale_t c_locale() const
+    {
+        if (locale_ == (locale_t) 0)
+        {
+            locale_ = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+        }
+        return locale_;
+    }
 public:
     chars_to()
+        : locale_((locale_t) 0)
     {
-        locale_ = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
     }
     ~chars_to() noexcept
     {
-        freelocale(locale_);
+        if (locale_ != (locale_t) 0)
+        {
+            freelocale(locale_);
+        }
     }
 
     chars_to(const chars_to&)
+        : locale_((locale_t) 0)
     {
-        locale_ = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
     }
 
     chars_to& operator=(const chars_to&) 
@@ -1045,10 +1090,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t len) const
     {
+        double val = 0;
+        if (decimal_to_double(s, s+len, val))
+        {
+            return val;
+        }
         char *end = nullptr;
-        double val = strtold_l(s, &end, locale_);
+        val = strtold_l(s, &end, c_locale());
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1058,10 +1108,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t len) const
     {
+        double val = 0;
+        if (decimal_to_double(s, s+len, val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = wcstold_l(s, &end, locale_);
+        val = wcstold_l(s, &end, c_locale());
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1102,10 +1157,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val = 0;
+        if (decimal_to_double(s, s+length, val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = strtod(s, &end);
+        val = strtod(s, &end);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -1115,10 +1175,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val = 0;
+        if (decimal_to_double(s, s+length, val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = wcstod(s, &end);
+        val = wcstod(s, &end);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -16,7 +16,7 @@
 #include <stdio.h> // snprintf
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_options.hpp>
-#include <jsoncons/detail/grisu3.hpp>
+#include <jsoncons/detail/schubfach.hpp>
 #include <jsoncons/detail/parse_number.hpp>
 #include <jsoncons/extension_traits.hpp>
 
@@ -365,7 +365,7 @@ namespace detail {
         char buffer[100];
 
         double u = std::signbit(v) ? -v : v;
-        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
+        if (jsoncons::detail::schubfach(u, buffer, &length, &k))
         {
             if (std::signbit(v))
             {
@@ -432,7 +432,7 @@ namespace detail {
         char buffer[100];
 
         double u = std::signbit(v) ? -v : v;
-        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
+        if (jsoncons::detail::schubfach(u, buffer, &length, &k))
         {
             if (std::signbit(v))
             {
@@ -462,25 +462,41 @@ namespace detail {
     class write_double
     {
     private:
-        chars_to to_double_;
         float_chars_format float_format_;
         int precision_;
         char decimal_point_;
     public:
         write_double(float_chars_format float_format, int precision)
-           : float_format_(float_format), precision_(precision), decimal_point_('.')
+           : float_format_(float_format), precision_(precision), decimal_point_(0)
         {
-    #if !defined(JSONCONS_NO_LOCALECONV)
-            struct lconv *lc = localeconv();
-            if (lc != nullptr && lc->decimal_point[0] != 0)
-            {
-                decimal_point_ = lc->decimal_point[0];
-            }
-    #endif
         }
         write_double(const write_double&) = default;
 
         write_double& operator=(const write_double&) = default;
+    private:
+        // The locale's decimal point, which appears in snprintf output. Looked up on first use.
+        char decimal_point()
+        {
+            if (decimal_point_ == 0)
+            {
+                decimal_point_ = '.';
+    #if !defined(JSONCONS_NO_LOCALECONV)
+                struct lconv *lc = localeconv();
+                if (lc != nullptr && lc->decimal_point[0] != 0)
+                {
+                    decimal_point_ = lc->decimal_point[0];
+                }
+    #endif
+            }
+            return decimal_point_;
+        }
+
+        // Shortest round trip output doesn't go through snprintf on IEEE 754 platforms
+        char shortest_decimal_point()
+        {
+            return std::numeric_limits<double>::is_iec559 ? '.' : decimal_point();
+        }
+    public:
 
         template<class Result>
         std::size_t operator()(double val, Result& result)
@@ -501,11 +517,11 @@ namespace detail {
                         {
                             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
                         }
-                        dump_buffer(number_buffer, length, decimal_point_, result);
+                        dump_buffer(number_buffer, length, decimal_point(), result);
                     }
                     else
                     {
-                        if (!dtoa_fixed(val, decimal_point_, result))
+                        if (!dtoa_fixed(val, shortest_decimal_point(), result))
                         {
                             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
                         }
@@ -521,11 +537,11 @@ namespace detail {
                         {
                             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
                         }
-                        dump_buffer(number_buffer, length, decimal_point_, result);
+                        dump_buffer(number_buffer, length, decimal_point(), result);
                     }
                     else
                     {
-                        if (!dtoa_scientific(val, decimal_point_, result))
+                        if (!dtoa_scientific(val, decimal_point(), result))
                         {
                             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
                         }
@@ -541,11 +557,11 @@ namespace detail {
                         {
                             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
                         }
-                        dump_buffer(number_buffer, length, decimal_point_, result);
+                        dump_buffer(number_buffer, length, decimal_point(), result);
                     }
                     else
                     {
-                        if (!dtoa_general(val, decimal_point_, result))
+                        if (!dtoa_general(val, shortest_decimal_point(), result))
                         {
                             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
                         }
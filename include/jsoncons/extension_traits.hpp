@@ -464,6 +464,15 @@ namespace extension_traits {
     using
     container_insert_t = decltype(std::declval<Container>().insert(std::declval<typename Container::value_type>()));
 
+    template<class Container>
+    using
+    container_range_insert_t = decltype(std::declval<Container>().insert(std::declval<Container>().end(),
+                                                                          std::declval<const uint8_t*>(), std::declval<const uint8_t*>()));
+
+    template<class Sink>
+    using
+    sink_append_t = decltype(std::declval<Sink>().append(std::declval<const uint8_t*>(), std::declval<std::size_t>()));
+
     template<class Container>
     using
     container_reserve_t = decltype(std::declval<Container>().reserve(typename Container::size_type()));
@@ -591,6 +600,18 @@ namespace extension_traits {
     using
     is_insertable = is_detected<container_insert_t, Container>;
 
+    // has_range_insert
+
+    template<class Container>
+    using
+    has_range_insert = is_detected<container_range_insert_t, Container>;
+
+    // has_append
+
+    template<class Sink>
+    using
+    has_append = is_detected<sink_append_t, Sink>;
+
     // has_data, has_data_exact
 
     template<class Container>
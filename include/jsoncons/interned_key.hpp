@@ -0,0 +1,540 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INTERNED_KEY_HPP
+#define JSONCONS_INTERNED_KEY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <iterator> // std::distance
+#include <memory> // std::allocator_traits
+#include <new> // placement new
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility> // std::swap
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons {
+
+    template <class CharT,class Traits,class Allocator>
+    class basic_key_table;
+
+    // basic_interned_key
+
+    // An immutable, reference counted object member name. Copies share one heap
+    // allocation. Keys made by the same basic_key_table with the same characters
+    // share an allocation too, so comparing them for equality compares pointers.
+
+    template <class CharT,class Traits = std::char_traits<CharT>,class Allocator = std::allocator<CharT>>
+    class basic_interned_key
+    {
+        friend class basic_key_table<CharT,Traits,Allocator>;
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using key_table_type = basic_key_table<CharT,Traits,Allocator>;
+        using size_type = std::size_t;
+        using const_iterator = const CharT*;
+        using iterator = const CharT*;
+        using string_view_type = jsoncons::basic_string_view<CharT,Traits>;
+    private:
+        struct node
+        {
+            allocator_type alloc;
+            std::atomic<std::size_t> refs;
+            std::uint64_t table_id; // 0 if not made by a key table
+            std::size_t hash;
+            std::size_t length;
+
+            node(const allocator_type& a, std::uint64_t id, std::size_t h, std::size_t n)
+                : alloc(a), refs(1), table_id(id), hash(h), length(n)
+            {
+            }
+
+            CharT* data() noexcept
+            {
+                return reinterpret_cast<CharT*>(reinterpret_cast<char*>(this) + header_size());
+            }
+
+            static constexpr std::size_t header_size() noexcept
+            {
+                return (sizeof(node) + alignof(CharT) - 1) / alignof(CharT) * alignof(CharT);
+            }
+        };
+
+        using byte_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+        using byte_allocator_traits = std::allocator_traits<byte_allocator_type>;
+
+        node* ptr_;
+
+        explicit basic_interned_key(node* ptr) noexcept
+            : ptr_(ptr)
+        {
+        }
+
+        static node* create(const CharT* s, std::size_t length, const allocator_type& alloc,
+                            std::uint64_t table_id, std::size_t hash)
+        {
+            byte_allocator_type byte_alloc(alloc);
+            char* p = byte_allocator_traits::allocate(byte_alloc, allocation_size(length));
+            node* n = ::new(p) node(alloc, table_id, hash, length);
+            if (length > 0)
+            {
+                std::memcpy(n->data(), s, length*sizeof(CharT));
+            }
+            n->data()[length] = CharT();
+            return n;
+        }
+
+        static std::size_t allocation_size(std::size_t length) noexcept
+        {
+            return node::header_size() + (length+1)*sizeof(CharT);
+        }
+
+        static void add_ref(node* n) noexcept
+        {
+            if (n != nullptr)
+            {
+                n->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        static void release(node* n) noexcept
+        {
+            if (n != nullptr && n->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                byte_allocator_type byte_alloc(n->alloc);
+                std::size_t size = allocation_size(n->length);
+                n->~node();
+                byte_allocator_traits::deallocate(byte_alloc, reinterpret_cast<char*>(n), size);
+            }
+        }
+
+        static const CharT* empty_data() noexcept
+        {
+            static const CharT s[1] = {CharT()};
+            return s;
+        }
+    public:
+        basic_interned_key() noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        explicit basic_interned_key(const allocator_type&) noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        basic_interned_key(const CharT* s, std::size_t length, const allocator_type& alloc = allocator_type())
+            : ptr_(length > 0 ? create(s, length, alloc, 0, 0) : nullptr)
+        {
+        }
+
+        basic_interned_key(const CharT* s, const allocator_type& alloc = allocator_type())
+            : basic_interned_key(s, Traits::length(s), alloc)
+        {
+        }
+
+        template <class InputIt,class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        basic_interned_key(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : ptr_(nullptr)
+        {
+            std::basic_string<CharT,Traits> buf(first, last);
+            if (!buf.empty())
+            {
+                ptr_ = create(buf.data(), buf.size(), alloc, 0, 0);
+            }
+        }
+
+        template <class Alloc>
+        basic_interned_key(const std::basic_string<CharT,Traits,Alloc>& s, const allocator_type& alloc = allocator_type())
+            : basic_interned_key(s.data(), s.size(), alloc)
+        {
+        }
+
+        basic_interned_key(const basic_interned_key& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            add_ref(ptr_);
+        }
+
+        basic_interned_key(const basic_interned_key& other, const allocator_type&) noexcept
+            : ptr_(other.ptr_)
+        {
+            add_ref(ptr_);
+        }
+
+        basic_interned_key(basic_interned_key&& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            other.ptr_ = nullptr;
+        }
+
+        basic_interned_key(basic_interned_key&& other, const allocator_type&) noexcept
+            : ptr_(other.ptr_)
+        {
+            other.ptr_ = nullptr;
+        }
+
+        ~basic_interned_key() noexcept
+        {
+            release(ptr_);
+        }
+
+        basic_interned_key& operator=(const basic_interned_key& other) noexcept
+        {
+            add_ref(other.ptr_);
+            release(ptr_);
+            ptr_ = other.ptr_;
+            return *this;
+        }
+
+        basic_interned_key& operator=(basic_interned_key&& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            return *this;
+        }
+
+        void swap(basic_interned_key& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return ptr_ != nullptr ? ptr_->alloc : allocator_type();
+        }
+
+        const CharT* data() const noexcept
+        {
+            return ptr_ != nullptr ? ptr_->data() : empty_data();
+        }
+
+        const CharT* c_str() const noexcept
+        {
+            return data();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return ptr_ != nullptr ? ptr_->length : 0;
+        }
+
+        std::size_t length() const noexcept
+        {
+            return size();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        const CharT& operator[](std::size_t i) const noexcept
+        {
+            return data()[i];
+        }
+
+        // True if this key and other are known to be the same key table entry
+        bool is_same_entry(const basic_interned_key& other) const noexcept
+        {
+            return ptr_ == other.ptr_;
+        }
+
+        operator string_view_type() const noexcept
+        {
+            return string_view_type(data(), size());
+        }
+
+        int compare(const basic_interned_key& other) const noexcept
+        {
+            return ptr_ == other.ptr_ ? 0 : string_view_type(*this).compare(string_view_type(other));
+        }
+
+        int compare(const string_view_type& s) const noexcept
+        {
+            return string_view_type(*this).compare(s);
+        }
+
+        friend bool operator==(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            if (lhs.ptr_ == rhs.ptr_)
+            {
+                return true;
+            }
+            // Distinct entries of the same key table have different characters
+            if (lhs.ptr_ != nullptr && rhs.ptr_ != nullptr && lhs.ptr_->table_id != 0 && lhs.ptr_->table_id == rhs.ptr_->table_id)
+            {
+                return false;
+            }
+            return string_view_type(lhs) == string_view_type(rhs);
+        }
+
+        friend bool operator!=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+        friend bool operator==(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return string_view_type(lhs) == rhs;
+        }
+
+        friend bool operator==(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs == string_view_type(rhs);
+        }
+
+        friend bool operator!=(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return string_view_type(lhs) != rhs;
+        }
+
+        friend bool operator!=(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs != string_view_type(rhs);
+        }
+
+        friend bool operator<(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return string_view_type(lhs) < rhs;
+        }
+
+        friend bool operator<(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs < string_view_type(rhs);
+        }
+
+        friend bool operator==(const basic_interned_key& lhs, const CharT* rhs) noexcept
+        {
+            return string_view_type(lhs) == string_view_type(rhs);
+        }
+
+        friend bool operator!=(const basic_interned_key& lhs, const CharT* rhs) noexcept
+        {
+            return string_view_type(lhs) != string_view_type(rhs);
+        }
+
+        template <class Alloc>
+        friend bool operator==(const basic_interned_key& lhs, const std::basic_string<CharT,Traits,Alloc>& rhs) noexcept
+        {
+            return string_view_type(lhs) == string_view_type(rhs.data(), rhs.size());
+        }
+
+        template <class Alloc>
+        friend bool operator==(const std::basic_string<CharT,Traits,Alloc>& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return string_view_type(lhs.data(), lhs.size()) == string_view_type(rhs);
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_interned_key& key)
+        {
+            os.write(key.data(), key.size());
+            return os;
+        }
+    };
+
+    // basic_key_table
+
+    // Makes interned keys. Each distinct name is allocated once, and the table keeps a
+    // reference to it until the table is cleared or destroyed. Keys remain valid after that.
+    // A key table is not thread safe, but the keys it makes may be shared between threads.
+
+    template <class CharT,class Traits = std::char_traits<CharT>,class Allocator = std::allocator<CharT>>
+    class basic_key_table
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using key_type = basic_interned_key<CharT,Traits,Allocator>;
+        using string_view_type = jsoncons::basic_string_view<CharT,Traits>;
+    private:
+        using node = typename key_type::node;
+        using node_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<node*>;
+
+        allocator_type alloc_;
+        std::uint64_t id_;
+        std::vector<node*,node_allocator_type> slots_;
+        std::size_t size_;
+
+        // Noncopyable and nonmoveable
+        basic_key_table(const basic_key_table&) = delete;
+        basic_key_table& operator=(const basic_key_table&) = delete;
+
+        static std::uint64_t next_id() noexcept
+        {
+            static std::atomic<std::uint64_t> counter{0};
+            return ++counter;
+        }
+
+        static std::size_t hash_chars(const CharT* s, std::size_t length) noexcept
+        {
+            // FNV-1a
+            std::uint64_t h = 14695981039346656037ull;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                h ^= static_cast<std::uint64_t>(static_cast<typename std::make_unsigned<CharT>::type>(s[i]));
+                h *= 1099511628211ull;
+            }
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+
+        void grow()
+        {
+            std::vector<node*,node_allocator_type> slots(slots_.empty() ? 64 : slots_.size()*2, nullptr, node_allocator_type(alloc_));
+            const std::size_t mask = slots.size() - 1;
+            for (node* n : slots_)
+            {
+                if (n != nullptr)
+                {
+                    std::size_t i = n->hash & mask;
+                    while (slots[i] != nullptr)
+                    {
+                        i = (i + 1) & mask;
+                    }
+                    slots[i] = n;
+                }
+            }
+            slots_.swap(slots);
+        }
+    public:
+        explicit basic_key_table(const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), id_(next_id()), slots_(node_allocator_type(alloc)), size_(0)
+        {
+        }
+
+        ~basic_key_table() noexcept
+        {
+            clear();
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        // Returns the number of distinct keys
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        // Releases the table's references to its keys. Keys made afterwards
+        // are not shared with keys made before.
+        void clear() noexcept
+        {
+            for (node* n : slots_)
+            {
+                key_type::release(n);
+            }
+            slots_.clear();
+            size_ = 0;
+            id_ = next_id();
+        }
+
+        key_type make_key(const CharT* s, std::size_t length)
+        {
+            if (length == 0)
+            {
+                return key_type();
+            }
+            if ((size_ + 1)*4 > slots_.size()*3)
+            {
+                grow();
+            }
+            const std::size_t hash = hash_chars(s, length);
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t i = hash & mask;
+            while (slots_[i] != nullptr)
+            {
+                node* n = slots_[i];
+                if (n->hash == hash && n->length == length && Traits::compare(n->data(), s, length) == 0)
+                {
+                    key_type::add_ref(n);
+                    return key_type(n);
+                }
+                i = (i + 1) & mask;
+            }
+            node* n = key_type::create(s, length, alloc_, id_, hash);
+            slots_[i] = n;
+            ++size_;
+            key_type::add_ref(n);
+            return key_type(n);
+        }
+
+        key_type make_key(const string_view_type& s)
+        {
+            return make_key(s.data(), s.size());
+        }
+
+        template <class Alloc,class = typename std::enable_if<!std::is_integral<Alloc>::value>::type>
+        key_type make_key(const string_view_type& s, const Alloc&)
+        {
+            return make_key(s.data(), s.size());
+        }
+    };
+
+    using interned_key = basic_interned_key<char>;
+    using winterned_key = basic_interned_key<wchar_t>;
+    using key_table = basic_key_table<char>;
+    using wkey_table = basic_key_table<wchar_t>;
+
+namespace detail {
+
+    // The key table json_decoder uses for KeyT. Keys without one of their own are
+    // constructed directly from the member name.
+
+    template <class KeyT,class Enable = void>
+    struct key_table_of
+    {
+        class type
+        {
+        public:
+            template <class Alloc>
+            explicit type(const Alloc&) noexcept
+            {
+            }
+
+            template <class StringView,class Alloc>
+            KeyT make_key(const StringView& s, const Alloc& alloc)
+            {
+                return KeyT(s.data(), s.size(), alloc);
+            }
+        };
+    };
+
+    template <class KeyT>
+    struct key_table_of<KeyT,typename std::enable_if<!std::is_void<typename KeyT::key_table_type>::value>::type>
+    {
+        using type = typename KeyT::key_table_type;
+    };
+
+} // namespace detail
+
+} // namespace jsoncons
+
+#endif
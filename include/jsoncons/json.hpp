@@ -13,6 +13,8 @@
 #include <jsoncons/json_traits_macros.hpp>
 #include <jsoncons/json_traits_macros_deprecated.hpp>
 #include <jsoncons/staj_iterator.hpp>
+#include <jsoncons/json_tape.hpp>
+#include <jsoncons/json_push_reader.hpp>
 
 #endif
 
@@ -287,6 +287,10 @@ namespace jsoncons {
             {
                 value_type current = std::move(elements_.back());
                 elements_.pop_back();
+                if (current.is_shared()) // released without visiting its elements
+                {
+                    continue;
+                }
                 switch (current.storage_kind())
                 {
                     case json_storage_kind::array_value:
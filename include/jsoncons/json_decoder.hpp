@@ -15,9 +15,20 @@
 #include <utility> // std::move
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/interned_key.hpp>
+#include <jsoncons/json_options.hpp> // jsoncons::duplicate_key_policy
+#include <jsoncons/json_object.hpp> // jsoncons::index_key_value
 
 namespace jsoncons {
 
+namespace detail {
+
+    template <class Object,class Json>
+    using uninitialized_init_with_policy_t = decltype(std::declval<Object&>().uninitialized_init(
+        std::declval<index_key_value<Json>*>(), std::size_t(), duplicate_key_policy(), true));
+
+} // namespace detail
+
 template <class Json,class TempAllocator=std::allocator<char>>
 class json_decoder final : public basic_json_visitor<typename Json::char_type>
 {
@@ -34,6 +45,7 @@ public:
     using json_array_allocator = typename array::allocator_type;
     using json_object_allocator = typename object::allocator_type;
     using json_byte_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t>;
+    using key_table_type = typename jsoncons::detail::key_table_of<key_type>::type;
 private:
 
     enum class structure_type {root_t, array_t, object_t};
@@ -42,9 +54,10 @@ private:
     {
         structure_type type_;
         std::size_t container_index_;
+        bool ascending_;
 
         structure_info(structure_type type, std::size_t offset) noexcept
-            : type_(type), container_index_(offset)
+            : type_(type), container_index_(offset), ascending_(true)
         {
         }
 
@@ -58,10 +71,13 @@ private:
 
     Json result_;
 
+    key_table_type own_key_table_;
+    key_table_type* shared_key_table_; // null when own_key_table_ is used, so copies and moves stay valid
     std::size_t index_;
     key_type name_;
     std::vector<index_key_value<Json>,stack_item_allocator_type> item_stack_;
     std::vector<structure_info,structure_info_allocator_type> structure_stack_;
+    duplicate_key_policy duplicate_keys_;
     bool is_valid_;
 
 public:
@@ -69,10 +85,13 @@ public:
         const temp_allocator_type& temp_alloc = temp_allocator_type())
         : allocator_(alloc),
           result_(),
+          own_key_table_(json_string_allocator(alloc)),
+          shared_key_table_(nullptr),
           index_(0),
           name_(alloc),
           item_stack_(alloc),
           structure_stack_(temp_alloc),
+          duplicate_keys_(duplicate_key_policy::first_wins),
           is_valid_(false)
     {
         item_stack_.reserve(1000);
@@ -84,10 +103,13 @@ public:
         const temp_allocator_type& temp_alloc = temp_allocator_type())
         : allocator_(),
           result_(),
+          own_key_table_(json_string_allocator()),
+          shared_key_table_(nullptr),
           index_(0),
           name_(),
           item_stack_(),
           structure_stack_(temp_alloc),
+          duplicate_keys_(duplicate_key_policy::first_wins),
           is_valid_(false)
     {
         item_stack_.reserve(1000);
@@ -95,6 +117,26 @@ public:
         structure_stack_.emplace_back(structure_type::root_t, 0);
     }
 
+    // Makes member names with key_table, which may be shared with other decoders. With
+    // interned keys, a name that occurs many times is allocated once.
+    json_decoder(key_table_type& key_table,
+        const allocator_type& alloc = allocator_type(), 
+        const temp_allocator_type& temp_alloc = temp_allocator_type())
+        : json_decoder(alloc, temp_alloc)
+    {
+        shared_key_table_ = std::addressof(key_table);
+    }
+
+    // Resolves a member name that occurs more than once in an object according to duplicate_keys.
+    // With duplicate_key_policy::error, decoding stops with json_errc::duplicate_key.
+    json_decoder(duplicate_key_policy duplicate_keys,
+        const allocator_type& alloc = allocator_type(), 
+        const temp_allocator_type& temp_alloc = temp_allocator_type())
+        : json_decoder(alloc, temp_alloc)
+    {
+        duplicate_keys_ = duplicate_keys;
+    }
+
 #if !defined(JSONCONS_NO_DEPRECATED)
     JSONCONS_DEPRECATED_MSG("Instead, use json_decoder(allocator, temp_allocator)")
     json_decoder(result_allocator_arg_t, const allocator_type& alloc, 
@@ -151,7 +193,22 @@ private:
         return true;
     }
 
-    bool visit_end_object(const ser_context&, std::error_code&) override
+    template <class Object>
+    typename std::enable_if<extension_traits::is_detected<detail::uninitialized_init_with_policy_t,Object,Json>::value,bool>::type
+    init_object(Object& obj, index_key_value<Json>* items, std::size_t count, bool ascending)
+    {
+        return obj.uninitialized_init(items, count, duplicate_keys_, ascending);
+    }
+
+    template <class Object>
+    typename std::enable_if<!extension_traits::is_detected<detail::uninitialized_init_with_policy_t,Object,Json>::value,bool>::type
+    init_object(Object& obj, index_key_value<Json>* items, std::size_t count, bool)
+    {
+        obj.uninitialized_init(items, count);
+        return true;
+    }
+
+    bool visit_end_object(const ser_context&, std::error_code& ec) override
     {
         JSONCONS_ASSERT(structure_stack_.size() > 0);
         JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::object_t);
@@ -162,8 +219,12 @@ private:
 
         if (count > 0)
         {
-            item_stack_[structure_index].value.template cast<typename Json::object_storage>().value().uninitialized_init(
-                &item_stack_[structure_index+1], count);
+            if (!init_object(item_stack_[structure_index].value.template cast<typename Json::object_storage>().value(),
+                             &item_stack_[structure_index+1], count, structure_stack_.back().ascending_))
+            {
+                ec = json_errc::duplicate_key;
+                return false;
+            }
         }
 
         item_stack_.erase(first, item_stack_.end());
@@ -228,7 +289,18 @@ private:
 
     bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
     {
-        name_ = key_type(name.data(),name.length(),allocator_);
+        // Strictly ascending names are unique, and the object needs neither sorting nor 
+        // checking for duplicates
+        auto& info = structure_stack_.back();
+        if (info.ascending_ && item_stack_.size() > info.container_index_ + 1)
+        {
+            const auto& prev = item_stack_.back().name;
+            if (string_view_type(prev.data(), prev.size()).compare(name) >= 0)
+            {
+                info.ascending_ = false;
+            }
+        }
+        name_ = (shared_key_table_ != nullptr ? *shared_key_table_ : own_key_table_).make_key(name, allocator_);
         return true;
     }
 
@@ -23,6 +23,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/sink.hpp>
 #include <jsoncons/detail/write_number.hpp>
+#include <jsoncons/detail/find_chars.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -49,6 +50,18 @@ namespace detail {
         const CharT* end = s + length;
         for (const CharT* it = begin; it != end; ++it)
         {
+            // Characters that need no escaping are appended as one run
+            const CharT* next = jsoncons::detail::find_json_escape_char(it, end, escape_all_non_ascii, escape_solidus);
+            if (next != it)
+            {
+                sink.append(it, static_cast<std::size_t>(next - it));
+                count += static_cast<std::size_t>(next - it);
+                it = next;
+                if (it == end)
+                {
+                    break;
+                }
+            }
             CharT c = *it;
             switch (c)
             {
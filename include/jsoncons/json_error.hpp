@@ -44,7 +44,8 @@ namespace jsoncons {
         illegal_codepoint,
         illegal_surrogate_value,
         unpaired_high_surrogate,
-        illegal_unicode_character
+        illegal_unicode_character,
+        duplicate_key
     };
 
     class json_error_category_impl
@@ -119,6 +120,8 @@ namespace jsoncons {
                     return "Expected low surrogate following the high surrogate";
                 case json_errc::illegal_unicode_character:
                     return "Illegal unicode character";
+                case json_errc::duplicate_key:
+                    return "Duplicate key";
                 default:
                     return "Unknown JSON parser error";
                 }
@@ -22,6 +22,7 @@
 #include <unordered_set>
 #include <type_traits> // std::enable_if
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp> // jsoncons::duplicate_key_policy
 #include <jsoncons/allocator_holder.hpp>
 #include <jsoncons/json_array.hpp>
 
@@ -551,26 +552,51 @@ namespace jsoncons {
         }
 
         void uninitialized_init(index_key_value<Json>* items, std::size_t count)
+        {
+            uninitialized_init(items, count, duplicate_key_policy::first_wins, false);
+        }
+
+        // If ascending, the names of items are known to be strictly ascending, 
+        // hence unique, and are neither sorted nor checked for duplicates.
+        // Returns false if a name is duplicated and policy is duplicate_key_policy::error.
+        bool uninitialized_init(index_key_value<Json>* items, std::size_t count, 
+                                duplicate_key_policy policy, bool ascending)
         {
             auto first = items;
-            if (count > 0)
+            auto last = first + count;
+            if (count == 0)
             {
-                members_.reserve(count);
-
-                auto last = first + count;
+                return true;
+            }
+            members_.reserve(count);
+            if (ascending)
+            {
+                for (auto it = first; it != last; ++it)
+                {
+                    members_.emplace_back(std::move(it->name), std::move(it->value));
+                }
+                return true;
+            }
 
-                std::sort(first, last, compare);
-                members_.emplace_back(first->name, std::move(first->value));
-                auto prev_it = first;
-                for (auto it = first+1; it != last; ++it)
+            std::sort(first, last, compare);
+            members_.emplace_back(std::move(first->name), std::move(first->value));
+            for (auto it = first+1; it != last; ++it)
+            {
+                if (it->name != members_.back().key())
                 {
-                    if (it->name != prev_it->name)
-                    {
-                        members_.emplace_back(it->name, std::move(it->value));
-                    }
-                    ++prev_it;
+                    members_.emplace_back(std::move(it->name), std::move(it->value));
+                }
+                else if (policy == duplicate_key_policy::last_wins)
+                {
+                    members_.back().value(std::move(it->value));
+                }
+                else if (policy == duplicate_key_policy::error)
+                {
+                    members_.clear();
+                    return false;
                 }
             }
+            return true;
         }
 
         template<class InputIt>
@@ -1344,36 +1370,90 @@ namespace jsoncons {
 
         void uninitialized_init(index_key_value<Json>* items, std::size_t length)
         {
-            if (length > 0)
-            {
-                auto first = items;
-                auto last = first + length;
+            uninitialized_init(items, length, duplicate_key_policy::first_wins, false);
+        }
 
-                std::sort(first, last, compare1);
+        // If ascending, the names of items are known to be strictly ascending, 
+        // hence unique, and are not checked for duplicates. Otherwise up to 
+        // linear_search_threshold members are checked against the members already 
+        // added, and larger objects through a sorted index.
+        // Returns false if a name is duplicated and policy is duplicate_key_policy::error.
+        bool uninitialized_init(index_key_value<Json>* items, std::size_t length, 
+                                duplicate_key_policy policy, bool ascending)
+        {
+            static constexpr std::size_t linear_search_threshold = 16;
 
-                std::size_t count = 1;
-                for (std::size_t i = 1; i < length; ++i)
+            if (length == 0)
+            {
+                return true;
+            }
+            auto first = items;
+            auto last = first + length;
+            members_.reserve(length);
+
+            if (ascending)
+            {
+                for (auto it = first; it != last; ++it)
+                {
+                    members_.emplace_back(std::move(it->name), std::move(it->value));
+                }
+                return true;
+            }
+            if (length <= linear_search_threshold)
+            {
+                for (auto it = first; it != last; ++it)
                 {
-                    while (i < length && items[i-1].name == items[i].name)
+                    auto dup = std::find_if(members_.begin(), members_.end(),
+                                            [&](const key_value_type& kv){return kv.key() == it->name;});
+                    if (dup == members_.end())
                     {
-                        ++i;
+                        members_.emplace_back(std::move(it->name), std::move(it->value));
                     }
-                    if (i < length)
+                    else if (policy == duplicate_key_policy::last_wins)
                     {
-                        items[count] = items[i];
-                        ++count;
+                        dup->value(std::move(it->value));
+                    }
+                    else if (policy == duplicate_key_policy::error)
+                    {
+                        members_.clear();
+                        return false;
                     }
                 }
+                return true;
+            }
 
-                last = first+count;
-                std::sort(first, last, compare2);
+            std::sort(first, last, compare1);
 
-                members_.reserve(count);
-                for (auto it = first; it != last; ++it)
+            // Keep the first item of each run of equal names, with the value of the last item if last_wins
+            std::size_t count = 1;
+            for (std::size_t i = 1; i < length; ++i)
+            {
+                if (items[i].name != items[count-1].name)
                 {
-                    members_.emplace_back(std::move(it->name), std::move(it->value));
+                    if (count != i)
+                    {
+                        items[count] = std::move(items[i]);
+                    }
+                    ++count;
+                }
+                else if (policy == duplicate_key_policy::last_wins)
+                {
+                    items[count-1].value = std::move(items[i].value);
                 }
+                else if (policy == duplicate_key_policy::error)
+                {
+                    return false;
+                }
+            }
+
+            last = first+count;
+            std::sort(first, last, compare2);
+
+            for (auto it = first; it != last; ++it)
+            {
+                members_.emplace_back(std::move(it->name), std::move(it->value));
             }
+            return true;
         }
 
         template<class InputIt>
@@ -46,6 +46,9 @@ enum class byte_string_chars_format : uint8_t {none=0,base16,base64,base64url};
 
 enum class spaces_option : uint8_t {no_spaces=0,space_after,space_before,space_before_and_after};
 
+// What to do when an object being decoded has a key more than once
+enum class duplicate_key_policy : uint8_t {first_wins=0,last_wins,error};
+
 
 struct default_json_parsing
 {
@@ -361,17 +364,19 @@ public:
     using typename super_type::string_type;
 private:
     bool lossless_number_;
+    duplicate_key_policy duplicate_keys_;
     std::function<bool(json_errc,const ser_context&)> err_handler_;
 public:
     basic_json_decode_options()
-        : lossless_number_(false), err_handler_(default_json_parsing())
+        : lossless_number_(false), duplicate_keys_(duplicate_key_policy::first_wins), err_handler_(default_json_parsing())
     {
     }
 
     basic_json_decode_options(const basic_json_decode_options&) = default;
 
     basic_json_decode_options(basic_json_decode_options&& other)
-        : super_type(std::move(other)), lossless_number_(other.lossless_number_), err_handler_(std::move(other.err_handler_))
+        : super_type(std::move(other)), lossless_number_(other.lossless_number_), duplicate_keys_(other.duplicate_keys_), 
+          err_handler_(std::move(other.err_handler_))
     {
     }
 
@@ -382,6 +387,11 @@ public:
         return lossless_number_;
     }
 
+    duplicate_key_policy duplicate_keys() const 
+    {
+        return duplicate_keys_;
+    }
+
     const std::function<bool(json_errc,const ser_context&)>& err_handler() const 
     {
         return err_handler_;
@@ -585,6 +595,7 @@ public:
     using basic_json_decode_options<CharT>::neginf_to_num;
 
     using basic_json_decode_options<CharT>::lossless_number;
+    using basic_json_decode_options<CharT>::duplicate_keys;
     using basic_json_decode_options<CharT>::err_handler;
 
     using basic_json_encode_options<CharT>::byte_string_format;
@@ -767,6 +778,12 @@ public:
         return *this;
     }
 
+    basic_json_options& duplicate_keys(duplicate_key_policy value) 
+    {
+        this->duplicate_keys_ = value;
+        return *this;
+    }
+
     basic_json_options& err_handler(const std::function<bool(json_errc,const ser_context&)>& value) 
     {
         this->err_handler_ = value;
@@ -0,0 +1,78 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_PARSE_CONTEXT_HPP
+#define JSONCONS_JSON_PARSE_CONTEXT_HPP
+
+#include <memory> // std::allocator
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+
+namespace jsoncons {
+
+    // Holds a parser and decoder for parsing many documents one after another. They are reset
+    // rather than reconstructed between documents, so their buffers and stacks keep the capacity
+    // they have grown to. A context is not thread safe, but may be declared thread_local.
+
+    template <class Json,class TempAllocator=std::allocator<char>>
+    class json_parse_context
+    {
+    public:
+        using value_type = Json;
+        using char_type = typename Json::char_type;
+        using allocator_type = typename Json::allocator_type;
+        using temp_allocator_type = TempAllocator;
+        using parser_type = basic_json_parser<char_type,TempAllocator>;
+        using decoder_type = json_decoder<Json,TempAllocator>;
+    private:
+        decoder_type decoder_;
+        parser_type parser_;
+
+        // Noncopyable and nonmoveable
+        json_parse_context(const json_parse_context&) = delete;
+        json_parse_context& operator=(const json_parse_context&) = delete;
+    public:
+        explicit json_parse_context(const TempAllocator& temp_alloc = TempAllocator())
+            : json_parse_context(basic_json_decode_options<char_type>(), allocator_type(), temp_alloc)
+        {
+        }
+
+        json_parse_context(const basic_json_decode_options<char_type>& options,
+                           const TempAllocator& temp_alloc = TempAllocator())
+            : json_parse_context(options, allocator_type(), temp_alloc)
+        {
+        }
+
+        json_parse_context(const basic_json_decode_options<char_type>& options,
+                           const allocator_type& alloc,
+                           const TempAllocator& temp_alloc = TempAllocator())
+            : decoder_(options.duplicate_keys(), alloc, temp_alloc),
+              parser_(options, options.err_handler(), temp_alloc)
+        {
+        }
+
+        // Discards any state left from a previous document, keeping allocated capacity
+        void reset()
+        {
+            parser_.reinitialize();
+            decoder_.reset();
+        }
+
+        parser_type& parser()
+        {
+            return parser_;
+        }
+
+        decoder_type& decoder()
+        {
+            return decoder_;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
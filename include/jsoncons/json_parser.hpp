@@ -129,6 +129,7 @@ private:
 
     std::basic_string<char_type,std::char_traits<char_type>,char_allocator_type> string_buffer_;
     jsoncons::detail::chars_to to_double_;
+    jsoncons::detail::decimal_accumulator number_;
 
     std::vector<json_parse_state,parse_state_allocator_type> state_stack_;
     std::vector<std::pair<std::basic_string<char_type>,double>> string_double_map_;
@@ -682,6 +683,7 @@ public:
                             case '-':
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
+                                number_.reset();
                                 saved_position_ = position_;
                                 ++input_ptr_;
                                 ++position_;
@@ -692,6 +694,8 @@ public:
                             case '0': 
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                number_.reset();
+                                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                                 state_ = json_parse_state::zero;
                                 saved_position_ = position_;
                                 ++input_ptr_;
@@ -702,6 +706,8 @@ public:
                             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                number_.reset();
+                                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                                 saved_position_ = position_;
                                 ++input_ptr_;
                                 ++position_;
@@ -1091,6 +1097,7 @@ public:
                             case '-':
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
+                                number_.reset();
                                 saved_position_ = position_;
                                 ++input_ptr_;
                                 ++position_;
@@ -1101,6 +1108,8 @@ public:
                             case '0': 
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                number_.reset();
+                                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                                 saved_position_ = position_;
                                 ++input_ptr_;
                                 ++position_;
@@ -1111,6 +1120,8 @@ public:
                             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                number_.reset();
+                                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                                 saved_position_ = position_;
                                 ++input_ptr_;
                                 ++position_;
@@ -1246,6 +1257,7 @@ public:
                             case '-':
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
+                                number_.reset();
                                 saved_position_ = position_;
                                 ++input_ptr_;
                                 ++position_;
@@ -1256,6 +1268,8 @@ public:
                             case '0': 
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                number_.reset();
+                                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                                 saved_position_ = position_;
                                 ++input_ptr_;
                                 ++position_;
@@ -1266,6 +1280,8 @@ public:
                             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                                number_.reset();
+                                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                                 saved_position_ = position_;
                                 ++input_ptr_;
                                 ++position_;
@@ -1747,11 +1763,13 @@ minus_sign:
         {
             case '0': 
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                 ++input_ptr_;
                 ++position_;
                 goto zero;
             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                 ++input_ptr_;
                 ++position_;
                 goto integer;
@@ -1880,6 +1898,7 @@ integer:
                 return;
             case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.integer_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                 ++input_ptr_;
                 ++position_;
                 goto integer;
@@ -1918,6 +1937,7 @@ fraction1:
         {
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.fraction_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                 ++input_ptr_;
                 ++position_;
                 goto fraction2;
@@ -1985,6 +2005,7 @@ fraction2:
                 return;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.fraction_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                 ++input_ptr_;
                 ++position_;
                 goto fraction2;
@@ -2014,11 +2035,13 @@ exp1:
                 goto exp2;
             case '-':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.exponent_sign(true);
                 ++input_ptr_;
                 ++position_;
                 goto exp2;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.exponent_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                 ++input_ptr_;
                 ++position_;
                 goto exp3;
@@ -2039,6 +2062,7 @@ exp2:
         {
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.exponent_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                 ++input_ptr_;
                 ++position_;
                 goto exp3;
@@ -2107,6 +2131,7 @@ exp3:
                 return;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                number_.exponent_digit(static_cast<unsigned>(*input_ptr_ - '0'));
                 ++input_ptr_;
                 ++position_;
                 goto exp3;
@@ -2652,6 +2677,14 @@ private:
     void end_negative_value(basic_json_visitor<char_type>& visitor, std::error_code& ec)
     {
         int64_t val;
+        // Up to 19 digits were accumulated while parsing, no second pass needed
+        if (number_.is_uint64() && number_.mantissa() <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+        {
+            val = -static_cast<int64_t>(number_.mantissa());
+            more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
+            after_value(ec);
+            return;
+        }
         auto result = jsoncons::detail::to_integer_unchecked(string_buffer_.data(), string_buffer_.length(), val);
         if (result)
         {
@@ -2666,6 +2699,12 @@ private:
 
     void end_positive_value(basic_json_visitor<char_type>& visitor, std::error_code& ec)
     {
+        if (number_.is_uint64())
+        {
+            more_ = visitor.uint64_value(number_.mantissa(), semantic_tag::none, *this, ec);
+            after_value(ec);
+            return;
+        }
         uint64_t val;
         auto result = jsoncons::detail::to_integer_unchecked(string_buffer_.data(), string_buffer_.length(), val);
         if (result)
@@ -2689,7 +2728,13 @@ private:
             }
             else
             {
-                double d = to_double_(string_buffer_.c_str(), string_buffer_.length());
+                // The digits were accumulated while parsing, the text is only
+                // converted again when the first 19 digits don't decide the value
+                double d;
+                if (!number_.to_double(string_buffer_[0] == '-', d))
+                {
+                    d = to_double_(string_buffer_.c_str(), string_buffer_.length());
+                }
                 more_ = visitor.double_value(d, semantic_tag::none, *this, ec);
             }
         }
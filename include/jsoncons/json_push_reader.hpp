@@ -0,0 +1,190 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_PUSH_READER_HPP
+#define JSONCONS_JSON_PUSH_READER_HPP
+
+#include <memory> // std::allocator
+#include <functional> // std::function
+#include <system_error>
+#include <utility> // std::move
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+
+namespace jsoncons {
+
+    // Parses JSON text supplied in chunks of any size, and passes each completed value to a handler.
+    // The text may hold any number of concatenated values. Only a token that is split between chunks
+    // is buffered, so a chunk need not outlive the call to update that supplies it.
+
+    template <class Json,class TempAllocator=std::allocator<char>>
+    class json_push_reader
+    {
+    public:
+        using value_type = Json;
+        using char_type = typename Json::char_type;
+        using allocator_type = typename Json::allocator_type;
+        using string_view_type = typename Json::string_view_type;
+        using handler_type = std::function<void(Json&&)>;
+    private:
+        handler_type handler_;
+        json_decoder<Json,TempAllocator> decoder_;
+        basic_json_parser<char_type,TempAllocator> parser_;
+        std::size_t value_count_;
+
+        // Noncopyable and nonmoveable
+        json_push_reader(const json_push_reader&) = delete;
+        json_push_reader& operator=(const json_push_reader&) = delete;
+
+    public:
+        explicit json_push_reader(handler_type handler,
+                                  const TempAllocator& temp_alloc = TempAllocator())
+            : json_push_reader(std::move(handler),
+                               basic_json_decode_options<char_type>(),
+                               allocator_type(),
+                               temp_alloc)
+        {
+        }
+
+        json_push_reader(handler_type handler,
+                         const basic_json_decode_options<char_type>& options,
+                         const TempAllocator& temp_alloc = TempAllocator())
+            : json_push_reader(std::move(handler),
+                               options,
+                               allocator_type(),
+                               temp_alloc)
+        {
+        }
+
+        json_push_reader(handler_type handler,
+                         const basic_json_decode_options<char_type>& options,
+                         const allocator_type& alloc,
+                         const TempAllocator& temp_alloc = TempAllocator())
+            : handler_(std::move(handler)),
+              decoder_(options.duplicate_keys(), alloc, temp_alloc),
+              parser_(options, options.err_handler(), temp_alloc),
+              value_count_(0)
+        {
+        }
+
+        // Parses a chunk of text, passing any values it completes to the handler
+
+        void update(const string_view_type& sv)
+        {
+            update(sv.data(), sv.size());
+        }
+
+        void update(const string_view_type& sv, std::error_code& ec)
+        {
+            update(sv.data(), sv.size(), ec);
+        }
+
+        void update(const char_type* data, std::size_t length)
+        {
+            std::error_code ec;
+            update(data, length, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+            }
+        }
+
+        void update(const char_type* data, std::size_t length, std::error_code& ec)
+        {
+            parser_.update(data, length);
+            // A value is complete when the parser reaches the accept state, which the decoder marks
+            // by pausing the parser, and the next parse_some passes it on. With the chunk exhausted,
+            // parse_some is not called again unless a value is waiting, since a number at the end
+            // of the chunk may continue.
+            while (parser_.state() == json_parse_state::accept || (!parser_.stopped() && !parser_.source_exhausted()))
+            {
+                parser_.parse_some(decoder_, ec);
+                if (ec)
+                {
+                    return;
+                }
+                if (parser_.done())
+                {
+                    end_value();
+                }
+            }
+        }
+
+        // Marks the end of the text, completing a number at the end of the last chunk, or setting
+        // json_errc::unexpected_eof if a value is incomplete
+
+        void finish()
+        {
+            std::error_code ec;
+            finish(ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+            }
+        }
+
+        void finish(std::error_code& ec)
+        {
+            parser_.update(nullptr, 0);
+            parser_.finish_parse(decoder_, ec);
+            if (ec)
+            {
+                return;
+            }
+            if (parser_.done())
+            {
+                end_value();
+            }
+            parser_.reset();
+        }
+
+        // True if part of a value has been read
+        bool in_value() const
+        {
+            return !parser_.enter();
+        }
+
+        // The number of values passed to the handler
+        std::size_t value_count() const
+        {
+            return value_count_;
+        }
+
+        // Discards a partly read value, so that reading may start again. After an error, 
+        // update ignores further text until reset is called.
+        void reset()
+        {
+            parser_.reinitialize();
+            decoder_.reset();
+        }
+
+        // The line and column in the current value
+        std::size_t line() const
+        {
+            return parser_.line();
+        }
+
+        std::size_t column() const
+        {
+            return parser_.column();
+        }
+    private:
+        void end_value()
+        {
+            parser_.reset();
+            if (decoder_.is_valid())
+            {
+                ++value_count_;
+                handler_(decoder_.get_result());
+            }
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
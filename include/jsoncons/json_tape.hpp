@@ -0,0 +1,1016 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_TAPE_HPP
+#define JSONCONS_JSON_TAPE_HPP
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <iterator> // std::forward_iterator_tag
+#include <memory> // std::allocator
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/basic_json.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    // One node of a tape. The header holds the kind (a json_type, or tape_key_kind for a
+    // member name) in bits 0-7, the semantic tag in bits 8-15, and a size in bits 16-63:
+    // the length of a string, or the number of elements or members of an array or object.
+    // The value holds the bits of a scalar, the offset of a string in the character or byte
+    // buffer, or, for an array or object, the index of the entry after its last descendant.
+
+    struct tape_entry
+    {
+        uint64_t header;
+        uint64_t value;
+
+        tape_entry(uint8_t kind, semantic_tag tag, uint64_t size, uint64_t val) noexcept
+            : header(static_cast<uint64_t>(kind) | (static_cast<uint64_t>(tag) << 8) | (size << 16)), value(val)
+        {
+        }
+
+        uint8_t kind() const noexcept
+        {
+            return static_cast<uint8_t>(header & 0xff);
+        }
+
+        semantic_tag tag() const noexcept
+        {
+            return static_cast<semantic_tag>((header >> 8) & 0xff);
+        }
+
+        std::size_t size() const noexcept
+        {
+            return static_cast<std::size_t>(header >> 16);
+        }
+
+        void size(uint64_t n) noexcept
+        {
+            header = (header & 0xffff) | (n << 16);
+        }
+    };
+
+    constexpr uint8_t tape_key_kind = 0xff;
+
+    template <class CharT>
+    struct tape_view
+    {
+        const tape_entry* entries;
+        const CharT* chars;
+        const uint8_t* bytes;
+    };
+
+    // The index of the entry after the value at index i
+    inline
+    std::size_t tape_next(const tape_entry* entries, std::size_t i) noexcept
+    {
+        const tape_entry& e = entries[i];
+        return e.kind() == static_cast<uint8_t>(json_type::array_value) || e.kind() == static_cast<uint8_t>(json_type::object_value)
+            ? static_cast<std::size_t>(e.value) : i + 1;
+    }
+
+} // namespace detail
+
+    template <class CharT>
+    class basic_json_tape_ref;
+
+    template <class CharT,class Allocator>
+    class basic_json_tape_decoder;
+
+    // basic_json_tape_member
+
+    template <class CharT>
+    class basic_json_tape_member
+    {
+    public:
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using value_type = basic_json_tape_ref<CharT>;
+    private:
+        detail::tape_view<CharT> tape_;
+        std::size_t index_; // the key entry
+    public:
+        basic_json_tape_member(const detail::tape_view<CharT>& tape, std::size_t index) noexcept
+            : tape_(tape), index_(index)
+        {
+        }
+
+        string_view_type key() const noexcept
+        {
+            const detail::tape_entry& e = tape_.entries[index_];
+            return string_view_type(tape_.chars + e.value, e.size());
+        }
+
+        value_type value() const noexcept
+        {
+            return value_type(tape_, index_ + 1);
+        }
+    };
+
+namespace detail {
+
+    template <class T>
+    class tape_arrow_proxy
+    {
+        T value_;
+    public:
+        explicit tape_arrow_proxy(const T& value)
+            : value_(value)
+        {
+        }
+
+        const T* operator->() const noexcept
+        {
+            return &value_;
+        }
+    };
+
+    // Iterates over the elements of an array or the members of an object.
+    // Step is 0 for elements and 1 for members, which are preceded by their key entry.
+
+    template <class CharT,class ValueT,std::size_t Step>
+    class tape_iterator
+    {
+        tape_view<CharT> tape_;
+        std::size_t index_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ValueT;
+        using difference_type = std::ptrdiff_t;
+        using pointer = tape_arrow_proxy<ValueT>;
+        using reference = ValueT;
+
+        tape_iterator() noexcept
+            : tape_{nullptr,nullptr,nullptr}, index_(0)
+        {
+        }
+
+        tape_iterator(const tape_view<CharT>& tape, std::size_t index) noexcept
+            : tape_(tape), index_(index)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return ValueT(tape_, index_);
+        }
+
+        pointer operator->() const noexcept
+        {
+            return pointer(ValueT(tape_, index_));
+        }
+
+        tape_iterator& operator++() noexcept
+        {
+            index_ = tape_next(tape_.entries, index_ + Step);
+            return *this;
+        }
+
+        tape_iterator operator++(int) noexcept
+        {
+            tape_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        friend bool operator==(const tape_iterator& lhs, const tape_iterator& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const tape_iterator& lhs, const tape_iterator& rhs) noexcept
+        {
+            return lhs.index_ != rhs.index_;
+        }
+    };
+
+} // namespace detail
+
+    // basic_json_tape_ref
+
+    // A reference to a value in a basic_json_tape, with the const navigation
+    // and conversion functions of basic_json. It remains valid as long as the
+    // tape it refers to is not destroyed, moved or assigned.
+
+    template <class CharT>
+    class basic_json_tape_ref
+    {
+    public:
+        using char_type = CharT;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using member_type = basic_json_tape_member<CharT>;
+        using const_array_iterator = detail::tape_iterator<CharT,basic_json_tape_ref,0>;
+        using const_object_iterator = detail::tape_iterator<CharT,member_type,1>;
+        using array_iterator = const_array_iterator;
+        using object_iterator = const_object_iterator;
+    private:
+        detail::tape_view<CharT> tape_;
+        std::size_t index_;
+
+        const detail::tape_entry& entry() const noexcept
+        {
+            return tape_.entries[index_];
+        }
+
+        uint8_t kind() const noexcept
+        {
+            return entry().kind();
+        }
+
+        bool has_kind(json_type type) const noexcept
+        {
+            return kind() == static_cast<uint8_t>(type);
+        }
+
+        std::size_t end_index() const noexcept
+        {
+            return detail::tape_next(tape_.entries, index_);
+        }
+
+        // Converts through basic_json for types without a direct conversion
+        template <class T>
+        T as_through_json() const
+        {
+            return to_json<basic_json<CharT>>().template as<T>();
+        }
+    public:
+        basic_json_tape_ref(const detail::tape_view<CharT>& tape, std::size_t index) noexcept
+            : tape_(tape), index_(index)
+        {
+        }
+
+        json_type type() const noexcept
+        {
+            return static_cast<json_type>(kind());
+        }
+
+        semantic_tag tag() const noexcept
+        {
+            return entry().tag();
+        }
+
+        uint64_t ext_tag() const noexcept
+        {
+            if (!(has_kind(json_type::byte_string_value) && tag() == semantic_tag::ext))
+            {
+                return 0;
+            }
+            uint64_t val;
+            std::memcpy(&val, tape_.bytes + entry().value, sizeof(uint64_t));
+            return val;
+        }
+
+        bool is_null() const noexcept
+        {
+            return has_kind(json_type::null_value);
+        }
+
+        bool is_bool() const noexcept
+        {
+            return has_kind(json_type::bool_value);
+        }
+
+        bool is_int64() const noexcept
+        {
+            return has_kind(json_type::int64_value);
+        }
+
+        bool is_uint64() const noexcept
+        {
+            return has_kind(json_type::uint64_value);
+        }
+
+        bool is_half() const noexcept
+        {
+            return has_kind(json_type::half_value);
+        }
+
+        bool is_double() const noexcept
+        {
+            return has_kind(json_type::double_value);
+        }
+
+        bool is_number() const noexcept
+        {
+            switch (type())
+            {
+                case json_type::int64_value:
+                case json_type::uint64_value:
+                case json_type::half_value:
+                case json_type::double_value:
+                    return true;
+                case json_type::string_value:
+                    return tag() == semantic_tag::bigint || tag() == semantic_tag::bigdec || tag() == semantic_tag::bigfloat;
+                default:
+                    return false;
+            }
+        }
+
+        bool is_string() const noexcept
+        {
+            return has_kind(json_type::string_value);
+        }
+
+        bool is_byte_string() const noexcept
+        {
+            return has_kind(json_type::byte_string_value);
+        }
+
+        bool is_array() const noexcept
+        {
+            return has_kind(json_type::array_value);
+        }
+
+        bool is_object() const noexcept
+        {
+            return has_kind(json_type::object_value);
+        }
+
+        // Returns the number of elements of an array or members of an object, otherwise 0
+        std::size_t size() const noexcept
+        {
+            return is_array() || is_object() ? entry().size() : 0;
+        }
+
+        bool empty() const noexcept
+        {
+            switch (type())
+            {
+                case json_type::string_value:
+                case json_type::array_value:
+                case json_type::object_value:
+                    return entry().size() == 0;
+                case json_type::byte_string_value:
+                    return as_byte_string_view().size() == 0;
+                default:
+                    return false;
+            }
+        }
+
+        template <class T>
+        bool is() const
+        {
+            return to_json<basic_json<CharT>>().template is<T>();
+        }
+
+        string_view_type as_string_view() const
+        {
+            if (!is_string())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+            }
+            return string_view_type(tape_.chars + entry().value, entry().size());
+        }
+
+        byte_string_view as_byte_string_view() const
+        {
+            if (!is_byte_string())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
+            }
+            std::size_t offset = tag() == semantic_tag::ext ? sizeof(uint64_t) : 0;
+            return byte_string_view(tape_.bytes + entry().value + offset, entry().size());
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            return is_bool() ? entry().value != 0 : as_through_json<T>();
+        }
+
+        template <class T>
+        typename std::enable_if<extension_traits::is_integer<T>::value && !std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            switch (type())
+            {
+                case json_type::int64_value:
+                    return static_cast<T>(static_cast<int64_t>(entry().value));
+                case json_type::uint64_value:
+                    return static_cast<T>(entry().value);
+                default:
+                    return as_through_json<T>();
+            }
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value,T>::type
+        as() const
+        {
+            switch (type())
+            {
+                case json_type::int64_value:
+                    return static_cast<T>(static_cast<int64_t>(entry().value));
+                case json_type::uint64_value:
+                    return static_cast<T>(entry().value);
+                case json_type::half_value:
+                    return static_cast<T>(binary::decode_half(static_cast<uint16_t>(entry().value)));
+                case json_type::double_value:
+                {
+                    double val;
+                    std::memcpy(&val, &entry().value, sizeof(double));
+                    return static_cast<T>(val);
+                }
+                default:
+                    return as_through_json<T>();
+            }
+        }
+
+        template <class T>
+        typename std::enable_if<extension_traits::is_string<T>::value && std::is_same<typename T::value_type,CharT>::value,T>::type
+        as() const
+        {
+            return is_string() ? T(tape_.chars + entry().value, entry().size()) : as_through_json<T>();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,string_view_type>::value,T>::type
+        as() const
+        {
+            return as_string_view();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,byte_string_view>::value,T>::type
+        as() const
+        {
+            return as_byte_string_view();
+        }
+
+        template <class T>
+        typename std::enable_if<!std::is_same<T,bool>::value && !extension_traits::is_integer<T>::value &&
+                                !std::is_floating_point<T>::value &&
+                                !(extension_traits::is_string<T>::value && std::is_same<typename T::value_type,CharT>::value) &&
+                                !std::is_same<T,string_view_type>::value && !std::is_same<T,byte_string_view>::value,T>::type
+        as() const
+        {
+            return as_through_json<T>();
+        }
+
+        // Array access, linear in i unless every element is a scalar
+        basic_json_tape_ref at(std::size_t i) const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+            }
+            if (i >= entry().size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            if (end_index() - index_ - 1 == entry().size())
+            {
+                return basic_json_tape_ref(tape_, index_ + 1 + i);
+            }
+            std::size_t pos = index_ + 1;
+            for (std::size_t k = 0; k < i; ++k)
+            {
+                pos = detail::tape_next(tape_.entries, pos);
+            }
+            return basic_json_tape_ref(tape_, pos);
+        }
+
+        basic_json_tape_ref operator[](std::size_t i) const
+        {
+            return at(i);
+        }
+
+        // Member lookup, linear in the number of members
+        const_object_iterator find(const string_view_type& name) const noexcept
+        {
+            if (!is_object())
+            {
+                return const_object_iterator();
+            }
+            const std::size_t last = end_index();
+            std::size_t pos = index_ + 1;
+            while (pos < last)
+            {
+                const detail::tape_entry& e = tape_.entries[pos];
+                if (e.size() == name.size() && std::char_traits<CharT>::compare(tape_.chars + e.value, name.data(), name.size()) == 0)
+                {
+                    return const_object_iterator(tape_, pos);
+                }
+                pos = detail::tape_next(tape_.entries, pos + 1);
+            }
+            return const_object_iterator(tape_, last);
+        }
+
+        bool contains(const string_view_type& name) const noexcept
+        {
+            return is_object() && find(name) != const_object_iterator(tape_, end_index());
+        }
+
+        basic_json_tape_ref at(const string_view_type& name) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(name.data(),name.length()));
+            }
+            auto it = find(name);
+            if (it == const_object_iterator(tape_, end_index()))
+            {
+                JSONCONS_THROW(key_not_found(name.data(),name.length()));
+            }
+            return it->value();
+        }
+
+        basic_json_tape_ref operator[](const string_view_type& name) const
+        {
+            return at(name);
+        }
+
+        template <class T>
+        T get_value_or(const string_view_type& name, T&& default_value) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(name.data(),name.length()));
+            }
+            auto it = find(name);
+            return it != const_object_iterator(tape_, end_index()) ? it->value().template as<T>() : static_cast<T>(std::forward<T>(default_value));
+        }
+
+        range<const_array_iterator,const_array_iterator> array_range() const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+            return range<const_array_iterator,const_array_iterator>(const_array_iterator(tape_, index_ + 1),
+                                                                    const_array_iterator(tape_, end_index()));
+        }
+
+        range<const_object_iterator,const_object_iterator> object_range() const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+            return range<const_object_iterator,const_object_iterator>(const_object_iterator(tape_, index_ + 1),
+                                                                      const_object_iterator(tape_, end_index()));
+        }
+
+        // Sends this value to a visitor, as a sequence of events
+
+        void dump(basic_json_visitor<CharT>& visitor, std::error_code& ec) const
+        {
+            dump_noflush(visitor, ec);
+            if (!ec)
+            {
+                visitor.flush();
+            }
+        }
+
+        void dump(basic_json_visitor<CharT>& visitor) const
+        {
+            std::error_code ec;
+            dump(visitor, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        template <class CharContainer>
+        typename std::enable_if<extension_traits::is_back_insertable_char_container<CharContainer>::value>::type
+        dump(CharContainer& cont, const basic_json_encode_options<CharT>& options = basic_json_encode_options<CharT>()) const
+        {
+            basic_compact_json_encoder<CharT,jsoncons::string_sink<CharContainer>> encoder(cont, options);
+            dump(encoder);
+        }
+
+        void dump(std::basic_ostream<CharT>& os, const basic_json_encode_options<CharT>& options = basic_json_encode_options<CharT>()) const
+        {
+            basic_compact_json_encoder<CharT,jsoncons::stream_sink<CharT>> encoder(os, options);
+            dump(encoder);
+        }
+
+        std::basic_string<CharT> to_string() const
+        {
+            std::basic_string<CharT> s;
+            dump(s);
+            return s;
+        }
+
+        template <class Json>
+        Json to_json() const
+        {
+            json_decoder<Json> decoder;
+            dump(decoder);
+            return decoder.get_result();
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_json_tape_ref& ref)
+        {
+            ref.dump(os);
+            return os;
+        }
+
+    private:
+        void dump_noflush(basic_json_visitor<CharT>& visitor, std::error_code& ec) const
+        {
+            const ser_context context{};
+            struct open_container
+            {
+                std::size_t end;
+                bool is_object;
+            };
+            std::vector<open_container> stack;
+
+            const std::size_t last = end_index();
+            std::size_t i = index_;
+            while (!ec && (i < last || !stack.empty()))
+            {
+                if (!stack.empty() && stack.back().end == i)
+                {
+                    if (stack.back().is_object)
+                    {
+                        visitor.end_object(context, ec);
+                    }
+                    else
+                    {
+                        visitor.end_array(context, ec);
+                    }
+                    stack.pop_back();
+                    continue;
+                }
+                const detail::tape_entry& e = tape_.entries[i];
+                switch (e.kind())
+                {
+                    case detail::tape_key_kind:
+                        visitor.key(string_view_type(tape_.chars + e.value, e.size()), context, ec);
+                        break;
+                    case static_cast<uint8_t>(json_type::null_value):
+                        visitor.null_value(e.tag(), context, ec);
+                        break;
+                    case static_cast<uint8_t>(json_type::bool_value):
+                        visitor.bool_value(e.value != 0, e.tag(), context, ec);
+                        break;
+                    case static_cast<uint8_t>(json_type::int64_value):
+                        visitor.int64_value(static_cast<int64_t>(e.value), e.tag(), context, ec);
+                        break;
+                    case static_cast<uint8_t>(json_type::uint64_value):
+                        visitor.uint64_value(e.value, e.tag(), context, ec);
+                        break;
+                    case static_cast<uint8_t>(json_type::half_value):
+                        visitor.half_value(static_cast<uint16_t>(e.value), e.tag(), context, ec);
+                        break;
+                    case static_cast<uint8_t>(json_type::double_value):
+                    {
+                        double val;
+                        std::memcpy(&val, &e.value, sizeof(double));
+                        visitor.double_value(val, e.tag(), context, ec);
+                        break;
+                    }
+                    case static_cast<uint8_t>(json_type::string_value):
+                        visitor.string_value(string_view_type(tape_.chars + e.value, e.size()), e.tag(), context, ec);
+                        break;
+                    case static_cast<uint8_t>(json_type::byte_string_value):
+                    {
+                        basic_json_tape_ref ref(tape_, i);
+                        if (e.tag() == semantic_tag::ext)
+                        {
+                            visitor.byte_string_value(ref.as_byte_string_view(), ref.ext_tag(), context, ec);
+                        }
+                        else
+                        {
+                            visitor.byte_string_value(ref.as_byte_string_view(), e.tag(), context, ec);
+                        }
+                        break;
+                    }
+                    case static_cast<uint8_t>(json_type::array_value):
+                        visitor.begin_array(e.size(), e.tag(), context, ec);
+                        stack.push_back(open_container{static_cast<std::size_t>(e.value), false});
+                        break;
+                    case static_cast<uint8_t>(json_type::object_value):
+                        visitor.begin_object(e.size(), e.tag(), context, ec);
+                        stack.push_back(open_container{static_cast<std::size_t>(e.value), true});
+                        break;
+                    default:
+                        break;
+                }
+                ++i;
+            }
+        }
+    };
+
+    // basic_json_tape
+
+    // A read only document that holds all of its values in a few contiguous buffers:
+    // an array of fixed size entries, in document order, with each array and object
+    // entry holding the position after its last descendant, a buffer of characters
+    // for strings and member names, and a buffer of bytes for byte strings.
+
+    template <class CharT,class Allocator = std::allocator<char>>
+    class basic_json_tape
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using const_reference = basic_json_tape_ref<CharT>;
+    private:
+        friend class basic_json_tape_decoder<CharT,Allocator>;
+
+        using entry_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<detail::tape_entry>;
+        using char_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<CharT>;
+        using byte_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<uint8_t>;
+
+        std::vector<detail::tape_entry,entry_allocator_type> entries_;
+        std::vector<CharT,char_allocator_type> chars_;
+        std::vector<uint8_t,byte_allocator_type> bytes_;
+
+        static const detail::tape_entry* null_entry() noexcept
+        {
+            static const detail::tape_entry entry(static_cast<uint8_t>(json_type::null_value), semantic_tag::none, 0, 0);
+            return &entry;
+        }
+
+        template <class Source>
+        static basic_json_tape parse_source(Source&& source, const basic_json_decode_options<CharT>& options)
+        {
+            basic_json_tape_decoder<CharT,Allocator> decoder;
+            basic_json_reader<CharT,typename std::decay<Source>::type> reader(std::forward<Source>(source), decoder, options);
+            reader.read_next();
+            reader.check_done();
+            if (!decoder.is_valid())
+            {
+                JSONCONS_THROW(ser_error(json_errc::source_error, "Failed to parse json"));
+            }
+            return decoder.get_result();
+        }
+    public:
+        explicit basic_json_tape(const Allocator& alloc = Allocator())
+            : entries_(entry_allocator_type(alloc)), chars_(char_allocator_type(alloc)), bytes_(byte_allocator_type(alloc))
+        {
+        }
+
+        basic_json_tape(const basic_json_tape&) = default;
+        basic_json_tape(basic_json_tape&&) = default;
+        basic_json_tape& operator=(const basic_json_tape&) = default;
+        basic_json_tape& operator=(basic_json_tape&&) = default;
+
+        static basic_json_tape parse(const string_view_type& s,
+            const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
+        {
+            return parse_source(string_source<CharT>(s), options);
+        }
+
+        static basic_json_tape parse(std::basic_istream<CharT>& is,
+            const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
+        {
+            return parse_source(stream_source<CharT>(is), options);
+        }
+
+        // The root value, null if the tape is empty
+        const_reference root() const noexcept
+        {
+            if (entries_.empty())
+            {
+                return const_reference(detail::tape_view<CharT>{null_entry(), chars_.data(), bytes_.data()}, 0);
+            }
+            return const_reference(detail::tape_view<CharT>{entries_.data(), chars_.data(), bytes_.data()}, 0);
+        }
+
+        bool empty() const noexcept
+        {
+            return entries_.empty();
+        }
+
+        // The number of entries on the tape, one for each value and member name
+        std::size_t entry_count() const noexcept
+        {
+            return entries_.size();
+        }
+
+        void clear() noexcept
+        {
+            entries_.clear();
+            chars_.clear();
+            bytes_.clear();
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type(entries_.get_allocator());
+        }
+    };
+
+    // basic_json_tape_decoder
+
+    // Builds a basic_json_tape from the events of any parser
+
+    template <class CharT,class Allocator = std::allocator<char>>
+    class basic_json_tape_decoder final : public basic_json_visitor<CharT>
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using typename basic_json_visitor<CharT>::string_view_type;
+        using tape_type = basic_json_tape<CharT,Allocator>;
+    private:
+        struct open_container
+        {
+            std::size_t index;
+            std::size_t count;
+        };
+        using open_container_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<open_container>;
+
+        tape_type tape_;
+        std::vector<open_container,open_container_allocator_type> stack_;
+        bool is_valid_;
+
+        // Starts a new tape for a root value
+        void begin_value()
+        {
+            if (stack_.empty())
+            {
+                tape_.clear();
+                is_valid_ = false;
+            }
+        }
+
+        // Adds a value entry, and returns false when it completes the root value
+        bool add_value(uint8_t kind, semantic_tag tag, uint64_t size, uint64_t value)
+        {
+            tape_.entries_.emplace_back(kind, tag, size, value);
+            return end_value();
+        }
+
+        bool end_value()
+        {
+            if (stack_.empty())
+            {
+                is_valid_ = true;
+                return false;
+            }
+            ++stack_.back().count;
+            return true;
+        }
+
+        bool begin_container(json_type type, semantic_tag tag)
+        {
+            begin_value();
+            stack_.push_back(open_container{tape_.entries_.size(), 0});
+            tape_.entries_.emplace_back(static_cast<uint8_t>(type), tag, 0, 0);
+            return true;
+        }
+
+        bool end_container()
+        {
+            JSONCONS_ASSERT(!stack_.empty());
+            detail::tape_entry& e = tape_.entries_[stack_.back().index];
+            e.size(stack_.back().count);
+            e.value = tape_.entries_.size();
+            stack_.pop_back();
+            return end_value();
+        }
+
+        uint64_t add_chars(const string_view_type& s)
+        {
+            uint64_t offset = tape_.chars_.size();
+            tape_.chars_.insert(tape_.chars_.end(), s.data(), s.data() + s.size());
+            return offset;
+        }
+    public:
+        basic_json_tape_decoder(const Allocator& alloc = Allocator())
+            : tape_(alloc), stack_(open_container_allocator_type(alloc)), is_valid_(false)
+        {
+        }
+
+        void reset()
+        {
+            tape_.clear();
+            stack_.clear();
+            is_valid_ = false;
+        }
+
+        bool is_valid() const
+        {
+            return is_valid_;
+        }
+
+        tape_type get_result()
+        {
+            JSONCONS_ASSERT(is_valid_);
+            is_valid_ = false;
+            tape_type result(tape_.get_allocator());
+            std::swap(result, tape_);
+            return result;
+        }
+
+    private:
+        void visit_flush() override
+        {
+        }
+
+        bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return begin_container(json_type::object_value, tag);
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            return end_container();
+        }
+
+        bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return begin_container(json_type::array_value, tag);
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            return end_container();
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            uint64_t offset = add_chars(name);
+            tape_.entries_.emplace_back(detail::tape_key_kind, semantic_tag::none, name.size(), offset);
+            return true;
+        }
+
+        bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            uint64_t offset = add_chars(sv);
+            return add_value(static_cast<uint8_t>(json_type::string_value), tag, sv.size(), offset);
+        }
+
+        bool visit_byte_string(const byte_string_view& b, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            uint64_t offset = tape_.bytes_.size();
+            tape_.bytes_.insert(tape_.bytes_.end(), b.begin(), b.end());
+            return add_value(static_cast<uint8_t>(json_type::byte_string_value), tag, b.size(), offset);
+        }
+
+        bool visit_byte_string(const byte_string_view& b, uint64_t ext_tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            uint64_t offset = tape_.bytes_.size();
+            uint8_t buf[sizeof(uint64_t)];
+            std::memcpy(buf, &ext_tag, sizeof(uint64_t));
+            tape_.bytes_.insert(tape_.bytes_.end(), buf, buf + sizeof(uint64_t));
+            tape_.bytes_.insert(tape_.bytes_.end(), b.begin(), b.end());
+            return add_value(static_cast<uint8_t>(json_type::byte_string_value), semantic_tag::ext, b.size(), offset);
+        }
+
+        bool visit_int64(int64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            return add_value(static_cast<uint8_t>(json_type::int64_value), tag, 0, static_cast<uint64_t>(value));
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            return add_value(static_cast<uint8_t>(json_type::uint64_value), tag, 0, value);
+        }
+
+        bool visit_half(uint16_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            return add_value(static_cast<uint8_t>(json_type::half_value), tag, 0, value);
+        }
+
+        bool visit_double(double value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(double));
+            return add_value(static_cast<uint8_t>(json_type::double_value), tag, 0, bits);
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            return add_value(static_cast<uint8_t>(json_type::bool_value), tag, 0, value ? 1 : 0);
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            return add_value(static_cast<uint8_t>(json_type::null_value), tag, 0, 0);
+        }
+    };
+
+    using json_tape = basic_json_tape<char>;
+    using wjson_tape = basic_json_tape<wchar_t>;
+    using json_tape_decoder = basic_json_tape_decoder<char>;
+    using wjson_tape_decoder = basic_json_tape_decoder<wchar_t>;
+
+} // namespace jsoncons
+
+#endif
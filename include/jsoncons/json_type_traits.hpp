@@ -131,6 +131,18 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
         !is_json_type_traits_unspecialized<Json,typename std::iterator_traits<typename T::iterator>::value_type>::value
     >::type> : std::true_type {};
 
+    // is_movable_container_type: an array or map like container whose elements an rvalue 
+    // conversion to or from a basic_json moves rather than copies
+
+    template<class Json, class T, class Enable=void>
+    struct is_movable_container_type : std::false_type {};
+
+    template<class Json, class T>
+    struct is_movable_container_type<Json,T, 
+        typename std::enable_if<is_compatible_array_type<Json,T>::value || extension_traits::is_std_array<T>::value || 
+        extension_traits::is_map_like<T>::value
+    >::type> : std::true_type {};
+
 } // namespace detail
 
     // is_json_type_traits_specialized
@@ -531,7 +543,7 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             bool result = j.is_array();
             if (result)
             {
-                for (auto e : j.array_range())
+                for (const auto& e : j.array_range())
                 {
                     if (!e.template is<value_type>())
                     {
@@ -566,6 +578,33 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             }
         }
 
+        // array back insertable non-byte container from an rvalue, moving the elements of j
+
+        template <class Container = T>
+        static typename std::enable_if<!extension_traits::is_byte<typename Container::value_type>::value,Container>::type
+        as(Json&& j)
+        {
+            if (j.storage_kind() == json_storage_kind::json_const_pointer) // not owned, so cannot be moved from
+            {
+                return as(static_cast<const Json&>(j));
+            }
+            if (j.is_array())
+            {
+                T result;
+                visit_reserve_(typename std::integral_constant<bool, extension_traits::has_reserve<T>::value>::type(),result,j.size());
+                for (auto& item : j.array_range())
+                {
+                    result.push_back(std::move(item).template as<value_type>());
+                }
+
+                return result;
+            }
+            else 
+            {
+                JSONCONS_THROW(conv_error(conv_errc::not_vector));
+            }
+        }
+
         // array back insertable byte container
 
         template <class Container = T>
@@ -642,6 +681,38 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             return j;
         }
 
+        template <class Container = T>
+        static typename std::enable_if<!extension_traits::is_std_byte<typename Container::value_type>::value,Json>::type
+        to_json(T&& val)
+        {
+            Json j(json_array_arg);
+            auto first = std::begin(val);
+            auto last = std::end(val);
+            std::size_t size = std::distance(first,last);
+            j.reserve(size);
+            for (auto it = first; it != last; ++it)
+            {
+                j.push_back(std::move(*it));
+            }
+            return j;
+        }
+
+        template <class Container = T>
+        static typename std::enable_if<!extension_traits::is_std_byte<typename Container::value_type>::value,Json>::type
+        to_json(T&& val, const allocator_type& alloc)
+        {
+            Json j(json_array_arg, alloc);
+            auto first = std::begin(val);
+            auto last = std::end(val);
+            std::size_t size = std::distance(first, last);
+            j.reserve(size);
+            for (auto it = first; it != last; ++it)
+            {
+                j.push_back(std::move(*it));
+            }
+            return j;
+        }
+
         template <class Container = T>
         static typename std::enable_if<extension_traits::is_std_byte<typename Container::value_type>::value,Json>::type
         to_json(const T& val)
@@ -685,7 +756,7 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             bool result = j.is_array();
             if (result)
             {
-                for (auto e : j.array_range())
+                for (const auto& e : j.array_range())
                 {
                     if (!e.template is<value_type>())
                     {
@@ -762,7 +833,7 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             bool result = j.is_array();
             if (result)
             {
-                for (auto e : j.array_range())
+                for (const auto& e : j.array_range())
                 {
                     if (!e.template is<value_type>())
                     {
@@ -795,6 +866,31 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             }
         }
 
+        static T as(Json&& j)
+        {
+            if (j.storage_kind() == json_storage_kind::json_const_pointer) // not owned, so cannot be moved from
+            {
+                return as(static_cast<const Json&>(j));
+            }
+            if (j.is_array())
+            {
+                T result;
+
+                auto it = j.array_range().rbegin();
+                auto end = j.array_range().rend();
+                for (; it != end; ++it)
+                {
+                    result.push_front(std::move(*it).template as<value_type>());
+                }
+
+                return result;
+            }
+            else 
+            {
+                JSONCONS_THROW(conv_error(conv_errc::not_vector));
+            }
+        }
+
         static Json to_json(const T& val)
         {
             Json j(json_array_arg);
@@ -822,6 +918,34 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             }
             return j;
         }
+
+        static Json to_json(T&& val)
+        {
+            Json j(json_array_arg);
+            auto first = std::begin(val);
+            auto last = std::end(val);
+            std::size_t size = std::distance(first,last);
+            j.reserve(size);
+            for (auto it = first; it != last; ++it)
+            {
+                j.push_back(std::move(*it));
+            }
+            return j;
+        }
+
+        static Json to_json(T&& val, const allocator_type& alloc)
+        {
+            Json j(json_array_arg, alloc);
+            auto first = std::begin(val);
+            auto last = std::end(val);
+            std::size_t size = std::distance(first, last);
+            j.reserve(size);
+            for (auto it = first; it != last; ++it)
+            {
+                j.push_back(std::move(*it));
+            }
+            return j;
+        }
     };
 
     // std::array
@@ -838,7 +962,7 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             bool result = j.is_array() && j.size() == N;
             if (result)
             {
-                for (auto e : j.array_range())
+                for (const auto& e : j.array_range())
                 {
                     if (!e.template is<value_type>())
                     {
@@ -864,6 +988,24 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             return buff;
         }
 
+        static std::array<E, N> as(Json&& j)
+        {
+            if (j.storage_kind() == json_storage_kind::json_const_pointer) // not owned, so cannot be moved from
+            {
+                return as(static_cast<const Json&>(j));
+            }
+            std::array<E, N> buff;
+            if (j.size() != N)
+            {
+                JSONCONS_THROW(conv_error(conv_errc::not_array));
+            }
+            for (std::size_t i = 0; i < N; i++)
+            {
+                buff[i] = std::move(j[i]).template as<E>();
+            }
+            return buff;
+        }
+
         static Json to_json(const std::array<E, N>& val)
         {
             Json j(json_array_arg);
@@ -886,6 +1028,29 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             }
             return j;
         }
+
+        static Json to_json(std::array<E, N>&& val)
+        {
+            Json j(json_array_arg);
+            j.reserve(N);
+            for (auto it = val.begin(); it != val.end(); ++it)
+            {
+                j.push_back(std::move(*it));
+            }
+            return j;
+        }
+
+        static Json to_json(std::array<E, N>&& val, 
+                            const allocator_type& alloc)
+        {
+            Json j(json_array_arg, alloc);
+            j.reserve(N);
+            for (auto it = val.begin(); it != val.end(); ++it)
+            {
+                j.push_back(std::move(*it));
+            }
+            return j;
+        }
     };
 
     // map like
@@ -905,7 +1070,7 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
         static bool is(const Json& j) noexcept
         {
             bool result = j.is_object();
-            for (auto member : j.object_range())
+            for (const auto& member : j.object_range())
             {
                 if (!member.value().template is<mapped_type>())
                 {
@@ -930,6 +1095,25 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             return result;
         }
 
+        static T as(Json&& j)
+        {
+            if (j.storage_kind() == json_storage_kind::json_const_pointer) // not owned, so cannot be moved from
+            {
+                return as(static_cast<const Json&>(j));
+            }
+            if (!j.is_object())
+            {
+                JSONCONS_THROW(conv_error(conv_errc::not_map));
+            }
+            T result;
+            for (auto& item : j.object_range())
+            {
+                result.emplace(key_type(item.key().data(),item.key().size()), std::move(item.value()).template as<mapped_type>());
+            }
+
+            return result;
+        }
+
         static Json to_json(const T& val)
         {
             Json j(json_object_arg, val.begin(), val.end());
@@ -941,6 +1125,18 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             Json j(json_object_arg, val.begin(), val.end(), alloc);
             return j;
         }
+
+        static Json to_json(T&& val)
+        {
+            Json j(json_object_arg, std::make_move_iterator(val.begin()), std::make_move_iterator(val.end()));
+            return j;
+        }
+
+        static Json to_json(T&& val, const allocator_type& alloc)
+        {
+            Json j(json_object_arg, std::make_move_iterator(val.begin()), std::make_move_iterator(val.end()), alloc);
+            return j;
+        }
     };
 
     template <class Json, typename T>
@@ -989,6 +1185,23 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             return result;
         }
 
+        static T as(Json&& val) 
+        {
+            if (val.storage_kind() == json_storage_kind::json_const_pointer) // not owned, so cannot be moved from
+            {
+                return as(static_cast<const Json&>(val));
+            }
+            T result;
+            for (auto& item : val.object_range())
+            {
+                Json j(item.key());
+                auto key = json_type_traits<Json,key_type>::as(j);
+                result.emplace(std::move(key), std::move(item.value()).template as<mapped_type>());
+            }
+
+            return result;
+        }
+
         static Json to_json(const T& val) 
         {
             Json j(json_object_arg);
@@ -1030,6 +1243,48 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             }
             return j;
         }
+
+        static Json to_json(T&& val) 
+        {
+            Json j(json_object_arg);
+            j.reserve(val.size());
+            for (auto& item : val)
+            {
+                auto temp = json_type_traits<Json,key_type>::to_json(item.first);
+                if (temp.is_string_view())
+                {
+                    j.try_emplace(typename Json::key_type(temp.as_string_view()), std::move(item.second));
+                }
+                else
+                {
+                    typename Json::key_type key;
+                    temp.dump(key);
+                    j.try_emplace(std::move(key), std::move(item.second));
+                }
+            }
+            return j;
+        }
+
+        static Json to_json(T&& val, const allocator_type& alloc) 
+        {
+            Json j(json_object_arg, semantic_tag::none, alloc);
+            j.reserve(val.size());
+            for (auto& item : val)
+            {
+                auto temp = json_type_traits<Json, key_type>::to_json(item.first, alloc);
+                if (temp.is_string_view())
+                {
+                    j.try_emplace(typename Json::key_type(temp.as_string_view(), alloc), std::move(item.second));
+                }
+                else
+                {
+                    typename Json::key_type key(alloc);
+                    temp.dump(key);
+                    j.try_emplace(std::move(key), std::move(item.second), alloc);
+                }
+            }
+            return j;
+        }
     };
 
     namespace tuple_detail
@@ -1348,7 +1603,7 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             bool result = j.is_array();
             if (result)
             {
-                for (auto e : j.array_range())
+                for (const auto& e : j.array_range())
                 {
                     if (!e.template is<T>())
                     {
@@ -14,12 +14,44 @@
 #include <cmath>
 #include <exception>
 #include <memory> // std::addressof
+#include <algorithm> // std::min
 #include <cstring> // std::memcpy
+#include <cstdint> // std::uintptr_t
+#include <system_error>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/extension_traits.hpp>
+#if defined(JSONCONS_HAS_POSIX_IO)
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/uio.h> // writev
+#endif
 
 namespace jsoncons { 
 
+namespace detail {
+
+    // Writes bytes to a sink with its append member, or with push_back if a
+    // user supplied sink has no append
+
+    template <class Sink>
+    typename std::enable_if<extension_traits::has_append<Sink>::value>::type
+    sink_append(Sink& sink, const uint8_t* s, std::size_t length)
+    {
+        sink.append(s, length);
+    }
+
+    template <class Sink>
+    typename std::enable_if<!extension_traits::has_append<Sink>::value>::type
+    sink_append(Sink& sink, const uint8_t* s, std::size_t length)
+    {
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            sink.push_back(s[i]);
+        }
+    }
+
+} // namespace detail
+
     // stream_sink
 
     template <class CharT>
@@ -278,12 +310,498 @@ namespace jsoncons {
         {
         }
 
+        void append(const uint8_t* s, std::size_t length)
+        {
+            append(s, length, std::integral_constant<bool,extension_traits::has_range_insert<container_type>::value>());
+        }
+
         void push_back(uint8_t ch)
         {
             buf_ptr->push_back(static_cast<value_type>(ch));
         }
+    private:
+        void append(const uint8_t* s, std::size_t length, std::true_type)
+        {
+            buf_ptr->insert(buf_ptr->end(), s, s+length);
+        }
+
+        void append(const uint8_t* s, std::size_t length, std::false_type)
+        {
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                buf_ptr->push_back(static_cast<value_type>(s[i]));
+            }
+        }
+    };
+
+    // counting_sink
+
+    // Discards its output and records the number of items written, 
+    // so that the exact size of an encoding can be computed before 
+    // allocating a buffer for it.
+
+    template <class CharT>
+    class counting_sink
+    {
+    public:
+        using value_type = CharT;
+    private:
+        std::size_t* count_ptr_;
+
+        // Noncopyable
+        counting_sink(const counting_sink&) = delete;
+        counting_sink& operator=(const counting_sink&) = delete;
+    public:
+        counting_sink(counting_sink&& other) noexcept
+            : count_ptr_(nullptr)
+        {
+            std::swap(count_ptr_,other.count_ptr_);
+        }
+
+        counting_sink(std::size_t& count)
+            : count_ptr_(std::addressof(count))
+        {
+        }
+
+        counting_sink& operator=(counting_sink&& other) noexcept
+        {
+            std::swap(count_ptr_,other.count_ptr_);
+            return *this;
+        }
+
+        void flush()
+        {
+        }
+
+        void append(const value_type*, std::size_t length)
+        {
+            *count_ptr_ += length;
+        }
+
+        void push_back(value_type)
+        {
+            ++(*count_ptr_);
+        }
+    };
+
+    // span_sink
+
+    // Writes to a caller provided fixed size buffer. Output that does not
+    // fit is discarded, but is still counted in the size, so a size 
+    // larger than the buffer indicates that the buffer was too small.
+
+    template <class CharT>
+    class span_sink
+    {
+    public:
+        using value_type = CharT;
+    private:
+        value_type* data_;
+        std::size_t capacity_;
+        std::size_t* size_ptr_;
+
+        // Noncopyable
+        span_sink(const span_sink&) = delete;
+        span_sink& operator=(const span_sink&) = delete;
+    public:
+        span_sink(span_sink&& other) noexcept
+            : data_(nullptr), capacity_(0), size_ptr_(nullptr)
+        {
+            std::swap(data_,other.data_);
+            std::swap(capacity_,other.capacity_);
+            std::swap(size_ptr_,other.size_ptr_);
+        }
+
+        span_sink(jsoncons::span<value_type> buffer, std::size_t& size)
+            : data_(buffer.data()), capacity_(buffer.size()), size_ptr_(std::addressof(size))
+        {
+        }
+
+        span_sink& operator=(span_sink&& other) noexcept
+        {
+            std::swap(data_,other.data_);
+            std::swap(capacity_,other.capacity_);
+            std::swap(size_ptr_,other.size_ptr_);
+            return *this;
+        }
+
+        void flush()
+        {
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            std::size_t size = *size_ptr_;
+            if (size < capacity_)
+            {
+                std::size_t n = (std::min)(length, capacity_ - size);
+                std::memcpy(data_ + size, s, n*sizeof(value_type));
+            }
+            *size_ptr_ = size + length;
+        }
+
+        void push_back(value_type ch)
+        {
+            std::size_t size = *size_ptr_;
+            if (size < capacity_)
+            {
+                data_[size] = ch;
+            }
+            *size_ptr_ = size + 1;
+        }
+    };
+
+    // chunked_buffer
+
+    // A sequence of separately allocated blocks. Appending never moves what has
+    // already been written, and the contents are read back block by block as segments.
+
+    template <class T, class Allocator = std::allocator<T>>
+    class chunked_buffer
+    {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using segment_type = jsoncons::span<const T>;
+    private:
+        static constexpr std::size_t default_block_length = 65536;
+
+        struct block
+        {
+            T* data;
+            std::size_t size;
+            std::size_t capacity;
+        };
+
+        using allocator_traits_type = std::allocator_traits<Allocator>;
+        using block_allocator_type = typename allocator_traits_type::template rebind_alloc<block>;
+
+        allocator_type alloc_;
+        std::vector<block,block_allocator_type> blocks_;
+        std::size_t block_length_;
+        std::size_t size_;
+
+        // Noncopyable
+        chunked_buffer(const chunked_buffer&) = delete;
+        chunked_buffer& operator=(const chunked_buffer&) = delete;
+    public:
+        explicit chunked_buffer(const Allocator& alloc = Allocator())
+            : alloc_(alloc), blocks_(block_allocator_type(alloc)), block_length_(default_block_length), size_(0)
+        {
+        }
+
+        explicit chunked_buffer(std::size_t block_length, const Allocator& alloc = Allocator())
+            : alloc_(alloc), blocks_(block_allocator_type(alloc)), block_length_(block_length > 0 ? block_length : 1), size_(0)
+        {
+        }
+
+        chunked_buffer(chunked_buffer&& other) noexcept
+            : alloc_(other.alloc_), blocks_(std::move(other.blocks_)), block_length_(other.block_length_), size_(other.size_)
+        {
+            other.blocks_.clear();
+            other.size_ = 0;
+        }
+
+        ~chunked_buffer() noexcept
+        {
+            clear();
+        }
+
+        chunked_buffer& operator=(chunked_buffer&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                std::swap(alloc_, other.alloc_);
+                std::swap(blocks_, other.blocks_);
+                std::swap(block_length_, other.block_length_);
+                std::swap(size_, other.size_);
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        std::size_t segment_count() const noexcept
+        {
+            return blocks_.size();
+        }
+
+        segment_type segment(std::size_t i) const
+        {
+            return segment_type(blocks_[i].data, blocks_[i].size);
+        }
+
+        void clear() noexcept
+        {
+            for (auto& b : blocks_)
+            {
+                allocator_traits_type::deallocate(alloc_, b.data, b.capacity);
+            }
+            blocks_.clear();
+            size_ = 0;
+        }
+
+        void append(const T* s, std::size_t length)
+        {
+            if (!blocks_.empty())
+            {
+                block& last = blocks_.back();
+                std::size_t n = (std::min)(length, last.capacity - last.size);
+                std::memcpy(last.data + last.size, s, n*sizeof(T));
+                last.size += n;
+                size_ += n;
+                s += n;
+                length -= n;
+            }
+            if (length > 0)
+            {
+                block& b = add_block(length);
+                std::memcpy(b.data, s, length*sizeof(T));
+                b.size = length;
+                size_ += length;
+            }
+        }
+
+        void push_back(T ch)
+        {
+            if (blocks_.empty() || blocks_.back().size == blocks_.back().capacity)
+            {
+                add_block(1);
+            }
+            block& last = blocks_.back();
+            last.data[last.size++] = ch;
+            ++size_;
+        }
+    private:
+        block& add_block(std::size_t min_capacity)
+        {
+            std::size_t capacity = (std::max)(block_length_, min_capacity);
+            blocks_.reserve(blocks_.size() + 1);
+            T* data = allocator_traits_type::allocate(alloc_, capacity);
+            blocks_.push_back(block{data, 0, capacity});
+            return blocks_.back();
+        }
     };
 
+    // chunked_sink
+
+    template <class T, class Allocator = std::allocator<T>>
+    class chunked_sink
+    {
+    public:
+        using value_type = T;
+        using container_type = chunked_buffer<T,Allocator>;
+    private:
+        container_type* buf_ptr;
+
+        // Noncopyable
+        chunked_sink(const chunked_sink&) = delete;
+        chunked_sink& operator=(const chunked_sink&) = delete;
+    public:
+        chunked_sink(chunked_sink&& other) noexcept
+            : buf_ptr(nullptr)
+        {
+            std::swap(buf_ptr,other.buf_ptr);
+        }
+
+        chunked_sink(container_type& buf)
+            : buf_ptr(std::addressof(buf))
+        {
+        }
+
+        chunked_sink& operator=(chunked_sink&& other) noexcept
+        {
+            std::swap(buf_ptr,other.buf_ptr);
+            return *this;
+        }
+
+        void flush()
+        {
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            buf_ptr->append(s, length);
+        }
+
+        void push_back(value_type ch)
+        {
+            buf_ptr->push_back(ch);
+        }
+    };
+
+#if defined(JSONCONS_HAS_POSIX_IO)
+
+    // fd_sink
+
+    // Writes to a POSIX file descriptor through a page aligned buffer. An append that
+    // is at least as long as the buffer is written together with the pending output
+    // by one writev, without being copied. The file descriptor is not closed.
+    // Write errors are reported by throwing std::system_error.
+
+    template <class CharT>
+    class fd_sink
+    {
+        static_assert(sizeof(CharT) == 1, "fd_sink requires a single byte value type");
+    public:
+        using value_type = CharT;
+    private:
+        static constexpr std::size_t default_buffer_length = 1048576;
+        static constexpr std::size_t alignment = 4096;
+
+        int fd_;
+        std::unique_ptr<char[]> storage_;
+        CharT* begin_buffer_;
+        CharT* end_buffer_;
+        CharT* p_;
+
+        // Noncopyable
+        fd_sink(const fd_sink&) = delete;
+        fd_sink& operator=(const fd_sink&) = delete;
+    public:
+        fd_sink(int fd)
+            : fd_sink(fd, default_buffer_length)
+        {
+        }
+
+        fd_sink(int fd, std::size_t buflen)
+            : fd_(fd), storage_(new char[(buflen > 0 ? buflen : 1) + alignment]),
+              begin_buffer_(nullptr), end_buffer_(nullptr), p_(nullptr)
+        {
+            auto addr = reinterpret_cast<std::uintptr_t>(storage_.get());
+            std::size_t offset = (alignment - addr % alignment) % alignment;
+            begin_buffer_ = reinterpret_cast<CharT*>(storage_.get() + offset);
+            end_buffer_ = begin_buffer_ + (buflen > 0 ? buflen : 1);
+            p_ = begin_buffer_;
+        }
+
+        fd_sink(fd_sink&& other) noexcept
+            : fd_(other.fd_), storage_(std::move(other.storage_)), 
+              begin_buffer_(other.begin_buffer_), end_buffer_(other.end_buffer_), p_(other.p_)
+        {
+            other.fd_ = -1;
+            other.begin_buffer_ = other.end_buffer_ = other.p_ = nullptr;
+        }
+
+        ~fd_sink() noexcept
+        {
+            JSONCONS_TRY
+            {
+                write_pending(nullptr, 0);
+            }
+            JSONCONS_CATCH(...)
+            {
+            }
+        }
+
+        fd_sink& operator=(fd_sink&& other) noexcept
+        {
+            std::swap(fd_, other.fd_);
+            std::swap(storage_, other.storage_);
+            std::swap(begin_buffer_, other.begin_buffer_);
+            std::swap(end_buffer_, other.end_buffer_);
+            std::swap(p_, other.p_);
+            return *this;
+        }
+
+        void flush()
+        {
+            write_pending(nullptr, 0);
+        }
+
+        void append(const CharT* s, std::size_t length)
+        {
+            std::size_t available = end_buffer_ - p_;
+            if (length <= available)
+            {
+                std::memcpy(p_, s, length);
+                p_ += length;
+            }
+            else if (length < static_cast<std::size_t>(end_buffer_ - begin_buffer_))
+            {
+                std::memcpy(p_, s, available);
+                p_ = end_buffer_;
+                write_pending(nullptr, 0);
+                std::memcpy(p_, s + available, length - available);
+                p_ += length - available;
+            }
+            else
+            {
+                write_pending(s, length);
+            }
+        }
+
+        void push_back(CharT ch)
+        {
+            if (p_ == end_buffer_)
+            {
+                write_pending(nullptr, 0);
+            }
+            *p_++ = ch;
+        }
+    private:
+        // Writes the buffered output followed by [s, s+length), then empties the buffer
+        void write_pending(const CharT* s, std::size_t length)
+        {
+            struct iovec iov[2];
+            iov[0].iov_base = begin_buffer_;
+            iov[0].iov_len = static_cast<std::size_t>(p_ - begin_buffer_);
+            iov[1].iov_base = const_cast<CharT*>(s);
+            iov[1].iov_len = length;
+            struct iovec* first = iov;
+            int count = 2;
+            p_ = begin_buffer_;
+
+            while (count > 0 && first->iov_len == 0)
+            {
+                ++first;
+                --count;
+            }
+            while (count > 0)
+            {
+                ssize_t n = ::writev(fd_, first, count);
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    JSONCONS_THROW(std::system_error(errno, std::generic_category(), "fd_sink"));
+                }
+                std::size_t written = static_cast<std::size_t>(n);
+                while (count > 0 && written >= first->iov_len)
+                {
+                    written -= first->iov_len;
+                    ++first;
+                    --count;
+                }
+                if (count > 0)
+                {
+                    first->iov_base = static_cast<char*>(first->iov_base) + written;
+                    first->iov_len -= written;
+                }
+            }
+        }
+    };
+
+    using binary_fd_sink = fd_sink<uint8_t>;
+
+#endif // JSONCONS_HAS_POSIX_IO
+
 } // namespace jsoncons
 
 #endif
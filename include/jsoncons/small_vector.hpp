@@ -0,0 +1,644 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_SMALL_VECTOR_HPP
+#define JSONCONS_SMALL_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory> // std::allocator_traits, std::pointer_traits
+#include <iterator> // std::reverse_iterator, std::iterator_traits
+#include <algorithm> // std::move, std::move_backward, std::rotate, std::equal, std::lexicographical_compare
+#include <initializer_list>
+#include <type_traits>
+#include <utility> // std::move, std::swap
+#include <stdexcept> // std::out_of_range
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/extension_traits.hpp>
+
+namespace jsoncons {
+
+    // small_vector
+
+    // A sequence container with the interface of std::vector that keeps its first elements in
+    // InlineBytes of storage inside the container, and moves them to the heap when it grows beyond that.
+    // The inline capacity is given in bytes rather than elements so that small_vector<T,...> can be a
+    // member of a class that T refers to while T is still incomplete, as in json_array<Json>.
+
+    template <class T, class Allocator = std::allocator<T>, std::size_t InlineBytes = 32>
+    class small_vector
+    {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    private:
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using alloc_pointer = typename alloc_traits::pointer;
+
+        union inline_word
+        {
+            void* p;
+            double d;
+            int64_t i;
+        };
+
+        // Empty base optimization for stateless allocators. heap_ is null while the elements 
+        // are inline, no pointer to the inline storage is kept, so that a small_vector may be 
+        // placed in shared memory with an allocator whose pointer is an offset pointer.
+        struct holder : Allocator
+        {
+            alloc_pointer heap_;
+            size_type size_;
+            size_type capacity_;
+
+            holder(const Allocator& alloc) noexcept
+                : Allocator(alloc), heap_(nullptr), size_(0), capacity_(0)
+            {
+            }
+        };
+
+        holder holder_;
+        alignas(inline_word) unsigned char inline_[InlineBytes];
+
+    public:
+        static constexpr size_type inline_capacity() noexcept
+        {
+            return InlineBytes / sizeof(T);
+        }
+
+        small_vector() noexcept
+            : small_vector(Allocator())
+        {
+        }
+
+        explicit small_vector(const Allocator& alloc) noexcept
+            : holder_(alloc)
+        {
+            reset_to_inline();
+        }
+
+        explicit small_vector(size_type n, const Allocator& alloc = Allocator())
+            : small_vector(alloc)
+        {
+            resize(n);
+        }
+
+        small_vector(size_type n, const T& value, const Allocator& alloc = Allocator())
+            : small_vector(alloc)
+        {
+            resize(n, value);
+        }
+
+        template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        small_vector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+            : small_vector(alloc)
+        {
+            insert(end(), first, last);
+        }
+
+        small_vector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+            : small_vector(alloc)
+        {
+            insert(end(), init.begin(), init.end());
+        }
+
+        small_vector(const small_vector& other)
+            : small_vector(other, alloc_traits::select_on_container_copy_construction(other.get_allocator()))
+        {
+        }
+
+        small_vector(const small_vector& other, const Allocator& alloc)
+            : small_vector(alloc)
+        {
+            reserve(other.size());
+            for (const auto& item : other)
+            {
+                emplace_back(item);
+            }
+        }
+
+        small_vector(small_vector&& other) noexcept
+            : small_vector(other.get_allocator())
+        {
+            take(other);
+        }
+
+        small_vector(small_vector&& other, const Allocator& alloc)
+            : small_vector(alloc)
+        {
+            if (other.get_allocator() == alloc)
+            {
+                take(other);
+            }
+            else
+            {
+                reserve(other.size());
+                for (auto& item : other)
+                {
+                    emplace_back(std::move(item));
+                }
+                other.clear();
+            }
+        }
+
+        ~small_vector() noexcept
+        {
+            clear();
+            deallocate_heap();
+        }
+
+        small_vector& operator=(const small_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if (alloc_traits::propagate_on_container_copy_assignment::value && !(allocator() == other.allocator()))
+                {
+                    deallocate_heap();
+                    allocator() = other.allocator();
+                }
+                reserve(other.size());
+                for (const auto& item : other)
+                {
+                    emplace_back(item);
+                }
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if (alloc_traits::propagate_on_container_move_assignment::value || allocator() == other.allocator())
+                {
+                    deallocate_heap();
+                    if (alloc_traits::propagate_on_container_move_assignment::value)
+                    {
+                        allocator() = std::move(other.allocator());
+                    }
+                    take(other);
+                }
+                else
+                {
+                    reserve(other.size());
+                    for (auto& item : other)
+                    {
+                        emplace_back(std::move(item));
+                    }
+                    other.clear();
+                }
+            }
+            return *this;
+        }
+
+        small_vector& operator=(std::initializer_list<T> init)
+        {
+            clear();
+            insert(end(), init.begin(), init.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return allocator();
+        }
+
+        // Capacity
+
+        bool empty() const noexcept {return holder_.size_ == 0;}
+
+        size_type size() const noexcept {return holder_.size_;}
+
+        size_type capacity() const noexcept {return holder_.capacity_;}
+
+        size_type max_size() const noexcept {return alloc_traits::max_size(allocator());}
+
+        bool is_inline() const noexcept
+        {
+            return holder_.heap_ == nullptr;
+        }
+
+        void reserve(size_type n)
+        {
+            if (n > holder_.capacity_)
+            {
+                reallocate(n);
+            }
+        }
+
+        void shrink_to_fit()
+        {
+            if (!is_inline() && holder_.size_ < holder_.capacity_)
+            {
+                reallocate(holder_.size_);
+            }
+        }
+
+        // Element access
+
+        T* data() noexcept 
+        {
+            return is_inline() ? inline_data() : extension_traits::to_plain_pointer(holder_.heap_);
+        }
+
+        const T* data() const noexcept 
+        {
+            return is_inline() ? inline_data() : extension_traits::to_plain_pointer(holder_.heap_);
+        }
+
+        reference operator[](size_type i) noexcept {return data()[i];}
+
+        const_reference operator[](size_type i) const noexcept {return data()[i];}
+
+        reference at(size_type i)
+        {
+            if (i >= holder_.size_)
+            {
+                JSONCONS_THROW(std::out_of_range("small_vector index out of range"));
+            }
+            return data()[i];
+        }
+
+        const_reference at(size_type i) const
+        {
+            if (i >= holder_.size_)
+            {
+                JSONCONS_THROW(std::out_of_range("small_vector index out of range"));
+            }
+            return data()[i];
+        }
+
+        reference front() noexcept {return data()[0];}
+
+        const_reference front() const noexcept {return data()[0];}
+
+        reference back() noexcept {return data()[holder_.size_-1];}
+
+        const_reference back() const noexcept {return data()[holder_.size_-1];}
+
+        // Iterators
+
+        iterator begin() noexcept {return data();}
+
+        iterator end() noexcept {return data() + holder_.size_;}
+
+        const_iterator begin() const noexcept {return data();}
+
+        const_iterator end() const noexcept {return data() + holder_.size_;}
+
+        const_iterator cbegin() const noexcept {return data();}
+
+        const_iterator cend() const noexcept {return data() + holder_.size_;}
+
+        reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+
+        reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+
+        const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+
+        const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+        // Modifiers
+
+        void clear() noexcept
+        {
+            destroy(begin(), end());
+            holder_.size_ = 0;
+        }
+
+        template <class... Args>
+        reference emplace_back(Args&&... args)
+        {
+            if (holder_.size_ == holder_.capacity_)
+            {
+                // Construct the new element before moving the others, args may refer to one of them
+                const size_type new_capacity = grown_capacity(holder_.size_ + 1);
+                alloc_pointer new_heap = alloc_traits::allocate(allocator(), new_capacity);
+                JSONCONS_TRY
+                {
+                    alloc_traits::construct(allocator(), extension_traits::to_plain_pointer(new_heap) + holder_.size_, 
+                                            std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    alloc_traits::deallocate(allocator(), new_heap, new_capacity);
+                    JSONCONS_RETHROW;
+                }
+                relocate(new_heap, new_capacity);
+            }
+            else
+            {
+                alloc_traits::construct(allocator(), end(), std::forward<Args>(args)...);
+            }
+            ++holder_.size_;
+            return back();
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back() noexcept
+        {
+            --holder_.size_;
+            alloc_traits::destroy(allocator(), end());
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            const size_type offset = static_cast<size_type>(pos - cbegin());
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(begin() + offset, end() - 1, end());
+            return begin() + offset;
+        }
+
+        iterator insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            const size_type offset = static_cast<size_type>(pos - cbegin());
+            const size_type old_size = holder_.size_;
+            reserve_for(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+            std::rotate(begin() + offset, begin() + old_size, end());
+            return begin() + offset;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> init)
+        {
+            return insert(pos, init.begin(), init.end());
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            iterator p = begin() + (first - cbegin());
+            if (first != last)
+            {
+                iterator new_end = std::move(begin() + (last - cbegin()), end(), p);
+                destroy(new_end, end());
+                holder_.size_ = static_cast<size_type>(new_end - begin());
+            }
+            return p;
+        }
+
+        void resize(size_type n)
+        {
+            if (n < holder_.size_)
+            {
+                erase(begin() + n, end());
+            }
+            else
+            {
+                reserve(n);
+                while (holder_.size_ < n)
+                {
+                    emplace_back();
+                }
+            }
+        }
+
+        void resize(size_type n, const T& value)
+        {
+            if (n < holder_.size_)
+            {
+                erase(begin() + n, end());
+            }
+            else
+            {
+                reserve(n);
+                while (holder_.size_ < n)
+                {
+                    emplace_back(value);
+                }
+            }
+        }
+
+        void swap(small_vector& other) noexcept
+        {
+            if (this == &other)
+            {
+                return;
+            }
+            if (!is_inline() && !other.is_inline())
+            {
+                std::swap(holder_.heap_, other.holder_.heap_);
+                std::swap(holder_.size_, other.holder_.size_);
+                std::swap(holder_.capacity_, other.holder_.capacity_);
+            }
+            else
+            {
+                small_vector temp(std::move(other));
+                other.take(*this);
+                take(temp);
+            }
+            swap_allocators(typename alloc_traits::propagate_on_container_swap(), other);
+        }
+
+        friend void swap(small_vector& a, small_vector& b) noexcept
+        {
+            a.swap(b);
+        }
+
+        friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+        {
+            return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const small_vector& lhs, const small_vector& rhs)
+        {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator<=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const small_vector& lhs, const small_vector& rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+    private:
+        Allocator& allocator() noexcept
+        {
+            return holder_;
+        }
+
+        const Allocator& allocator() const noexcept
+        {
+            return holder_;
+        }
+
+        T* inline_data() noexcept
+        {
+            return reinterpret_cast<T*>(inline_);
+        }
+
+        const T* inline_data() const noexcept
+        {
+            return reinterpret_cast<const T*>(inline_);
+        }
+
+        void reset_to_inline() noexcept
+        {
+            static_assert(alignof(T) <= alignof(inline_word), "Alignment of T exceeds the alignment of the inline storage");
+            holder_.heap_ = nullptr;
+            holder_.size_ = 0;
+            holder_.capacity_ = inline_capacity();
+        }
+
+        size_type grown_capacity(size_type n) const noexcept
+        {
+            size_type cap = holder_.capacity_ * 2;
+            return cap < n ? n : cap;
+        }
+
+        void deallocate_heap() noexcept
+        {
+            if (!is_inline())
+            {
+                alloc_traits::deallocate(allocator(), holder_.heap_, holder_.capacity_);
+                reset_to_inline();
+            }
+        }
+
+        void destroy(T* first, T* last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                alloc_traits::destroy(allocator(), first);
+            }
+        }
+
+        // Moves the elements to new_heap, or to the inline storage if new_heap is null
+        void relocate(alloc_pointer new_heap, size_type new_capacity) noexcept
+        {
+            T* old_data = data();
+            T* new_data = new_heap == nullptr ? inline_data() : extension_traits::to_plain_pointer(new_heap);
+            for (size_type i = 0; i < holder_.size_; ++i)
+            {
+                alloc_traits::construct(allocator(), new_data + i, std::move(old_data[i]));
+                alloc_traits::destroy(allocator(), old_data + i);
+            }
+            if (!is_inline())
+            {
+                alloc_traits::deallocate(allocator(), holder_.heap_, holder_.capacity_);
+            }
+            holder_.heap_ = new_heap;
+            holder_.capacity_ = new_capacity;
+        }
+
+        void reallocate(size_type n)
+        {
+            if (n <= inline_capacity())
+            {
+                if (!is_inline())
+                {
+                    relocate(nullptr, inline_capacity());
+                }
+            }
+            else
+            {
+                relocate(alloc_traits::allocate(allocator(), n), n);
+            }
+        }
+
+        // Takes the elements of other, which must have an equal allocator, and leaves it empty
+        void take(small_vector& other) noexcept
+        {
+            if (other.is_inline())
+            {
+                T* other_data = other.inline_data();
+                for (size_type i = 0; i < other.holder_.size_; ++i)
+                {
+                    alloc_traits::construct(allocator(), inline_data() + i, std::move(other_data[i]));
+                }
+                holder_.heap_ = nullptr;
+                holder_.size_ = other.holder_.size_;
+                holder_.capacity_ = inline_capacity();
+                other.clear();
+            }
+            else
+            {
+                holder_.heap_ = other.holder_.heap_;
+                holder_.size_ = other.holder_.size_;
+                holder_.capacity_ = other.holder_.capacity_;
+                other.reset_to_inline();
+            }
+        }
+
+        void swap_allocators(std::true_type, small_vector& other) noexcept
+        {
+            using std::swap;
+            swap(allocator(), other.allocator());
+        }
+
+        void swap_allocators(std::false_type, small_vector&) noexcept
+        {
+        }
+
+        template <class InputIt>
+        void reserve_for(InputIt, InputIt, std::input_iterator_tag)
+        {
+        }
+
+        template <class ForwardIt>
+        void reserve_for(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+        {
+            reserve(holder_.size_ + static_cast<size_type>(std::distance(first, last)));
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
@@ -1145,6 +1145,46 @@ public:
     virtual void next(std::error_code& ec) = 0;
 
     virtual const ser_context& context() const = 0;
+
+    virtual void skip()
+    {
+        std::error_code ec;
+        skip(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,context().line(),context().column()));
+        }
+    }
+
+    // Advances past the current value. If the current event is begin_object
+    // or begin_array, the cursor is positioned on the event following the
+    // matching end event. Cursors that can use length prefixes to jump
+    // over nested items override this.
+    virtual void skip(std::error_code& ec)
+    {
+        std::size_t depth = 0;
+        do
+        {
+            switch (current().event_type())
+            {
+                case staj_event_type::begin_object:
+                case staj_event_type::begin_array:
+                    ++depth;
+                    break;
+                case staj_event_type::end_object:
+                case staj_event_type::end_array:
+                    if (depth > 0)
+                    {
+                        --depth;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            next(ec);
+        }
+        while (!ec && depth > 0 && !done());
+    }
 };
 
 template<class CharT>
@@ -1202,6 +1242,24 @@ public:
         }
     }
 
+    void skip() override
+    {
+        cursor_->skip();
+        while (!done() && !pred_(current(),context()))
+        {
+            cursor_->next();
+        }
+    }
+
+    void skip(std::error_code& ec) override
+    {
+        cursor_->skip(ec);
+        while (!done() && !pred_(current(),context()) && !ec)
+        {
+            cursor_->next(ec);
+        }
+    }
+
     const ser_context& context() const override
     {
         return cursor_->context();
@@ -24,6 +24,9 @@
 #include <limits>
 #include <jsoncons/config/compiler_support.hpp>
 #include <jsoncons/extension_traits.hpp>
+#if defined(JSONCONS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
 
 namespace jsoncons { namespace unicode_traits {
 
@@ -198,6 +201,72 @@ namespace jsoncons { namespace unicode_traits {
         return (ch & 0xC0) == 0x80;
     }
 
+    /*
+     * Byte classes and transitions of a state machine that accepts exactly 
+     * the well formed UTF-8 sequences. Classes: 0 ASCII, 1 80..8F, 2 90..9F,
+     * 3 A0..BF, 4 never legal (C0, C1, F5..FF), 5 C2..DF, 6 E0, 7 E1..EC EE..EF,
+     * 8 ED, 9 F0, 10 F1..F3, 11 F4. States: 0 accept, 1 reject, 2-4 expecting 
+     * 1-3 continuation bytes, 5-8 expecting the restricted second byte of 
+     * E0, ED, F0 and F4.
+     */
+    const uint8_t utf8_byte_class[256] = {
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+        1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,
+        3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3, 3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,
+        4,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5, 5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
+        6,7,7,7,7,7,7,7,7,7,7,7,7,8,7,7, 9,10,10,10,11,4,4,4,4,4,4,4,4,4,4,4
+    };
+
+    const uint8_t utf8_accept = 0;
+    const uint8_t utf8_reject = 1;
+
+    const uint8_t utf8_transitions[9*12] = {
+        0,1,1,1,1,2,5,3,6,7,4,8, // accept
+        1,1,1,1,1,1,1,1,1,1,1,1, // reject
+        1,0,0,0,1,1,1,1,1,1,1,1, // 1 continuation byte
+        1,2,2,2,1,1,1,1,1,1,1,1, // 2 continuation bytes
+        1,3,3,3,1,1,1,1,1,1,1,1, // 3 continuation bytes
+        1,1,1,2,1,1,1,1,1,1,1,1, // after E0
+        1,2,2,1,1,1,1,1,1,1,1,1, // after ED
+        1,1,3,3,1,1,1,1,1,1,1,1, // after F0
+        1,3,1,1,1,1,1,1,1,1,1,1  // after F4
+    };
+
+    // Returns a pointer to the first byte in [first,last) that is not ASCII, or last
+    inline
+    const uint8_t* skip_ascii(const uint8_t* first, const uint8_t* last) noexcept
+    {
+#if defined(JSONCONS_HAS_SSE2)
+        while (last - first >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            if (_mm_movemask_epi8(chunk) != 0)
+            {
+                break;
+            }
+            first += 16;
+        }
+#endif
+        while (last - first >= 8)
+        {
+            uint64_t chunk;
+            std::memcpy(&chunk, first, sizeof(chunk));
+            if ((chunk & 0x8080808080808080ULL) != 0)
+            {
+                break;
+            }
+            first += 8;
+        }
+        while (first != last && *first < 0x80)
+        {
+            ++first;
+        }
+        return first;
+    }
+
     inline
     bool is_high_surrogate(uint32_t ch) noexcept
     {
@@ -543,6 +612,58 @@ namespace jsoncons { namespace unicode_traits {
         return convert_result<CharT>{first,result} ;
     }
 
+    // validate utf8
+
+    template <class CharT>
+    typename std::enable_if<extension_traits::is_char8<CharT>::value,
+                            convert_result<CharT>>::type 
+    validate(const CharT* data, std::size_t length) noexcept
+    {
+        // Runs of ASCII are skipped in blocks, other sequences go through the 
+        // state machine. Only an ill formed sequence is checked again, byte by byte, 
+        // to report why it is ill formed.
+        const uint8_t* first = reinterpret_cast<const uint8_t*>(data);
+        const uint8_t* last = first + length;
+        const uint8_t* p = first;
+        while (p != last) 
+        {
+            if (*p < 0x80)
+            {
+                p = skip_ascii(p, last);
+                continue;
+            }
+            // Stays in the state machine until the next ASCII byte
+            const uint8_t* start = p;
+            uint8_t state = utf8_accept;
+            do
+            {
+                if (state == utf8_accept)
+                {
+                    start = p;
+                }
+                state = utf8_transitions[state*12 + utf8_byte_class[*p++]];
+            }
+            while (state != utf8_reject && p != last && (state != utf8_accept || *p >= 0x80));
+
+            if (JSONCONS_UNLIKELY(state != utf8_accept))
+            {
+                const CharT* sequence = data + (start - first);
+                std::size_t len = static_cast<std::size_t>(trailing_bytes_for_utf8[*start]) + 1;
+                if (len > (std::size_t)(last - start))
+                {
+                    return convert_result<CharT>{sequence, conv_errc::source_exhausted};
+                }
+                conv_errc result = is_legal_utf8(sequence, len);
+                if (result != conv_errc())
+                {
+                    return convert_result<CharT>{sequence, result};
+                }
+                p = start + len;
+            }
+        }
+        return convert_result<CharT>{data + length, conv_errc()};
+    }
+
     // convert
 
     template <class CharT,class Container>
@@ -554,31 +675,13 @@ namespace jsoncons { namespace unicode_traits {
     {
         (void)flags;
 
-        conv_errc  result = conv_errc();
-        const CharT* last = data + length;
-        while (data != last) 
+        // The valid prefix is copied, as the byte by byte conversion did
+        auto result = validate(data, length);
+        for (const CharT* p = data; p != result.ptr; ++p)
         {
-            std::size_t len = trailing_bytes_for_utf8[static_cast<uint8_t>(*data)] + 1;
-            if (len > (std::size_t)(last - data))
-            {
-                return convert_result<CharT>{data, conv_errc::source_exhausted};
-            }
-            if ((result=is_legal_utf8(data, len)) != conv_errc())
-            {
-                return convert_result<CharT>{data,result};
-            }
-
-            switch (len) {
-                case 4: target.push_back(static_cast<uint8_t>(*data++));
-                    JSONCONS_FALLTHROUGH;
-                case 3: target.push_back(static_cast<uint8_t>(*data++));
-                    JSONCONS_FALLTHROUGH;
-                case 2: target.push_back(static_cast<uint8_t>(*data++));
-                    JSONCONS_FALLTHROUGH;
-                case 1: target.push_back(static_cast<uint8_t>(*data++));
-            }
+            target.push_back(static_cast<uint8_t>(*p));
         }
-        return convert_result<CharT>{data,result} ;
+        return result;
     }
 
     template <class CharT,class Container>
@@ -1123,29 +1226,6 @@ namespace jsoncons { namespace unicode_traits {
 
     // validate
 
-    template <class CharT>
-    typename std::enable_if<extension_traits::is_char8<CharT>::value,
-                            convert_result<CharT>>::type 
-    validate(const CharT* data, std::size_t length) noexcept
-    {
-        conv_errc  result = conv_errc();
-        const CharT* last = data + length;
-        while (data != last) 
-        {
-            std::size_t len = static_cast<std::size_t>(trailing_bytes_for_utf8[static_cast<uint8_t>(*data)]) + 1;
-            if (len > (std::size_t)(last - data))
-            {
-                return convert_result<CharT>{data, conv_errc::source_exhausted};
-            }
-            if ((result=is_legal_utf8(data, len)) != conv_errc())
-            {
-                return convert_result<CharT>{data,result} ;
-            }
-            data += len;
-        }
-        return convert_result<CharT>{data,result} ;
-    }
-
     // utf16
 
     template <class CharT>
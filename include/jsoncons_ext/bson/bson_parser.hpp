@@ -211,6 +211,38 @@ public:
         }
     }
 
+    // Skips the remaining elements of the innermost document or array without
+    // producing events, so that the next call to parse produces its end.
+    // The int32 size that prefixes every document allows this to be done
+    // with a single seek.
+    void skip_to_end(std::error_code& ec)
+    {
+        more_ = true;
+        parse_state& state = state_stack_.back();
+        if (state.mode != parse_mode::document && state.mode != parse_mode::array)
+        {
+            return;
+        }
+        // Leave the trailing 0x00 for parse to consume
+        if (JSONCONS_UNLIKELY(state.length < 1 || state.pos > state.length - 1))
+        {
+            ec = bson_errc::size_mismatch;
+            more_ = false;
+            return;
+        }
+        std::size_t length = state.length - 1 - state.pos;
+        std::size_t position = source_.position();
+        source_.ignore(length);
+        std::size_t n = source_.position() - position;
+        state.pos += n;
+        if (JSONCONS_UNLIKELY(n != length))
+        {
+            ec = bson_errc::unexpected_eof;
+            more_ = false;
+            return;
+        }
+    }
+
 private:
 
     void begin_document(json_visitor& visitor, std::error_code& ec)
@@ -61,6 +61,9 @@ namespace additional_info
     const uint8_t indefinite_length = 0x1f;
 }
 
+// Tag of a byte string that holds an array of objects encoded column by column
+const uint64_t columnar_array_tag = 0x6a636f6c;
+
 inline
 size_t min_length_for_stringref(uint64_t index)
 {
@@ -141,6 +141,10 @@ public:
         bytestringref_map_.clear();
         next_stringref_ = 0;
         nesting_depth_ = 0;
+        if (options_.pack_strings())
+        {
+            write_tag(256);
+        }
     }
 
     void reset(Sink&& sink)
@@ -419,10 +423,7 @@ private:
                                             std::back_inserter(sink_));
         }
 
-        for (auto c : sv)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::sink_append(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
     }
 
     void write_bignum(bigint& n)
@@ -482,10 +483,7 @@ private:
                                   std::back_inserter(sink_));
         }
 
-        for (auto c : data)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::sink_append(sink_, reinterpret_cast<const uint8_t*>(data.data()), data.size());
     }
 
     bool write_decimal_value(const string_view_type& sv, const ser_context& context, std::error_code& ec)
@@ -942,6 +940,7 @@ private:
             }
             else
             {
+                write_tag(ext_tag);
                 write_tag(25);
                 write_uint64_value(it->second);
             }
@@ -993,10 +992,7 @@ private:
                                             std::back_inserter(sink_));
         }
 
-        for (auto c : b)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::sink_append(sink_, reinterpret_cast<const uint8_t*>(b.data()), b.size());
     }
 
     bool visit_double(double val, 
@@ -1255,6 +1251,7 @@ private:
                     break;
             }
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1285,6 +1282,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             std::memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1315,6 +1313,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint32_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(uint32_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1345,6 +1344,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint64_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(uint64_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1373,6 +1373,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int8_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int8_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1403,6 +1404,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int16_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1433,6 +1435,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int32_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int32_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1463,6 +1466,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int64_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int64_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1493,6 +1497,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             std::memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1523,6 +1528,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(float));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(float));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1553,6 +1559,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(double));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(double));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -27,7 +27,9 @@ enum class cbor_errc
     stringref_too_large,
     max_nesting_depth_exceeded,
     unknown_type,
-    illegal_chunked_string
+    illegal_chunked_string,
+    buffer_too_small,
+    invalid_columnar_array
 };
 
 class cbor_error_category_impl
@@ -66,6 +68,10 @@ public:
                 return "An unknown type was found in the stream";
             case cbor_errc::illegal_chunked_string:
                 return "An illegal type was found while parsing an indefinite length string";
+            case cbor_errc::buffer_too_small:
+                return "Output buffer is too small for the encoded value";
+            case cbor_errc::invalid_columnar_array:
+                return "Invalid array of objects written column by column";
             default:
                 return "Unknown CBOR parser error";
         }
@@ -22,11 +22,12 @@ class cbor_options_common
     friend class cbor_options;
 
     int max_nesting_depth_;
+    bool columnar_arrays_;
 protected:
     virtual ~cbor_options_common() = default;
 
     cbor_options_common()
-        : max_nesting_depth_(1024)
+        : max_nesting_depth_(1024), columnar_arrays_(false)
     {
     }
 
@@ -39,6 +40,11 @@ public:
     {
         return max_nesting_depth_;
     }
+
+    bool columnar_arrays() const 
+    {
+        return columnar_arrays_;
+    }
 };
 
 class cbor_decode_options : public virtual cbor_options_common
@@ -78,6 +84,7 @@ class cbor_options final : public cbor_decode_options, public cbor_encode_option
 {
 public:
     using cbor_options_common::max_nesting_depth;
+    using cbor_options_common::columnar_arrays;
     using cbor_encode_options::pack_strings;
     using cbor_encode_options::use_typed_arrays;
 
@@ -87,6 +94,12 @@ public:
         return *this;
     }
 
+    cbor_options& columnar_arrays(bool value)
+    {
+        this->columnar_arrays_ = value;
+        return *this;
+    }
+
     cbor_options& pack_strings(bool value)
     {
         this->use_stringref_ = value;
@@ -20,10 +20,11 @@
 #include <jsoncons_ext/cbor/cbor_detail.hpp>
 #include <jsoncons_ext/cbor/cbor_options.hpp>
 #include <jsoncons/item_event_visitor.hpp>
+#include <jsoncons/detail/columnar_arrays.hpp>
 
 namespace jsoncons { namespace cbor {
 
-enum class parse_mode {root,accept,array,indefinite_array,map_key,map_value,indefinite_map_key,indefinite_map_value,multi_dim};
+enum class parse_mode {root,accept,array,indefinite_array,map_key,map_value,indefinite_map_key,indefinite_map_value,multi_dim,columnar};
 
 struct parse_state 
 {
@@ -129,6 +130,7 @@ class basic_cbor_parser : public ser_context
     std::size_t index_; // TODO: Never used!
     std::vector<stringref_map,stringref_map_allocator_type> stringref_map_stack_;
     int nesting_depth_;
+    jsoncons::detail::columnar_block_reader<Allocator> columnar_reader_;
 
     struct read_byte_string_from_buffer
     {
@@ -182,7 +184,8 @@ public:
          typed_array_(alloc),
          index_(0),
          stringref_map_stack_(alloc),
-         nesting_depth_(0)
+         nesting_depth_(0),
+         columnar_reader_(alloc)
     {
         state_stack_.emplace_back(parse_mode::root,0);
     }
@@ -332,6 +335,18 @@ public:
                     read_item(visitor, ec);
                     break;
                 }
+                case parse_mode::columnar:
+                {
+                    if (state_stack_.back().index < state_stack_.back().length)
+                    {
+                        more_ = columnar_reader_.produce_event(state_stack_.back().index++, visitor, *this, ec);
+                    }
+                    else
+                    {
+                        end_array(visitor, ec);
+                    }
+                    break;
+                }
                 case parse_mode::root:
                 {
                     state_stack_.back().mode = parse_mode::accept;
@@ -350,6 +365,101 @@ public:
             }
         }
     }
+
+    // Skips the remaining items of the innermost array or map without
+    // producing events, so that the next call to parse produces its end.
+    // Definite lengths are used to pass over strings and scalars, recursion
+    // is only needed for nested arrays and maps.
+    void skip_to_end(std::error_code& ec)
+    {
+        more_ = true;
+        bool record_strings = !stringref_map_stack_.empty();
+
+        switch (state_stack_.back().mode)
+        {
+            case parse_mode::array:
+            {
+                while (state_stack_.back().index < state_stack_.back().length)
+                {
+                    ++state_stack_.back().index;
+                    skip_item(record_strings, 1, ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                }
+                break;
+            }
+            case parse_mode::map_key:
+            {
+                while (state_stack_.back().index < state_stack_.back().length)
+                {
+                    ++state_stack_.back().index;
+                    skip_item(record_strings, 1, ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    skip_item(record_strings, 1, ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                }
+                break;
+            }
+            case parse_mode::indefinite_array:
+            case parse_mode::indefinite_map_key:
+            {
+                const bool is_map = state_stack_.back().mode == parse_mode::indefinite_map_key;
+                while (true)
+                {
+                    auto c = source_.peek();
+                    if (c.eof)
+                    {
+                        ec = cbor_errc::unexpected_eof;
+                        more_ = false;
+                        return;
+                    }
+                    if (c.value == 0xff)
+                    {
+                        break;
+                    }
+                    skip_item(record_strings, 1, ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    if (is_map)
+                    {
+                        skip_item(record_strings, 1, ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                    }
+                }
+                break;
+            }
+            case parse_mode::columnar:
+            {
+                // Rows are produced from a block that has already been read
+                const std::size_t per_row = columnar_reader_.row_event_count();
+                const std::size_t pos = state_stack_.back().index % per_row;
+                if (pos != 0)
+                {
+                    state_stack_.back().index += per_row - 1 - pos;
+                }
+                else
+                {
+                    state_stack_.back().index = state_stack_.back().length;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
 private:
     void read_item(item_event_visitor& visitor, std::error_code& ec)
     {
@@ -655,6 +765,36 @@ private:
         state_stack_.pop_back();
     }
 
+    // Reads a block written column by column from bytes_buffer_, 
+    // its rows are then produced by parse
+    void begin_columnar_array(item_event_visitor& visitor, std::error_code& ec)
+    {
+        columnar_reader_.reset();
+        basic_cbor_parser<bytes_source,Allocator> parser(bytes_buffer_, options_, alloc_);
+        parser.parse(columnar_reader_, ec);
+        if (ec)
+        {
+            more_ = false;
+            return;
+        }
+        if (!columnar_reader_.done())
+        {
+            ec = cbor_errc::invalid_columnar_array;
+            more_ = false;
+            return;
+        }
+        // The array and its row objects
+        if (JSONCONS_UNLIKELY(nesting_depth_ + 2 > options_.max_nesting_depth()))
+        {
+            ec = cbor_errc::max_nesting_depth_exceeded;
+            more_ = false;
+            return;
+        } 
+        ++nesting_depth_;
+        state_stack_.emplace_back(parse_mode::columnar, columnar_reader_.event_count());
+        more_ = visitor.begin_array(columnar_reader_.num_rows(), semantic_tag::none, *this, ec);
+    }
+
     void begin_object(item_event_visitor& visitor, uint8_t info, std::error_code& ec)
     {
         if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
@@ -1402,6 +1542,213 @@ private:
         }
     }
 
+    void skip_item(bool record_strings, int depth, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(nesting_depth_ + depth > options_.max_nesting_depth()))
+        {
+            ec = cbor_errc::max_nesting_depth_exceeded;
+            more_ = false;
+            return;
+        } 
+        auto c = source_.peek();
+        if (c.eof)
+        {
+            ec = cbor_errc::unexpected_eof;
+            more_ = false;
+            return;
+        }
+        jsoncons::cbor::detail::cbor_major_type major_type = get_major_type(c.value);
+        while (major_type == jsoncons::cbor::detail::cbor_major_type::semantic_tag)
+        {
+            uint64_t val = get_uint64_value(ec);
+            if (!more_)
+            {
+                return;
+            }
+            if (val == 256) // stringref-namespace
+            {
+                // strings in a nested namespace cannot be referenced from outside it
+                record_strings = false;
+            }
+            c = source_.peek();
+            if (c.eof)
+            {
+                ec = cbor_errc::unexpected_eof;
+                more_ = false;
+                return;
+            }
+            major_type = get_major_type(c.value);
+        }
+        uint8_t info = get_additional_information_value(c.value);
+
+        switch (major_type)
+        {
+            case jsoncons::cbor::detail::cbor_major_type::unsigned_integer:
+            case jsoncons::cbor::detail::cbor_major_type::negative_integer:
+            {
+                get_uint64_value(ec);
+                break;
+            }
+            case jsoncons::cbor::detail::cbor_major_type::byte_string:
+            case jsoncons::cbor::detail::cbor_major_type::text_string:
+            {
+                if (record_strings && info != jsoncons::cbor::detail::additional_info::indefinite_length)
+                {
+                    // Strings that may be the target of a later stringref must be kept
+                    std::size_t length = get_size(ec);
+                    if (!more_)
+                    {
+                        return;
+                    }
+                    if (length >= jsoncons::cbor::detail::min_length_for_stringref(stringref_map_stack_.back().size()))
+                    {
+                        if (major_type == jsoncons::cbor::detail::cbor_major_type::text_string)
+                        {
+                            text_buffer_.clear();
+                            if (source_reader<Source>::read(source_, text_buffer_, length) != length)
+                            {
+                                ec = cbor_errc::unexpected_eof;
+                                more_ = false;
+                                return;
+                            }
+                            stringref_map_stack_.back().emplace_back(mapped_string(text_buffer_, alloc_));
+                        }
+                        else
+                        {
+                            bytes_buffer_.clear();
+                            if (source_reader<Source>::read(source_, bytes_buffer_, length) != length)
+                            {
+                                ec = cbor_errc::unexpected_eof;
+                                more_ = false;
+                                return;
+                            }
+                            stringref_map_stack_.back().emplace_back(mapped_string(bytes_buffer_, alloc_));
+                        }
+                    }
+                    else
+                    {
+                        skip_bytes(length, ec);
+                    }
+                }
+                else
+                {
+                    auto func = [this](Source&, std::size_t length, std::error_code& ec) -> bool
+                    {
+                        skip_bytes(length, ec);
+                        return !ec;
+                    };
+                    iterate_string_chunks(func, major_type, ec);
+                }
+                break;
+            }
+            case jsoncons::cbor::detail::cbor_major_type::array:
+            case jsoncons::cbor::detail::cbor_major_type::map:
+            {
+                const bool is_map = major_type == jsoncons::cbor::detail::cbor_major_type::map;
+                if (info == jsoncons::cbor::detail::additional_info::indefinite_length)
+                {
+                    source_.ignore(1);
+                    while (true)
+                    {
+                        c = source_.peek();
+                        if (c.eof)
+                        {
+                            ec = cbor_errc::unexpected_eof;
+                            more_ = false;
+                            return;
+                        }
+                        if (c.value == 0xff)
+                        {
+                            source_.ignore(1);
+                            break;
+                        }
+                        skip_item(record_strings, depth+1, ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                        if (is_map)
+                        {
+                            skip_item(record_strings, depth+1, ec);
+                            if (ec)
+                            {
+                                return;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    std::size_t len = get_size(ec);
+                    if (!more_)
+                    {
+                        return;
+                    }
+                    for (std::size_t i = 0; i < len; ++i)
+                    {
+                        skip_item(record_strings, depth+1, ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                        if (is_map)
+                        {
+                            skip_item(record_strings, depth+1, ec);
+                            if (ec)
+                            {
+                                return;
+                            }
+                        }
+                    }
+                }
+                break;
+            }
+            case jsoncons::cbor::detail::cbor_major_type::simple:
+            {
+                switch (info)
+                {
+                    case 0x18: // simple value (one-byte uint8_t follows)
+                        skip_bytes(2, ec);
+                        break;
+                    case 0x19: // Half-Precision Float (two-byte IEEE 754)
+                        skip_bytes(3, ec);
+                        break;
+                    case 0x1a: // Single-Precision Float (four-byte IEEE 754)
+                        skip_bytes(5, ec);
+                        break;
+                    case 0x1b: // Double-Precision Float (eight-byte IEEE 754)
+                        skip_bytes(9, ec);
+                        break;
+                    default:
+                        if (info <= 0x17)
+                        {
+                            source_.ignore(1);
+                        }
+                        else
+                        {
+                            ec = cbor_errc::unknown_type;
+                            more_ = false;
+                        }
+                        break;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void skip_bytes(std::size_t length, std::error_code& ec)
+    {
+        std::size_t position = source_.position();
+        source_.ignore(length);
+        if (source_.position() - position != length)
+        {
+            ec = cbor_errc::unexpected_eof;
+            more_ = false;
+        }
+    }
+
     static jsoncons::cbor::detail::cbor_major_type get_major_type(uint8_t type)
     {
         static constexpr uint8_t major_type_shift = 0x05;
@@ -1855,7 +2202,14 @@ private:
                         more_ = false;
                         return;
                     }
-                    more_ = visitor.byte_string_value(bytes_buffer_, item_tag_, *this, ec);
+                    if (item_tag_ == detail::columnar_array_tag && options_.columnar_arrays())
+                    {
+                        begin_columnar_array(visitor, ec);
+                    }
+                    else
+                    {
+                        more_ = visitor.byte_string_value(bytes_buffer_, item_tag_, *this, ec);
+                    }
                     break;
                 }
             }
@@ -198,6 +198,68 @@ namespace cbor {
         return val;
     }
 
+    // basic_cbor_batch_decoder
+
+    // Decodes many small buffers, reusing one reader and one json_decoder,
+    // and with them their stacks and buffers.
+
+    template <class Json,class TempAllocator=std::allocator<char>>
+    class basic_cbor_batch_decoder
+    {
+    public:
+        using value_type = Json;
+        using allocator_type = TempAllocator;
+    private:
+        json_decoder<Json,TempAllocator> decoder_;
+        basic_cbor_reader<jsoncons::bytes_source,TempAllocator> reader_;
+
+        // Noncopyable and nonmoveable
+        basic_cbor_batch_decoder(const basic_cbor_batch_decoder&) = delete;
+        basic_cbor_batch_decoder& operator=(const basic_cbor_batch_decoder&) = delete;
+    public:
+        explicit basic_cbor_batch_decoder(const cbor_decode_options& options = cbor_decode_options(),
+                                          const TempAllocator& temp_alloc = TempAllocator())
+            : decoder_(temp_allocator_arg, temp_alloc), 
+              reader_(jsoncons::bytes_source(), decoder_, options, temp_alloc)
+        {
+        }
+
+        template <class Source>
+        typename std::enable_if<extension_traits::is_byte_sequence<Source>::value,Json>::type
+        decode(const Source& v)
+        {
+            std::error_code ec;
+            Json val = decode(v, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, reader_.line(), reader_.column()));
+            }
+            return val;
+        }
+
+        template <class Source>
+        typename std::enable_if<extension_traits::is_byte_sequence<Source>::value,Json>::type
+        decode(const Source& v, std::error_code& ec)
+        {
+            decoder_.reset();
+            reader_.reset(jsoncons::bytes_source(v));
+            reader_.read(ec);
+            if (ec)
+            {
+                return Json();
+            }
+            if (!decoder_.is_valid())
+            {
+                ec = conv_errc::conversion_failed;
+                return Json();
+            }
+            return decoder_.get_result();
+        }
+    };
+
+    template <class Json>
+    using cbor_batch_decoder = basic_cbor_batch_decoder<Json>;
+
 } // namespace cbor
 } // namespace jsoncons
 
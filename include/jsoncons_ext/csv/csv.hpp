@@ -13,5 +13,7 @@
 #include <jsoncons_ext/csv/csv_cursor.hpp>
 #include <jsoncons_ext/csv/decode_csv.hpp>
 #include <jsoncons_ext/csv/encode_csv.hpp>
+#include <jsoncons_ext/csv/csv_columns.hpp>
+#include <jsoncons_ext/csv/transcode_csv.hpp>
 
 #endif
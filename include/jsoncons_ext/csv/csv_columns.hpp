@@ -0,0 +1,734 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CSV_CSV_COLUMNS_HPP
+#define JSONCONS_CSV_CSV_COLUMNS_HPP
+
+#include <string>
+#include <vector>
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator
+#include <system_error>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/conv_error.hpp>
+#include <jsoncons/detail/write_number.hpp>
+#include <jsoncons_ext/csv/csv_options.hpp>
+#include <jsoncons_ext/csv/csv_reader.hpp>
+
+namespace jsoncons { namespace csv {
+
+    template <class CharT,class Allocator>
+    class basic_csv_columns_decoder;
+
+    // basic_csv_column
+
+    // The values of one column, held in a contiguous buffer of the column's type.
+    // Integer, float and boolean columns hold a placeholder for a null value (0, NaN or false),
+    // string columns hold an empty string. A column that receives values of different types is
+    // widened, integer to float, and otherwise to string.
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_csv_column
+    {
+        friend class basic_csv_columns_decoder<CharT,Allocator>;
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<CharT>;
+        using string_type = std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type>;
+        using integer_vector_type = std::vector<int64_t,typename std::allocator_traits<allocator_type>:: template rebind_alloc<int64_t>>;
+        using float_vector_type = std::vector<double,typename std::allocator_traits<allocator_type>:: template rebind_alloc<double>>;
+        using boolean_vector_type = std::vector<bool,typename std::allocator_traits<allocator_type>:: template rebind_alloc<bool>>;
+        using offset_vector_type = std::vector<std::size_t,typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::size_t>>;
+    private:
+        string_type name_;
+        csv_column_type type_;
+        bool typed_;
+        std::size_t size_;
+        boolean_vector_type nulls_;
+        integer_vector_type integers_;
+        float_vector_type floats_;
+        boolean_vector_type booleans_;
+        string_type strings_;
+        offset_vector_type offsets_;
+    public:
+        basic_csv_column(const string_view_type& name, const Allocator& alloc = Allocator())
+            : name_(name.data(), name.size(), alloc),
+              type_(csv_column_type::string_t),
+              typed_(false),
+              size_(0),
+              nulls_(alloc),
+              integers_(alloc),
+              floats_(alloc),
+              booleans_(alloc),
+              strings_(alloc),
+              offsets_(alloc)
+        {
+        }
+
+        const string_type& name() const
+        {
+            return name_;
+        }
+
+        // string_t for a column with only null values
+        csv_column_type type() const
+        {
+            return type_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool is_null(std::size_t i) const
+        {
+            return i < nulls_.size() && nulls_[i];
+        }
+
+        bool has_nulls() const
+        {
+            return !nulls_.empty();
+        }
+
+        const integer_vector_type& integer_values() const
+        {
+            return integers_;
+        }
+
+        const float_vector_type& float_values() const
+        {
+            return floats_;
+        }
+
+        const boolean_vector_type& boolean_values() const
+        {
+            return booleans_;
+        }
+
+        string_view_type string_value(std::size_t i) const
+        {
+            return string_view_type(strings_.data() + offsets_[i], offsets_[i+1] - offsets_[i]);
+        }
+
+        // The characters of all string values, value i is at [string_offsets()[i], string_offsets()[i+1])
+        const string_type& string_data() const
+        {
+            return strings_;
+        }
+
+        const offset_vector_type& string_offsets() const
+        {
+            return offsets_;
+        }
+
+    private:
+        void append_null()
+        {
+            if (nulls_.empty())
+            {
+                nulls_.resize(size_, false);
+            }
+            nulls_.push_back(true);
+            if (typed_)
+            {
+                append_placeholder();
+            }
+            else
+            {
+                // Until a value gives it a type, the column is a string column of empty strings
+                if (offsets_.empty())
+                {
+                    offsets_.push_back(0);
+                }
+                offsets_.push_back(strings_.size());
+            }
+            ++size_;
+        }
+
+        void append_integer(int64_t value)
+        {
+            set_type(csv_column_type::integer_t);
+            switch (type_)
+            {
+                case csv_column_type::integer_t:
+                    integers_.push_back(value);
+                    break;
+                case csv_column_type::float_t:
+                    floats_.push_back(static_cast<double>(value));
+                    break;
+                default:
+                    widen_to_string();
+                    jsoncons::detail::from_integer(value, strings_);
+                    offsets_.push_back(strings_.size());
+                    break;
+            }
+            after_value();
+        }
+
+        void append_uint64(uint64_t value)
+        {
+            if (value <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+            {
+                append_integer(static_cast<int64_t>(value));
+            }
+            else
+            {
+                append_float(static_cast<double>(value));
+            }
+        }
+
+        void append_float(double value)
+        {
+            set_type(csv_column_type::float_t);
+            if (type_ == csv_column_type::integer_t)
+            {
+                floats_.assign(integers_.begin(), integers_.end());
+                for (std::size_t i = 0; i < nulls_.size(); ++i)
+                {
+                    if (nulls_[i])
+                    {
+                        floats_[i] = std::numeric_limits<double>::quiet_NaN();
+                    }
+                }
+                integers_.clear();
+                integers_.shrink_to_fit();
+                type_ = csv_column_type::float_t;
+            }
+            if (type_ == csv_column_type::float_t)
+            {
+                floats_.push_back(value);
+            }
+            else
+            {
+                widen_to_string();
+                jsoncons::detail::write_double f{float_chars_format::general,0};
+                f(value, strings_);
+                offsets_.push_back(strings_.size());
+            }
+            after_value();
+        }
+
+        void append_boolean(bool value)
+        {
+            set_type(csv_column_type::boolean_t);
+            if (type_ == csv_column_type::boolean_t)
+            {
+                booleans_.push_back(value);
+            }
+            else
+            {
+                widen_to_string();
+                append_text(value ? true_literal() : false_literal());
+            }
+            after_value();
+        }
+
+        void append_string(const string_view_type& value)
+        {
+            set_type(csv_column_type::string_t);
+            widen_to_string();
+            append_text(value);
+            after_value();
+        }
+
+        void set_type(csv_column_type type)
+        {
+            if (!typed_)
+            {
+                type_ = type;
+                typed_ = true;
+                if (type_ == csv_column_type::string_t)
+                {
+                    // The offsets of any earlier nulls are already there
+                    if (offsets_.empty())
+                    {
+                        offsets_.push_back(0);
+                    }
+                }
+                else
+                {
+                    offsets_.clear();
+                    for (std::size_t i = 0; i < size_; ++i)
+                    {
+                        append_placeholder();
+                    }
+                }
+            }
+        }
+
+        void after_value()
+        {
+            if (!nulls_.empty())
+            {
+                nulls_.push_back(false);
+            }
+            ++size_;
+        }
+
+        void append_placeholder()
+        {
+            switch (type_)
+            {
+                case csv_column_type::integer_t:
+                    integers_.push_back(0);
+                    break;
+                case csv_column_type::float_t:
+                    floats_.push_back(std::numeric_limits<double>::quiet_NaN());
+                    break;
+                case csv_column_type::boolean_t:
+                    booleans_.push_back(false);
+                    break;
+                default:
+                    offsets_.push_back(strings_.size());
+                    break;
+            }
+        }
+
+        void append_text(const string_view_type& value)
+        {
+            strings_.append(value.data(), value.size());
+            offsets_.push_back(strings_.size());
+        }
+
+        void widen_to_string()
+        {
+            if (type_ == csv_column_type::string_t)
+            {
+                return;
+            }
+            offsets_.push_back(0);
+            for (std::size_t i = 0; i < size_; ++i)
+            {
+                if (!is_null(i))
+                {
+                    switch (type_)
+                    {
+                        case csv_column_type::integer_t:
+                            jsoncons::detail::from_integer(integers_[i], strings_);
+                            break;
+                        case csv_column_type::float_t:
+                        {
+                            jsoncons::detail::write_double f{float_chars_format::general,0};
+                            f(floats_[i], strings_);
+                            break;
+                        }
+                        case csv_column_type::boolean_t:
+                        {
+                            string_view_type s = booleans_[i] ? true_literal() : false_literal();
+                            strings_.append(s.data(), s.size());
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                }
+                offsets_.push_back(strings_.size());
+            }
+            integers_.clear();
+            integers_.shrink_to_fit();
+            floats_.clear();
+            floats_.shrink_to_fit();
+            booleans_.clear();
+            booleans_.shrink_to_fit();
+            type_ = csv_column_type::string_t;
+        }
+
+        static string_view_type true_literal()
+        {
+            static const CharT s[] = {'t','r','u','e'};
+            return string_view_type(s, 4);
+        }
+
+        static string_view_type false_literal()
+        {
+            static const CharT s[] = {'f','a','l','s','e'};
+            return string_view_type(s, 5);
+        }
+    };
+
+    // basic_csv_columns
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_csv_columns
+    {
+        friend class basic_csv_columns_decoder<CharT,Allocator>;
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using column_type = basic_csv_column<CharT,Allocator>;
+        using column_vector_type = std::vector<column_type,typename std::allocator_traits<allocator_type>:: template rebind_alloc<column_type>>;
+        using const_iterator = typename column_vector_type::const_iterator;
+    private:
+        column_vector_type columns_;
+        std::size_t row_count_;
+    public:
+        basic_csv_columns(const Allocator& alloc = Allocator())
+            : columns_(alloc), row_count_(0)
+        {
+        }
+
+        // Number of columns
+        std::size_t size() const
+        {
+            return columns_.size();
+        }
+
+        std::size_t row_count() const
+        {
+            return row_count_;
+        }
+
+        const column_type& operator[](std::size_t i) const
+        {
+            return columns_[i];
+        }
+
+        const_iterator begin() const
+        {
+            return columns_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return columns_.end();
+        }
+
+        // Returns end() if there is no column with this name
+        const_iterator find(const string_view_type& name) const
+        {
+            auto it = columns_.begin();
+            while (it != columns_.end() && string_view_type(it->name()) != name)
+            {
+                ++it;
+            }
+            return it;
+        }
+
+        const column_type& at(const string_view_type& name) const
+        {
+            auto it = find(name);
+            if (it == columns_.end())
+            {
+                JSONCONS_THROW(key_not_found(name.data(),name.length()));
+            }
+            return *it;
+        }
+    };
+
+    // basic_csv_columns_decoder
+
+    // Receives the rows of a n_rows or n_objects mapping and appends each value to the
+    // buffer of its column
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_csv_columns_decoder final : public basic_json_visitor<CharT>
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using typename basic_json_visitor<CharT>::string_view_type;
+        using result_type = basic_csv_columns<CharT,Allocator>;
+        using column_type = basic_csv_column<CharT,Allocator>;
+    private:
+        Allocator alloc_;
+        result_type result_;
+        int level_;
+        std::size_t column_index_;
+        bool is_valid_;
+    public:
+        basic_csv_columns_decoder(const Allocator& alloc = Allocator())
+            : alloc_(alloc),
+              result_(alloc),
+              level_(0),
+              column_index_(0),
+              is_valid_(false)
+        {
+        }
+
+        void reset()
+        {
+            result_ = result_type(alloc_);
+            level_ = 0;
+            column_index_ = 0;
+            is_valid_ = false;
+        }
+
+        bool is_valid() const
+        {
+            return is_valid_;
+        }
+
+        result_type get_result()
+        {
+            JSONCONS_ASSERT(is_valid_);
+            is_valid_ = false;
+            return std::move(result_);
+        }
+
+        // Number of rows decoded since the start or the last take_rows()
+        std::size_t row_count() const
+        {
+            return result_.row_count_;
+        }
+
+        // Returns the rows decoded so far and continues with the same columns, emptied
+        result_type take_rows()
+        {
+            result_type rows(alloc_);
+            for (const auto& column : result_.columns_)
+            {
+                rows.columns_.emplace_back(string_view_type(column.name()), alloc_);
+            }
+            std::swap(rows, result_);
+            return rows;
+        }
+
+    private:
+        void visit_flush() override
+        {
+        }
+
+        bool visit_begin_object(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (level_ != 1)
+            {
+                ec = conv_errc::conversion_failed;
+                return false;
+            }
+            begin_row();
+            return true;
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            end_row();
+            return true;
+        }
+
+        bool visit_begin_array(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            switch (level_)
+            {
+                case 0:
+                    level_ = 1;
+                    is_valid_ = false;
+                    return true;
+                case 1:
+                    begin_row();
+                    return true;
+                default:
+                    // subfields
+                    ec = conv_errc::conversion_failed;
+                    return false;
+            }
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            if (level_ == 2)
+            {
+                end_row();
+            }
+            else
+            {
+                level_ = 0;
+                is_valid_ = true;
+            }
+            return true;
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            auto& columns = result_.columns_;
+            if (!(column_index_ < columns.size() && string_view_type(columns[column_index_].name()) == name))
+            {
+                column_index_ = 0;
+                while (column_index_ < columns.size() && string_view_type(columns[column_index_].name()) != name)
+                {
+                    ++column_index_;
+                }
+                if (column_index_ == columns.size())
+                {
+                    add_column(name);
+                }
+            }
+            return true;
+        }
+
+        bool visit_null(semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!check_value(ec)) {return false;}
+            current_column().append_null();
+            ++column_index_;
+            return true;
+        }
+
+        bool visit_string(const string_view_type& value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!check_value(ec)) {return false;}
+            current_column().append_string(value);
+            ++column_index_;
+            return true;
+        }
+
+        bool visit_byte_string(const byte_string_view&, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            ec = conv_errc::conversion_failed;
+            return false;
+        }
+
+        bool visit_int64(int64_t value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!check_value(ec)) {return false;}
+            current_column().append_integer(value);
+            ++column_index_;
+            return true;
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!check_value(ec)) {return false;}
+            current_column().append_uint64(value);
+            ++column_index_;
+            return true;
+        }
+
+        bool visit_double(double value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!check_value(ec)) {return false;}
+            current_column().append_float(value);
+            ++column_index_;
+            return true;
+        }
+
+        bool visit_bool(bool value, semantic_tag, const ser_context&, std::error_code& ec) override
+        {
+            if (!check_value(ec)) {return false;}
+            current_column().append_boolean(value);
+            ++column_index_;
+            return true;
+        }
+
+        bool check_value(std::error_code& ec)
+        {
+            if (level_ != 2)
+            {
+                ec = conv_errc::conversion_failed;
+                return false;
+            }
+            return true;
+        }
+
+        column_type& current_column()
+        {
+            // Values without a key go to the next column
+            if (column_index_ == result_.columns_.size())
+            {
+                add_column(string_view_type());
+            }
+            return result_.columns_[column_index_];
+        }
+
+        void add_column(const string_view_type& name)
+        {
+            result_.columns_.emplace_back(name, alloc_);
+            column_type& column = result_.columns_.back();
+            for (std::size_t i = 0; i < result_.row_count_; ++i)
+            {
+                column.append_null();
+            }
+        }
+
+        void begin_row()
+        {
+            level_ = 2;
+            column_index_ = 0;
+        }
+
+        // Fills missing values with nulls, so all columns have the same size
+        void end_row()
+        {
+            ++result_.row_count_;
+            for (auto& column : result_.columns_)
+            {
+                if (column.size() < result_.row_count_)
+                {
+                    column.append_null();
+                }
+            }
+            level_ = 1;
+            column_index_ = 0;
+        }
+    };
+
+    namespace detail {
+
+        // Rows are read as objects when there are column names, otherwise as arrays,
+        // never as columns, which the parser would have to cache until the end of input.
+        // Unquoted empty values are read as null, so that they don't turn a numeric column
+        // into a string column.
+        template <class CharT>
+        basic_csv_options<CharT> columns_decode_options(const basic_csv_decode_options<CharT>& options)
+        {
+            basic_csv_options<CharT> result;
+            static_cast<basic_csv_decode_options<CharT>&>(result) = options;
+            result.mapping_kind(options.assume_header() || options.column_names().size() > 0 ? csv_mapping_kind::n_objects : csv_mapping_kind::n_rows);
+            result.unquoted_empty_value_is_null(true);
+            return result;
+        }
+
+    } // namespace detail
+
+    template <class Source,class Allocator=std::allocator<char>>
+    typename std::enable_if<extension_traits::is_sequence_of<Source,typename Source::value_type>::value,
+                            basic_csv_columns<typename Source::value_type,Allocator>>::type
+    decode_csv_columns(const Source& s,
+                       const basic_csv_decode_options<typename Source::value_type>& options = basic_csv_decode_options<typename Source::value_type>(),
+                       const Allocator& alloc = Allocator())
+    {
+        using char_type = typename Source::value_type;
+
+        basic_csv_columns_decoder<char_type,Allocator> decoder(alloc);
+
+        basic_csv_reader<char_type,jsoncons::string_source<char_type>> reader(s,decoder,detail::columns_decode_options(options));
+        reader.read();
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(ser_error(conv_errc::conversion_failed, reader.line(), reader.column()));
+        }
+        return decoder.get_result();
+    }
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    basic_csv_columns<CharT,Allocator> decode_csv_columns(std::basic_istream<CharT>& is,
+                                                          const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>(),
+                                                          const Allocator& alloc = Allocator())
+    {
+        basic_csv_columns_decoder<CharT,Allocator> decoder(alloc);
+
+        basic_csv_reader<CharT,jsoncons::stream_source<CharT>> reader(is,decoder,detail::columns_decode_options(options));
+        reader.read();
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(ser_error(conv_errc::conversion_failed, reader.line(), reader.column()));
+        }
+        return decoder.get_result();
+    }
+
+    using csv_column = basic_csv_column<char>;
+    using wcsv_column = basic_csv_column<wchar_t>;
+    using csv_columns = basic_csv_columns<char>;
+    using wcsv_columns = basic_csv_columns<wchar_t>;
+    using csv_columns_decoder = basic_csv_columns_decoder<char>;
+    using wcsv_columns_decoder = basic_csv_columns_decoder<wchar_t>;
+
+}}
+
+#endif
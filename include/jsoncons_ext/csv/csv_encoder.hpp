@@ -35,7 +35,7 @@ public:
     using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<CharT>;
     using string_type = std::basic_string<CharT, std::char_traits<CharT>, char_allocator_type>;
     using string_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<string_type>;
-    using string_string_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const string_type,string_type>>;
+    using string_size_t_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const string_type,std::size_t>>;
 
 private:
     static jsoncons::basic_string_view<CharT> null_constant()
@@ -95,8 +95,13 @@ private:
     jsoncons::detail::write_double fp_;
     std::vector<string_type,string_allocator_type> strings_buffer_;
 
-    std::unordered_map<string_type,string_type, std::hash<string_type>,std::equal_to<string_type>,string_string_allocator_type> buffered_line_;
-    string_type name_;
+    // Each column name resolves to a slot, the index of the first column with that name
+    std::unordered_map<string_type,std::size_t,std::hash<string_type>,std::equal_to<string_type>,string_size_t_allocator_type> column_slot_map_;
+    std::vector<std::size_t> column_slots_;
+    // The values of the current object row, cleared but not freed after each row
+    std::vector<string_type,string_allocator_type> row_values_;
+    std::size_t key_index_;
+    std::size_t slot_;
     std::size_t column_index_;
     std::vector<std::size_t> row_counts_;
 
@@ -118,9 +123,15 @@ public:
         alloc_(alloc),
         stack_(),
         fp_(options.float_format(), options.precision()),
+        key_index_(0),
+        slot_(0),
         column_index_(0)
     {
         jsoncons::csv::detail::parse_column_names(options.column_names(), strings_buffer_);
+        for (std::size_t i = 0; i < strings_buffer_.size(); ++i)
+        {
+            add_column_slot(i);
+        }
     }
 
     ~basic_csv_encoder() noexcept
@@ -138,8 +149,11 @@ public:
     {
         stack_.clear();
         strings_buffer_.clear();
-        buffered_line_.clear();
-        name_.clear();
+        column_slot_map_.clear();
+        column_slots_.clear();
+        row_values_.clear();
+        key_index_ = 0;
+        slot_ = 0;
         column_index_ = 0;
         row_counts_.clear();
     }
@@ -191,6 +205,7 @@ private:
         {
             case stack_item_kind::row_mapping:
                 stack_.emplace_back(stack_item_kind::object);
+                key_index_ = 0;
                 return true;
             default: // error
                 ec = csv_errc::source_error;
@@ -225,12 +240,9 @@ private:
                     {
                         sink_.push_back(options_.field_delimiter());
                     }
-                    auto it = buffered_line_.find(strings_buffer_[i]);
-                    if (it != buffered_line_.end())
-                    {
-                        sink_.append(it->second.data(),it->second.length());
-                        it->second.clear();
-                    }
+                    string_type& value = row_values_[column_slots_[i]];
+                    sink_.append(value.data(),value.length());
+                    value.clear();
                 }
                 sink_.append(options_.line_delimiter().data(), options_.line_delimiter().length());
                 break;
@@ -345,11 +357,15 @@ private:
         {
             case stack_item_kind::object:
             {
-                name_ = string_type(name);
-                buffered_line_[string_type(name)] = std::basic_string<CharT>();
                 if (stack_[0].count_ == 0 && options_.column_names().size() == 0)
                 {
                     strings_buffer_.emplace_back(name);
+                    add_column_slot(strings_buffer_.size() - 1);
+                }
+                slot_ = find_column_slot(name);
+                if (slot_ < row_values_.size())
+                {
+                    row_values_[slot_].clear();
                 }
                 break;
             }
@@ -380,18 +396,11 @@ private:
             case stack_item_kind::object:
             case stack_item_kind::object_multi_valued_field:
             {
-                auto it = buffered_line_.find(name_);
-                if (it != buffered_line_.end())
+                string_type* value = begin_field_value();
+                if (value != nullptr)
                 {
-                    std::basic_string<CharT> s;
-                    jsoncons::string_sink<std::basic_string<CharT>> bo(s);
+                    jsoncons::string_sink<string_type> bo(*value);
                     write_null_value(bo);
-                    bo.flush();
-                    if (!it->second.empty() && options_.subfield_delimiter() != char_type())
-                    {
-                        it->second.push_back(options_.subfield_delimiter());
-                    }
-                    it->second.append(s);
                 }
                 break;
             }
@@ -429,18 +438,11 @@ private:
             case stack_item_kind::object:
             case stack_item_kind::object_multi_valued_field:
             {
-                auto it = buffered_line_.find(name_);
-                if (it != buffered_line_.end())
+                string_type* value = begin_field_value();
+                if (value != nullptr)
                 {
-                    std::basic_string<CharT> s;
-                    jsoncons::string_sink<std::basic_string<CharT>> bo(s);
+                    jsoncons::string_sink<string_type> bo(*value);
                     write_string_value(sv,bo);
-                    bo.flush();
-                    if (!it->second.empty() && options_.subfield_delimiter() != char_type())
-                    {
-                        it->second.push_back(options_.subfield_delimiter());
-                    }
-                    it->second.append(s);
                 }
                 break;
             }
@@ -534,18 +536,11 @@ private:
             case stack_item_kind::object:
             case stack_item_kind::object_multi_valued_field:
             {
-                auto it = buffered_line_.find(name_);
-                if (it != buffered_line_.end())
+                string_type* value = begin_field_value();
+                if (value != nullptr)
                 {
-                    std::basic_string<CharT> s;
-                    jsoncons::string_sink<std::basic_string<CharT>> bo(s);
+                    jsoncons::string_sink<string_type> bo(*value);
                     write_double_value(val, context, bo, ec);
-                    bo.flush();
-                    if (!it->second.empty() && options_.subfield_delimiter() != char_type())
-                    {
-                        it->second.push_back(options_.subfield_delimiter());
-                    }
-                    it->second.append(s);
                 }
                 break;
             }
@@ -586,18 +581,11 @@ private:
             case stack_item_kind::object:
             case stack_item_kind::object_multi_valued_field:
             {
-                auto it = buffered_line_.find(name_);
-                if (it != buffered_line_.end())
+                string_type* value = begin_field_value();
+                if (value != nullptr)
                 {
-                    std::basic_string<CharT> s;
-                    jsoncons::string_sink<std::basic_string<CharT>> bo(s);
+                    jsoncons::string_sink<string_type> bo(*value);
                     write_int64_value(val,bo);
-                    bo.flush();
-                    if (!it->second.empty() && options_.subfield_delimiter() != char_type())
-                    {
-                        it->second.push_back(options_.subfield_delimiter());
-                    }
-                    it->second.append(s);
                 }
                 break;
             }
@@ -638,18 +626,11 @@ private:
             case stack_item_kind::object:
             case stack_item_kind::object_multi_valued_field:
             {
-                auto it = buffered_line_.find(name_);
-                if (it != buffered_line_.end())
+                string_type* value = begin_field_value();
+                if (value != nullptr)
                 {
-                    std::basic_string<CharT> s;
-                    jsoncons::string_sink<std::basic_string<CharT>> bo(s);
+                    jsoncons::string_sink<string_type> bo(*value);
                     write_uint64_value(val, bo);
-                    bo.flush();
-                    if (!it->second.empty() && options_.subfield_delimiter() != char_type())
-                    {
-                        it->second.push_back(options_.subfield_delimiter());
-                    }
-                    it->second.append(s);
                 }
                 break;
             }
@@ -687,18 +668,11 @@ private:
             case stack_item_kind::object:
             case stack_item_kind::object_multi_valued_field:
             {
-                auto it = buffered_line_.find(name_);
-                if (it != buffered_line_.end())
+                string_type* value = begin_field_value();
+                if (value != nullptr)
                 {
-                    std::basic_string<CharT> s;
-                    jsoncons::string_sink<std::basic_string<CharT>> bo(s);
+                    jsoncons::string_sink<string_type> bo(*value);
                     write_bool_value(val,bo);
-                    bo.flush();
-                    if (!it->second.empty() && options_.subfield_delimiter() != char_type())
-                    {
-                        it->second.push_back(options_.subfield_delimiter());
-                    }
-                    it->second.append(s);
                 }
                 break;
             }
@@ -728,6 +702,41 @@ private:
         return true;
     }
 
+    void add_column_slot(std::size_t index)
+    {
+        auto result = column_slot_map_.emplace(strings_buffer_[index], index);
+        column_slots_.push_back(result.first->second);
+        row_values_.emplace_back();
+    }
+
+    // Keys are expected in column order, others are looked up by name
+    std::size_t find_column_slot(const string_view_type& name)
+    {
+        std::size_t index = key_index_++;
+        if (index < strings_buffer_.size() && string_view_type(strings_buffer_[index]) == name)
+        {
+            return column_slots_[index];
+        }
+        auto it = column_slot_map_.find(string_type(name.data(), name.size()));
+        return it != column_slot_map_.end() ? it->second : (std::numeric_limits<std::size_t>::max)();
+    }
+
+    // Returns the value of the current field, after a subfield delimiter if it already has a value,
+    // or null if the field is not in a column
+    string_type* begin_field_value()
+    {
+        if (slot_ >= row_values_.size())
+        {
+            return nullptr;
+        }
+        string_type& value = row_values_[slot_];
+        if (!value.empty() && options_.subfield_delimiter() != char_type())
+        {
+            value.push_back(options_.subfield_delimiter());
+        }
+        return &value;
+    }
+
     template <class AnyWriter>
     bool do_string_value(const CharT* s, std::size_t length, AnyWriter& sink)
     {
@@ -497,6 +497,8 @@ public:
 
     basic_csv_decode_options(const basic_csv_decode_options& other) = default;
 
+    basic_csv_decode_options& operator=(const basic_csv_decode_options& other) = default;
+
     basic_csv_decode_options(basic_csv_decode_options&& other)
         : super_type(std::move(other)),
           assume_header_(other.assume_header_),
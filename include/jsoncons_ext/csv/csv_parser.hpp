@@ -20,6 +20,7 @@
 #include <jsoncons/json_filter.hpp>
 #include <jsoncons/json.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/find_chars.hpp>
 #include <jsoncons_ext/csv/csv_error.hpp>
 #include <jsoncons_ext/csv/csv_options.hpp>
 
@@ -499,16 +500,6 @@ public:
     using string_view_type = jsoncons::basic_string_view<CharT>;
     using char_type = CharT;
 private:
-    struct string_maps_to_double
-    {
-        string_view_type s;
-
-        bool operator()(const std::pair<string_view_type,double>& val) const
-        {
-            return val.first == s;
-        }
-    };
-
     using temp_allocator_type = TempAllocator;
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
     using string_type = std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type>;
@@ -517,6 +508,7 @@ private:
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<csv_type_info> csv_type_info_allocator_type;
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<std::vector<string_type,string_allocator_type>> string_vector_allocator_type;
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<csv_parse_state> csv_parse_state_allocator_type;
+    typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<std::size_t> size_t_allocator_type;
 
     static constexpr int default_depth = 3;
 
@@ -546,6 +538,11 @@ private:
     std::vector<csv_parse_state,csv_parse_state_allocator_type> state_stack_;
     string_type buffer_;
     std::vector<std::pair<std::basic_string<char_type>,double>> string_double_map_;
+    bool lock_numeric_columns_;
+    std::vector<std::size_t,size_t_allocator_type> numeric_runs_;
+    std::string number_buffer_;
+    jsoncons::detail::char_set<CharT> unquoted_specials_;
+    jsoncons::detail::char_set<CharT> quoted_specials_;
 
 public:
     basic_csv_parser(const TempAllocator& alloc = TempAllocator())
@@ -596,7 +593,11 @@ public:
          column_types_(alloc),
          column_defaults_(alloc),
          state_stack_(alloc),
-         buffer_(alloc)
+         buffer_(alloc),
+         lock_numeric_columns_(true),
+         numeric_runs_(alloc),
+         unquoted_specials_(make_unquoted_specials(options)),
+         quoted_specials_(make_quoted_specials(options))
     {
         if (options_.enable_str_to_nan())
         {
@@ -610,6 +611,16 @@ public:
         {
             string_double_map_.emplace_back(options_.neginf_to_str(),-std::numeric_limits<double>::infinity());
         }
+        // Trying a value as a number first must not bypass a replacement string that looks like a number
+        for (const auto& item : string_double_map_)
+        {
+            inferred_value val;
+            classify_number(item.first.data(), item.first.data() + item.first.size(), val);
+            if (val.state != numeric_check_state::not_a_number)
+            {
+                lock_numeric_columns_ = false;
+            }
+        }
 
         initialize();
     }
@@ -665,6 +676,7 @@ public:
         column_defaults_.clear();
         state_stack_.clear();
         buffer_.clear();
+        numeric_runs_.clear();
 
         initialize();
     }
@@ -920,18 +932,20 @@ public:
                         if (curr_char == options_.quote_escape_char())
                         {
                             state_ = csv_parse_state::escaped_value;
+                            ++column_;
+                            ++input_ptr_;
                         }
                         else if (curr_char == options_.quote_char())
                         {
                             state_ = csv_parse_state::between_values;
+                            ++column_;
+                            ++input_ptr_;
                         }
                         else
                         {
-                            buffer_.push_back(static_cast<CharT>(curr_char));
+                            append_run(quoted_specials_, local_input_end);
                         }
                     }
-                    ++column_;
-                    ++input_ptr_;
                     break;
                 case csv_parse_state::escaped_value: 
                     {
@@ -1154,9 +1168,7 @@ public:
                             }
                             else
                             {
-                                buffer_.push_back(static_cast<CharT>(curr_char));
-                                ++column_;
-                                ++input_ptr_;
+                                append_run(unquoted_specials_, local_input_end);
                             }
                             break;
                     }
@@ -1321,6 +1333,32 @@ public:
     }
 
 private:
+    // Characters that end a run of an unquoted value
+    static jsoncons::detail::char_set<CharT> make_unquoted_specials(const basic_csv_decode_options<CharT>& options)
+    {
+        const CharT chars[] = {'\n', '\r', options.field_delimiter(), options.quote_char(), 
+                               options.subfield_delimiter() != char_type() ? options.subfield_delimiter() : CharT('\n')};
+        return jsoncons::detail::char_set<CharT>(chars, 5);
+    }
+
+    // Characters that end a run of a quoted value
+    static jsoncons::detail::char_set<CharT> make_quoted_specials(const basic_csv_decode_options<CharT>& options)
+    {
+        const CharT chars[] = {options.quote_char(), options.quote_escape_char()};
+        return jsoncons::detail::char_set<CharT>(chars, 2);
+    }
+
+    // Appends the current character, and the characters after it up to the next special 
+    // character or the end of the input, to buffer_
+    void append_run(const jsoncons::detail::char_set<CharT>& specials, const CharT* local_input_end)
+    {
+        const CharT* run_end = jsoncons::detail::find_first_of(input_ptr_ + 1, local_input_end, specials);
+        const std::size_t length = static_cast<std::size_t>(run_end - input_ptr_);
+        buffer_.append(input_ptr_, length);
+        column_ += length;
+        input_ptr_ = run_end;
+    }
+
     void initialize()
     {
         jsoncons::csv::detail::parse_column_names(options_.column_names(), column_names_);
@@ -1629,10 +1667,24 @@ private:
 
     void end_value(bool infer_types, std::error_code&  ec)
     {
-        auto it = std::find_if(string_double_map_.begin(), string_double_map_.end(), string_maps_to_double{ buffer_ });
-        if (it != string_double_map_.end())
+        // A column whose recent values were all numbers tries a number first
+        if (infer_types && lock_numeric_columns_ && column_types_.empty() &&
+            column_index_ < numeric_runs_.size() && numeric_runs_[column_index_] >= numeric_lock_threshold)
         {
-            more_ = visitor_->double_value(it->second, semantic_tag::none, *this, ec);
+            inferred_value val;
+            classify_number(buffer_.data(), buffer_.data() + buffer_.size(), val);
+            if (val.state != numeric_check_state::not_a_number)
+            {
+                end_inferred_value(val, ec);
+                return;
+            }
+            numeric_runs_[column_index_] = 0;
+        }
+
+        double special_value;
+        if (find_special_value(special_value))
+        {
+            more_ = visitor_->double_value(special_value, semantic_tag::none, *this, ec);
         }
         else if (column_index_ < column_types_.size() + offset_)
         {
@@ -1693,8 +1745,13 @@ private:
                         }
                         else
                         {
-                            std::basic_istringstream<CharT, std::char_traits<CharT>, char_allocator_type> iss{ buffer_ };
                             double val;
+                            if (jsoncons::detail::decimal_to_double(buffer_.data(), buffer_.data() + buffer_.size(), val))
+                            {
+                                more_ = visitor_->double_value(val, semantic_tag::none, *this, ec);
+                                break;
+                            }
+                            std::basic_istringstream<CharT, std::char_traits<CharT>, char_allocator_type> iss{ buffer_ };
                             iss >> val;
                             if (!iss.fail())
                             {
@@ -1777,7 +1834,10 @@ private:
         {
             if (infer_types)
             {
-                end_value_with_numeric_check(ec);
+                inferred_value val;
+                classify_value(val);
+                update_numeric_run(val.state);
+                end_inferred_value(val, ec);
             }
             else
             {
@@ -1788,225 +1848,204 @@ private:
 
     enum class numeric_check_state 
     {
-        initial,
         null,
         boolean_true,
         boolean_false,
-        minus,
-        zero,
         integer,
-        fraction1,
-        fraction,
-        exp1,
-        exp,
+        floating,
         not_a_number
     };
 
-    /*
-        xxx_value 
-    */
-    void end_value_with_numeric_check(std::error_code& ec)
+    struct inferred_value
     {
-        numeric_check_state state = numeric_check_state::initial;
-        bool is_negative = false;
-        //int precision = 0;
-        //uint8_t decimal_places = 0;
+        numeric_check_state state;
+        bool is_negative;
+        bool overflow;
+        uint64_t magnitude;
+        jsoncons::detail::decimal_accumulator digits;
+
+        inferred_value()
+            : state(numeric_check_state::not_a_number), is_negative(false), overflow(false), magnitude(0)
+        {
+        }
+    };
 
-        auto last = buffer_.end();
+    // Number of consecutive numbers in a column after which its values are tried as numbers first
+    static constexpr std::size_t numeric_lock_threshold = 8;
 
-        std::string buffer;
-        for (auto p = buffer_.begin(); state != numeric_check_state::not_a_number && p != last; ++p)
+    // The special value strings are compared only when the lengths match
+    bool find_special_value(double& value) const
+    {
+        for (const auto& item : string_double_map_)
         {
-            switch (state)
+            if (item.first.size() == buffer_.size() && std::char_traits<CharT>::compare(item.first.data(), buffer_.data(), buffer_.size()) == 0)
             {
-                case numeric_check_state::initial:
-                {
-                    switch (*p)
-                    {
-                    case 'n':case 'N':
-                        if ((last-p) == 4 && (p[1] == 'u' || p[1] == 'U') && (p[2] == 'l' || p[2] == 'L') && (p[3] == 'l' || p[3] == 'L'))
-                        {
-                            state = numeric_check_state::null;
-                        }
-                        else
-                        {
-                            state = numeric_check_state::not_a_number;
-                        }
-                        break;
-                    case 't':case 'T':
-                        if ((last-p) == 4 && (p[1] == 'r' || p[1] == 'R') && (p[2] == 'u' || p[2] == 'U') && (p[3] == 'e' || p[3] == 'U'))
-                        {
-                            state = numeric_check_state::boolean_true;
-                        }
-                        else
-                        {
-                            state = numeric_check_state::not_a_number;
-                        }
-                        break;
-                    case 'f':case 'F':
-                        if ((last-p) == 5 && (p[1] == 'a' || p[1] == 'A') && (p[2] == 'l' || p[2] == 'L') && (p[3] == 's' || p[3] == 'S') && (p[4] == 'e' || p[4] == 'E'))
-                        {
-                            state = numeric_check_state::boolean_false;
-                        }
-                        else
-                        {
-                            state = numeric_check_state::not_a_number;
-                        }
-                        break;
-                    case '-':
-                        is_negative = true;
-                        buffer.push_back(*p);
-                        state = numeric_check_state::minus;
-                        break;
-                    case '0':
-                        //++precision;
-                        buffer.push_back(*p);
-                        state = numeric_check_state::zero;
-                        break;
-                    case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
-                        //++precision;
-                        buffer.push_back(*p);
-                        state = numeric_check_state::integer;
-                        break;
-                    default:
-                        state = numeric_check_state::not_a_number;
-                        break;
-                    }
-                    break;
-                }
-                case numeric_check_state::zero:
-                {
-                    switch (*p)
-                    {
-                    case '.':
-                        buffer.push_back(to_double_.get_decimal_point());
-                        state = numeric_check_state::fraction1;
-                        break;
-                    case 'e':case 'E':
-                        buffer.push_back(*p);
-                        state = numeric_check_state::exp1;
-                        break;
-                    default:
-                        state = numeric_check_state::not_a_number;
-                        break;
-                    }
-                    break;
-                }
-                case numeric_check_state::integer:
-                {
-                    switch (*p)
-                    {
-                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
-                        //++precision;
-                        buffer.push_back(*p);
-                        break;
-                    case '.':
-                        buffer.push_back(to_double_.get_decimal_point());
-                        state = numeric_check_state::fraction1;
-                        break;
-                    case 'e':case 'E':
-                        buffer.push_back(*p);
-                        state = numeric_check_state::exp1;
-                        break;
-                    default:
-                        state = numeric_check_state::not_a_number;
-                        break;
-                    }
-                    break;
-                }
-                case numeric_check_state::minus:
+                value = item.second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void update_numeric_run(numeric_check_state state)
+    {
+        if (!lock_numeric_columns_ || !column_types_.empty())
+        {
+            return;
+        }
+        if (column_index_ >= numeric_runs_.size())
+        {
+            numeric_runs_.resize(column_index_ + 1, 0);
+        }
+        if (state == numeric_check_state::integer || state == numeric_check_state::floating)
+        {
+            if (numeric_runs_[column_index_] < numeric_lock_threshold)
+            {
+                ++numeric_runs_[column_index_];
+            }
+        }
+        else
+        {
+            numeric_runs_[column_index_] = 0;
+        }
+    }
+
+    static bool equals_ignore_case(const CharT* p, const char* lower, std::size_t length)
+    {
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (p[i] != lower[i] && p[i] != lower[i] - ('a' - 'A'))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool is_digit(CharT c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // Classifies [p,last) as an integer, a floating point number, or not a number, 
+    // accumulating the magnitude of an integer, or the digits of a floating point number, in the same pass
+    static void classify_number(const CharT* p, const CharT* last, inferred_value& val)
+    {
+        val = inferred_value();
+        if (p != last && *p == '-')
+        {
+            val.is_negative = true;
+            ++p;
+        }
+        if (p == last)
+        {
+            return;
+        }
+        if (*p == '0')
+        {
+            ++p;
+        }
+        else if (*p >= '1' && *p <= '9')
+        {
+            for (; p != last && is_digit(*p); ++p)
+            {
+                uint64_t d = static_cast<uint64_t>(*p - '0');
+                val.digits.integer_digit(static_cast<unsigned>(d));
+                if (val.magnitude > ((std::numeric_limits<uint64_t>::max)() - d) / 10)
                 {
-                    switch (*p)
-                    {
-                    case '0':
-                        //++precision;
-                        buffer.push_back(*p);
-                        state = numeric_check_state::zero;
-                        break;
-                    case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
-                        //++precision;
-                        buffer.push_back(*p);
-                        state = numeric_check_state::integer;
-                        break;
-                    default:
-                        state = numeric_check_state::not_a_number;
-                        break;
-                    }
-                    break;
+                    val.overflow = true;
                 }
-                case numeric_check_state::fraction1:
+                else
                 {
-                    switch (*p)
-                    {
-                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
-                        //++precision;
-                        //++decimal_places;
-                        buffer.push_back(*p);
-                        state = numeric_check_state::fraction;
-                        break;
-                    default:
-                        state = numeric_check_state::not_a_number;
-                        break;
-                    }
-                    break;
+                    val.magnitude = val.magnitude*10 + d;
                 }
-                case numeric_check_state::fraction:
+            }
+        }
+        else
+        {
+            return;
+        }
+        if (p == last)
+        {
+            val.state = numeric_check_state::integer;
+            return;
+        }
+        if (*p == '.')
+        {
+            ++p;
+            if (p == last || !is_digit(*p))
+            {
+                return;
+            }
+            while (p != last && is_digit(*p))
+            {
+                val.digits.fraction_digit(static_cast<unsigned>(*p - '0'));
+                ++p;
+            }
+        }
+        if (p != last && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            if (p != last && (*p == '-' || *p == '+'))
+            {
+                val.digits.exponent_sign(*p == '-');
+                ++p;
+            }
+            if (p == last || !is_digit(*p))
+            {
+                return;
+            }
+            while (p != last && is_digit(*p))
+            {
+                val.digits.exponent_digit(static_cast<unsigned>(*p - '0'));
+                ++p;
+            }
+        }
+        if (p == last)
+        {
+            val.state = numeric_check_state::floating;
+        }
+    }
+
+    void classify_value(inferred_value& val) const
+    {
+        const CharT* p = buffer_.data();
+        const std::size_t length = buffer_.size();
+
+        val = inferred_value();
+        if (length == 0)
+        {
+            return;
+        }
+        switch (*p)
+        {
+            case 'n':case 'N':
+                if (length == 4 && equals_ignore_case(p, "null", 4))
                 {
-                    switch (*p)
-                    {
-                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
-                        //++precision;
-                        //++decimal_places;
-                        buffer.push_back(*p);
-                        break;
-                    case 'e':case 'E':
-                        buffer.push_back(*p);
-                        state = numeric_check_state::exp1;
-                        break;
-                    default:
-                        state = numeric_check_state::not_a_number;
-                        break;
-                    }
-                    break;
+                    val.state = numeric_check_state::null;
                 }
-                case numeric_check_state::exp1:
+                break;
+            case 't':case 'T':
+                if (length == 4 && equals_ignore_case(p, "true", 4))
                 {
-                    switch (*p)
-                    {
-                    case '-':
-                        buffer.push_back(*p);
-                        break;
-                    case '+':
-                        break;
-                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
-                        state = numeric_check_state::exp;
-                        buffer.push_back(*p);
-                        break;
-                    default:
-                        state = numeric_check_state::not_a_number;
-                        break;
-                    }
-                    break;
+                    val.state = numeric_check_state::boolean_true;
                 }
-                case numeric_check_state::exp:
+                break;
+            case 'f':case 'F':
+                if (length == 5 && equals_ignore_case(p, "false", 5))
                 {
-                    switch (*p)
-                    {
-                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
-                        buffer.push_back(*p);
-                        break;
-                    default:
-                        state = numeric_check_state::not_a_number;
-                        break;
-                    }
-                    break;
+                    val.state = numeric_check_state::boolean_false;
                 }
-                default:
-                    break;
-            }
+                break;
+            default:
+                classify_number(p, p + length, val);
+                break;
         }
+    }
 
-        switch (state)
+    void end_inferred_value(const inferred_value& val, std::error_code& ec)
+    {
+        switch (val.state)
         {
             case numeric_check_state::null:
                 more_ = visitor_->null_value(semantic_tag::none, *this, ec);
@@ -2017,45 +2056,25 @@ private:
             case numeric_check_state::boolean_false:
                 more_ = visitor_->bool_value(false, semantic_tag::none, *this, ec);
                 break;
-            case numeric_check_state::zero:
             case numeric_check_state::integer:
             {
-                if (is_negative)
+                const uint64_t max_negative = static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()) + 1;
+                if (val.overflow || (val.is_negative && val.magnitude > max_negative))
                 {
-                    int64_t val{ 0 };
-                    auto result = jsoncons::detail::to_integer_decimal(buffer_.data(), buffer_.length(), val);
-                    if (result)
-                    {
-                        more_ = visitor_->int64_value(val, semantic_tag::none, *this, ec);
-                    }
-                    else // Must be overflow
-                    {
-                        more_ = visitor_->string_value(buffer_, semantic_tag::bigint, *this, ec);
-                    }
+                    more_ = visitor_->string_value(buffer_, semantic_tag::bigint, *this, ec);
+                }
+                else if (val.is_negative)
+                {
+                    int64_t n = val.magnitude == 0 ? 0 : -static_cast<int64_t>(val.magnitude - 1) - 1;
+                    more_ = visitor_->int64_value(n, semantic_tag::none, *this, ec);
                 }
                 else
                 {
-                    uint64_t val{ 0 };
-                    auto result = jsoncons::detail::to_integer_decimal(buffer_.data(), buffer_.length(), val);
-                    if (result)
-                    {
-                        more_ = visitor_->uint64_value(val, semantic_tag::none, *this, ec);
-                    }
-                    else if (result.ec == jsoncons::detail::to_integer_errc::overflow)
-                    {
-                        more_ = visitor_->string_value(buffer_, semantic_tag::bigint, *this, ec);
-                    }
-                    else
-                    {
-                        ec = result.ec;
-                        more_ = false;
-                        return;
-                    }
+                    more_ = visitor_->uint64_value(val.magnitude, semantic_tag::none, *this, ec);
                 }
                 break;
             }
-            case numeric_check_state::fraction:
-            case numeric_check_state::exp:
+            case numeric_check_state::floating:
             {
                 if (options_.lossless_number())
                 {
@@ -2063,7 +2082,11 @@ private:
                 }
                 else
                 {
-                    double d = to_double_(buffer.c_str(), buffer.length());
+                    double d;
+                    if (!val.digits.to_double(val.is_negative, d))
+                    {
+                        d = buffer_to_double(std::integral_constant<bool,std::is_same<CharT,char>::value>());
+                    }
                     more_ = visitor_->double_value(d, semantic_tag::none, *this, ec);
                 }
                 break;
@@ -2076,6 +2099,26 @@ private:
         }
     } 
 
+    double buffer_to_double(std::true_type)
+    {
+        if (to_double_.get_decimal_point() == '.')
+        {
+            return to_double_(buffer_.c_str(), buffer_.length());
+        }
+        return buffer_to_double(std::false_type());
+    }
+
+    // Copies to a narrow buffer with the locale's decimal point
+    double buffer_to_double(std::false_type)
+    {
+        number_buffer_.clear();
+        for (auto c : buffer_)
+        {
+            number_buffer_.push_back(c == '.' ? to_double_.get_decimal_point() : static_cast<char>(c));
+        }
+        return to_double_(number_buffer_.c_str(), number_buffer_.length());
+    }
+
     void push_state(csv_parse_state state)
     {
         state_stack_.push_back(state);
@@ -0,0 +1,994 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CSV_PARALLEL_CSV_READER_HPP
+#define JSONCONS_CSV_PARALLEL_CSV_READER_HPP
+
+#include <cstring> // std::memcpy
+#include <string>
+#include <vector>
+#include <algorithm> // std::find_if
+#include <utility> // std::pair
+#include <istream>
+#include <iterator>
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator
+#include <system_error>
+#include <thread>
+#include <exception> // std::exception_ptr
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/staj_cursor.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/detail/find_chars.hpp>
+#include <jsoncons_ext/csv/csv_options.hpp>
+#include <jsoncons_ext/csv/csv_parser.hpp>
+
+namespace jsoncons { namespace csv {
+
+namespace detail {
+
+    enum class csv_record_kind {record, comment, empty_line};
+
+    // Finds record boundaries in CSV text with the quoting rules of basic_csv_parser,
+    // so that a line break inside a quoted value is not taken for the end of a record
+
+    template <class CharT>
+    class csv_record_scanner
+    {
+        const CharT* ptr_;
+        const CharT* end_;
+        CharT quote_char_;
+        CharT quote_escape_char_;
+        CharT comment_starter_;
+        jsoncons::detail::char_set<CharT> unquoted_specials_;
+        jsoncons::detail::char_set<CharT> quoted_specials_;
+        std::size_t line_breaks_;
+    public:
+        csv_record_scanner(const CharT* data, std::size_t length, const basic_csv_decode_options<CharT>& options)
+            : ptr_(data), end_(data + length),
+              quote_char_(options.quote_char()),
+              quote_escape_char_(options.quote_escape_char()),
+              comment_starter_(options.comment_starter()),
+              unquoted_specials_(make_unquoted_specials(options)),
+              quoted_specials_(make_quoted_specials(options)),
+              line_breaks_(0)
+        {
+        }
+
+        bool done() const
+        {
+            return ptr_ == end_;
+        }
+
+        const CharT* position() const
+        {
+            return ptr_;
+        }
+
+        // Line breaks passed so far, counted as basic_csv_parser counts lines
+        std::size_t line_breaks() const
+        {
+            return line_breaks_;
+        }
+
+        // Advances past the record or comment that starts at the current position, and its line break
+        csv_record_kind skip_record()
+        {
+            const CharT* start = ptr_;
+            if (ptr_ != end_ && comment_starter_ != CharT() && *ptr_ == comment_starter_)
+            {
+                while (ptr_ != end_ && *ptr_ != '\n' && *ptr_ != '\r')
+                {
+                    ++ptr_;
+                }
+                skip_line_break();
+                return csv_record_kind::comment;
+            }
+
+            bool quoted = false;
+            while (ptr_ != end_)
+            {
+                if (!quoted)
+                {
+                    ptr_ = jsoncons::detail::find_first_of(ptr_, end_, unquoted_specials_);
+                    if (ptr_ == end_)
+                    {
+                        break;
+                    }
+                    if (*ptr_ == quote_char_)
+                    {
+                        quoted = true;
+                        ++ptr_;
+                    }
+                    else
+                    {
+                        bool empty = ptr_ == start;
+                        skip_line_break();
+                        return empty ? csv_record_kind::empty_line : csv_record_kind::record;
+                    }
+                }
+                else
+                {
+                    ptr_ = jsoncons::detail::find_first_of(ptr_, end_, quoted_specials_);
+                    if (ptr_ == end_)
+                    {
+                        break;
+                    }
+                    if (quote_escape_char_ != quote_char_ && *ptr_ == quote_escape_char_)
+                    {
+                        ptr_ += (end_ - ptr_ >= 2) ? 2 : 1;
+                    }
+                    else if (quote_escape_char_ == quote_char_ && end_ - ptr_ >= 2 && ptr_[1] == quote_char_)
+                    {
+                        ptr_ += 2;
+                    }
+                    else
+                    {
+                        quoted = false;
+                        ++ptr_;
+                    }
+                }
+            }
+            return ptr_ == start ? csv_record_kind::empty_line : csv_record_kind::record;
+        }
+    private:
+        void skip_line_break()
+        {
+            if (ptr_ == end_)
+            {
+                return;
+            }
+            if (*ptr_ == '\r')
+            {
+                ++ptr_;
+                if (ptr_ != end_ && *ptr_ == '\n')
+                {
+                    ++ptr_;
+                }
+            }
+            else
+            {
+                ++ptr_;
+            }
+            ++line_breaks_;
+        }
+
+        static jsoncons::detail::char_set<CharT> make_unquoted_specials(const basic_csv_decode_options<CharT>& options)
+        {
+            const CharT chars[] = {'\n', '\r', options.quote_char()};
+            return jsoncons::detail::char_set<CharT>(chars, 3);
+        }
+
+        static jsoncons::detail::char_set<CharT> make_quoted_specials(const basic_csv_decode_options<CharT>& options)
+        {
+            const CharT chars[] = {options.quote_char(), options.quote_escape_char()};
+            return jsoncons::detail::char_set<CharT>(chars, 2);
+        }
+    };
+
+    // Records the events of a parse, so that they can be sent to a visitor later, in whole or
+    // in part. Strings are kept in one buffer. For begin_array and begin_object, length holds
+    // the index of the event after the matching end_array or end_object.
+
+    template <class CharT,class TempAllocator>
+    class csv_event_buffer final : public basic_json_visitor<CharT>
+    {
+    public:
+        using string_view_type = typename basic_json_visitor<CharT>::string_view_type;
+    private:
+        struct event
+        {
+            staj_event_type event_type;
+            semantic_tag tag;
+            union
+            {
+                bool bool_value;
+                int64_t int64_value;
+                uint64_t uint64_value;
+                uint16_t half_value;
+                double double_value;
+                std::size_t offset;
+            };
+            std::size_t length;
+
+            event(staj_event_type event_type, semantic_tag tag) noexcept
+                : event_type(event_type), tag(tag), uint64_value(0), length(0)
+            {
+            }
+        };
+        using event_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<event>;
+        using char_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<CharT>;
+        using size_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<std::size_t>;
+
+        std::vector<event,event_allocator_type> events_;
+        std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> chars_;
+        std::vector<std::size_t,size_allocator_type> open_;
+    public:
+        csv_event_buffer(const TempAllocator& alloc)
+            : events_(alloc), chars_(alloc), open_(alloc)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return events_.size();
+        }
+
+        staj_event_type event_type(std::size_t i) const
+        {
+            return events_[i].event_type;
+        }
+
+        semantic_tag tag(std::size_t i) const
+        {
+            return events_[i].tag;
+        }
+
+        string_view_type key(std::size_t i) const
+        {
+            return string_view_type(chars_.data() + events_[i].offset, events_[i].length);
+        }
+
+        // The index of the event after the value that starts at index i
+        std::size_t next(std::size_t i) const
+        {
+            const event& e = events_[i];
+            return (e.event_type == staj_event_type::begin_array || e.event_type == staj_event_type::begin_object) &&
+                e.length > i ? e.length : i + 1;
+        }
+
+        // Sends the events in [first, last) to visitor
+        void replay(std::size_t first, std::size_t last, basic_json_visitor<CharT>& visitor, std::error_code& ec) const
+        {
+            const ser_context context{};
+            for (std::size_t i = first; i < last && !ec; ++i)
+            {
+                const event& e = events_[i];
+                switch (e.event_type)
+                {
+                    case staj_event_type::begin_array:
+                        visitor.begin_array(e.tag, context, ec);
+                        break;
+                    case staj_event_type::end_array:
+                        visitor.end_array(context, ec);
+                        break;
+                    case staj_event_type::begin_object:
+                        visitor.begin_object(e.tag, context, ec);
+                        break;
+                    case staj_event_type::end_object:
+                        visitor.end_object(context, ec);
+                        break;
+                    case staj_event_type::key:
+                        visitor.key(string_view_type(chars_.data() + e.offset, e.length), context, ec);
+                        break;
+                    case staj_event_type::string_value:
+                        visitor.string_value(string_view_type(chars_.data() + e.offset, e.length), e.tag, context, ec);
+                        break;
+                    case staj_event_type::byte_string_value:
+                        visitor.byte_string_value(byte_string_view(reinterpret_cast<const uint8_t*>(chars_.data() + e.offset), e.length*sizeof(CharT)),
+                                                  e.tag, context, ec);
+                        break;
+                    case staj_event_type::null_value:
+                        visitor.null_value(e.tag, context, ec);
+                        break;
+                    case staj_event_type::bool_value:
+                        visitor.bool_value(e.bool_value, e.tag, context, ec);
+                        break;
+                    case staj_event_type::int64_value:
+                        visitor.int64_value(e.int64_value, e.tag, context, ec);
+                        break;
+                    case staj_event_type::uint64_value:
+                        visitor.uint64_value(e.uint64_value, e.tag, context, ec);
+                        break;
+                    case staj_event_type::half_value:
+                        visitor.half_value(e.half_value, e.tag, context, ec);
+                        break;
+                    case staj_event_type::double_value:
+                        visitor.double_value(e.double_value, e.tag, context, ec);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    private:
+        void add_chars(staj_event_type event_type, semantic_tag tag, const CharT* data, std::size_t length)
+        {
+            event e(event_type, tag);
+            e.offset = chars_.size();
+            e.length = length;
+            chars_.append(data, length);
+            events_.push_back(e);
+        }
+
+        void begin_container(staj_event_type event_type, semantic_tag tag)
+        {
+            open_.push_back(events_.size());
+            events_.emplace_back(event_type, tag);
+        }
+
+        void end_container(staj_event_type event_type)
+        {
+            if (!open_.empty())
+            {
+                events_[open_.back()].length = events_.size() + 1;
+                open_.pop_back();
+            }
+            events_.emplace_back(event_type, semantic_tag::none);
+        }
+
+        void visit_flush() override
+        {
+        }
+
+        bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_container(staj_event_type::begin_object, tag);
+            return true;
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            end_container(staj_event_type::end_object);
+            return true;
+        }
+
+        bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_container(staj_event_type::begin_array, tag);
+            return true;
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            end_container(staj_event_type::end_array);
+            return true;
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            add_chars(staj_event_type::key, semantic_tag::none, name.data(), name.size());
+            return true;
+        }
+
+        bool visit_string(const string_view_type& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            add_chars(staj_event_type::string_value, tag, value.data(), value.size());
+            return true;
+        }
+
+        bool visit_byte_string(const byte_string_view& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            // Padded to whole characters, the length is kept in characters
+            const std::size_t length = (value.size() + sizeof(CharT) - 1) / sizeof(CharT);
+            event e(staj_event_type::byte_string_value, tag);
+            e.offset = chars_.size();
+            e.length = length;
+            chars_.resize(chars_.size() + length);
+            if (value.size() > 0)
+            {
+                std::memcpy(&chars_[e.offset], value.data(), value.size());
+            }
+            events_.push_back(e);
+            return true;
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            events_.emplace_back(staj_event_type::null_value, tag);
+            return true;
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            event e(staj_event_type::bool_value, tag);
+            e.bool_value = value;
+            events_.push_back(e);
+            return true;
+        }
+
+        bool visit_int64(int64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            event e(staj_event_type::int64_value, tag);
+            e.int64_value = value;
+            events_.push_back(e);
+            return true;
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            event e(staj_event_type::uint64_value, tag);
+            e.uint64_value = value;
+            events_.push_back(e);
+            return true;
+        }
+
+        bool visit_half(uint16_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            event e(staj_event_type::half_value, tag);
+            e.half_value = value;
+            events_.push_back(e);
+            return true;
+        }
+
+        bool visit_double(double value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            event e(staj_event_type::double_value, tag);
+            e.double_value = value;
+            events_.push_back(e);
+            return true;
+        }
+    };
+
+    // Joins the threads that are still running when it goes out of scope, so that an error
+    // or an exception on the calling thread never destroys a joinable thread
+
+    class thread_joiner
+    {
+        std::vector<std::thread>& threads_;
+    public:
+        explicit thread_joiner(std::vector<std::thread>& threads)
+            : threads_(threads)
+        {
+        }
+
+        thread_joiner(const thread_joiner&) = delete;
+        thread_joiner& operator=(const thread_joiner&) = delete;
+
+        ~thread_joiner()
+        {
+            for (auto& t : threads_)
+            {
+                if (t.joinable())
+                {
+                    t.join();
+                }
+            }
+        }
+    };
+
+} // namespace detail
+
+    // basic_parallel_csv_reader
+
+    // Splits CSV text into chunks at record boundaries, parses the chunks concurrently,
+    // and delivers the rows in order. Chunks after the first are parsed after the header
+    // lines, so that every chunk sees the same column names. An exception thrown while
+    // parsing a chunk on another thread is rethrown on the calling thread.
+
+    template <class CharT,class TempAllocator=std::allocator<char>>
+    class basic_parallel_csv_reader
+    {
+    public:
+        using char_type = CharT;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+        using temp_allocator_type = TempAllocator;
+
+        static constexpr std::size_t default_min_chunk_size = 1 << 20;
+    private:
+        using char_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT>;
+        using string_type = std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type>;
+
+        struct chunk
+        {
+            std::size_t offset;
+            std::size_t length;
+            std::size_t line;
+        };
+
+        template <class Json>
+        struct chunk_result
+        {
+            Json value;
+            std::error_code ec;
+            std::size_t line;
+            std::size_t column;
+            std::exception_ptr exception;
+
+            chunk_result()
+                : line(0), column(0)
+            {
+            }
+        };
+
+        struct chunk_events
+        {
+            detail::csv_event_buffer<CharT,TempAllocator> events;
+            std::error_code ec;
+            std::size_t line;
+            std::size_t column;
+            std::exception_ptr exception;
+
+            chunk_events(const TempAllocator& alloc)
+                : events(alloc), line(0), column(0)
+            {
+            }
+        };
+
+        string_type text_;
+        string_view_type input_;
+        basic_csv_decode_options<CharT> options_;
+        std::size_t num_threads_;
+        std::size_t min_chunk_size_;
+        temp_allocator_type alloc_;
+        std::size_t header_length_;
+        std::size_t header_line_breaks_;
+        std::vector<chunk> chunks_;
+
+        // Noncopyable and nonmoveable
+        basic_parallel_csv_reader(const basic_parallel_csv_reader&) = delete;
+        basic_parallel_csv_reader& operator=(const basic_parallel_csv_reader&) = delete;
+    public:
+        // The input must outlive the reader
+        explicit basic_parallel_csv_reader(string_view_type input,
+                                           const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>(),
+                                           std::size_t num_threads = 0,
+                                           std::size_t min_chunk_size = default_min_chunk_size,
+                                           const TempAllocator& alloc = TempAllocator())
+            : text_(alloc),
+              input_(skip_bom(input)),
+              options_(options),
+              num_threads_(num_threads != 0 ? num_threads : default_num_threads()),
+              min_chunk_size_(min_chunk_size != 0 ? min_chunk_size : 1),
+              alloc_(alloc),
+              header_length_(0),
+              header_line_breaks_(0)
+        {
+            split();
+        }
+
+        // Reads the whole stream into memory before splitting it, since the chunks
+        // are found by scanning the text for record boundaries
+        explicit basic_parallel_csv_reader(std::basic_istream<CharT>& is,
+                                           const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>(),
+                                           std::size_t num_threads = 0,
+                                           std::size_t min_chunk_size = default_min_chunk_size,
+                                           const TempAllocator& alloc = TempAllocator())
+            : text_(std::istreambuf_iterator<CharT>(is), std::istreambuf_iterator<CharT>(), alloc),
+              input_(skip_bom(string_view_type(text_.data(), text_.size()))),
+              options_(options),
+              num_threads_(num_threads != 0 ? num_threads : default_num_threads()),
+              min_chunk_size_(min_chunk_size != 0 ? min_chunk_size : 1),
+              alloc_(alloc),
+              header_length_(0),
+              header_line_breaks_(0)
+        {
+            split();
+        }
+
+        std::size_t chunk_count() const
+        {
+            return chunks_.size();
+        }
+
+        // Returns one value for each chunk, an array of rows, or for the m_columns mapping,
+        // an object of columns. Header rows are only in the value for the first chunk.
+        template <class Json>
+        std::vector<Json> read_chunks()
+        {
+            std::error_code ec;
+            std::size_t line = 0;
+            std::size_t column = 0;
+            std::vector<Json> values = read_chunks<Json>(ec, line, column);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, line, column));
+            }
+            return values;
+        }
+
+        template <class Json>
+        std::vector<Json> read_chunks(std::error_code& ec)
+        {
+            std::size_t line = 0;
+            std::size_t column = 0;
+            return read_chunks<Json>(ec, line, column);
+        }
+
+        // Produces the same events as basic_csv_reader. For the n_rows and n_objects mappings,
+        // the rows of each chunk are sent as soon as it and the chunks before it have been parsed.
+        void read(basic_json_visitor<CharT>& visitor)
+        {
+            std::error_code ec;
+            std::size_t line = 0;
+            std::size_t column = 0;
+            read(visitor, ec, line, column);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, line, column));
+            }
+        }
+
+        void read(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+        {
+            std::size_t line = 0;
+            std::size_t column = 0;
+            read(visitor, ec, line, column);
+        }
+
+    private:
+        static std::size_t default_num_threads()
+        {
+            std::size_t n = std::thread::hardware_concurrency();
+            return n != 0 ? n : 1;
+        }
+
+        static string_view_type skip_bom(string_view_type input)
+        {
+            auto r = unicode_traits::detect_encoding_from_bom(input.data(), input.size());
+            if (r.encoding == unicode_traits::encoding_kind::utf8)
+            {
+                std::size_t offset = static_cast<std::size_t>(r.ptr - input.data());
+                return string_view_type(input.data() + offset, input.size() - offset);
+            }
+            return input;
+        }
+
+        // Finds the end of the header lines, then splits the rest of the input into chunks
+        // of about the same size at record boundaries
+        void split()
+        {
+            detail::csv_record_scanner<CharT> scanner(input_.data(), input_.size(), options_);
+
+            const std::size_t header_lines = options_.header_lines();
+            if (header_lines > 0)
+            {
+                while (!scanner.done())
+                {
+                    auto kind = scanner.skip_record();
+                    if (kind == detail::csv_record_kind::record ||
+                        (kind == detail::csv_record_kind::empty_line && !options_.ignore_empty_lines()))
+                    {
+                        if (scanner.line_breaks() + 1 >= header_lines)
+                        {
+                            break;
+                        }
+                    }
+                }
+            }
+            header_length_ = static_cast<std::size_t>(scanner.position() - input_.data());
+            header_line_breaks_ = scanner.line_breaks();
+
+            const std::size_t body_length = input_.size() - header_length_;
+            std::size_t num_chunks = (std::min)(num_threads_, (std::max)(std::size_t(1), body_length/min_chunk_size_));
+            if (options_.max_lines() != (std::numeric_limits<std::size_t>::max)())
+            {
+                num_chunks = 1;
+            }
+
+            chunks_.clear();
+            std::size_t offset = 0;
+            std::size_t line = 1;
+            for (std::size_t k = 1; k < num_chunks && !scanner.done(); ++k)
+            {
+                const std::size_t target = header_length_ + k*(body_length/num_chunks);
+                while (!scanner.done() && static_cast<std::size_t>(scanner.position() - input_.data()) < target)
+                {
+                    scanner.skip_record();
+                }
+                const std::size_t split_point = static_cast<std::size_t>(scanner.position() - input_.data());
+                if (split_point > offset && !scanner.done())
+                {
+                    chunks_.push_back(chunk{offset, split_point - offset, line});
+                    offset = split_point;
+                    line = scanner.line_breaks() + 1;
+                }
+            }
+            chunks_.push_back(chunk{offset, input_.size() - offset, line});
+        }
+
+        template <class Json>
+        std::vector<Json> read_chunks(std::error_code& ec, std::size_t& line, std::size_t& column)
+        {
+            std::vector<chunk_result<Json>> results(chunks_.size());
+            {
+                std::vector<std::thread> threads;
+                detail::thread_joiner joiner(threads);
+                start_threads(results, threads);
+                run_chunk(0, results[0]);
+            }
+
+            std::vector<Json> values;
+            values.reserve(results.size());
+            for (auto& result : results)
+            {
+                if (!check_result(result, ec, line, column))
+                {
+                    return std::vector<Json>();
+                }
+                values.push_back(std::move(result.value));
+            }
+
+            // Chunks after the first were parsed after the header lines,
+            // drop the rows that these produced
+            if (values.size() > 1 && header_length_ > 0 && values.front().is_array())
+            {
+                chunk_result<Json> header;
+                parse_into(string_view_type(input_.data(), header_length_), string_view_type(), header);
+                if (!header.ec && header.value.is_array() && !header.value.empty())
+                {
+                    for (std::size_t k = 1; k < values.size(); ++k)
+                    {
+                        auto first = values[k].array_range().begin();
+                        values[k].erase(first, first + (std::min)(header.value.size(), values[k].size()));
+                    }
+                }
+            }
+            return values;
+        }
+
+        void read(basic_json_visitor<CharT>& visitor, std::error_code& ec, std::size_t& line, std::size_t& column)
+        {
+            std::vector<chunk_events> results;
+            results.reserve(chunks_.size());
+            for (std::size_t k = 0; k < chunks_.size(); ++k)
+            {
+                results.emplace_back(alloc_);
+            }
+
+            std::vector<std::thread> threads;
+            detail::thread_joiner joiner(threads);
+            start_threads(results, threads);
+            run_chunk(0, results[0]);
+            if (!check_result(results[0], ec, line, column))
+            {
+                return;
+            }
+
+            const auto& first = results[0].events;
+            if (results.size() > 1 && first.size() > 0 && first.event_type(0) == staj_event_type::begin_array)
+            {
+                // Rows from the header lines, which chunks after the first also produced
+                const std::size_t header_rows = count_header_rows();
+
+                first.replay(0, first.next(0) - 1, visitor, ec);
+                results[0] = chunk_events(alloc_);
+                for (std::size_t k = 1; k < results.size() && !ec; ++k)
+                {
+                    threads[k-1].join();
+                    if (!check_result(results[k], ec, line, column))
+                    {
+                        return;
+                    }
+                    const auto& events = results[k].events;
+                    if (events.size() > 0)
+                    {
+                        const std::size_t last = events.next(0) - 1;
+                        std::size_t i = 1;
+                        for (std::size_t n = 0; n < header_rows && i < last; ++n)
+                        {
+                            i = events.next(i);
+                        }
+                        events.replay(i, last, visitor, ec);
+                    }
+                    results[k] = chunk_events(alloc_);
+                }
+                if (!ec)
+                {
+                    visitor.end_array(ser_context(), ec);
+                }
+            }
+            else
+            {
+                for (std::size_t k = 1; k < results.size(); ++k)
+                {
+                    threads[k-1].join();
+                    if (!check_result(results[k], ec, line, column))
+                    {
+                        return;
+                    }
+                }
+                if (results.size() > 1 && first.size() > 0 && first.event_type(0) == staj_event_type::begin_object)
+                {
+                    replay_columns(results, visitor, ec);
+                }
+                else
+                {
+                    first.replay(0, first.size(), visitor, ec);
+                }
+            }
+            if (!ec)
+            {
+                visitor.flush();
+            }
+        }
+
+        // Sends the m_columns objects of all chunks as one object, with the values of
+        // each column in chunk order
+        void replay_columns(const std::vector<chunk_events>& results, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+        {
+            struct column
+            {
+                string_view_type name;
+                semantic_tag tag;
+                std::vector<std::pair<std::size_t,std::size_t>> values; // (chunk, event index)
+            };
+            std::vector<column> columns;
+            for (std::size_t k = 0; k < results.size(); ++k)
+            {
+                const auto& events = results[k].events;
+                if (events.size() == 0 || events.event_type(0) != staj_event_type::begin_object)
+                {
+                    continue;
+                }
+                const std::size_t last = events.next(0) - 1;
+                for (std::size_t i = 1; i < last; i = events.next(i+1))
+                {
+                    string_view_type name = events.key(i);
+                    auto it = std::find_if(columns.begin(), columns.end(),
+                                           [&](const column& c) { return c.name == name; });
+                    if (it == columns.end())
+                    {
+                        columns.push_back(column{name, events.tag(i+1), {}});
+                        it = columns.end() - 1;
+                    }
+                    it->values.emplace_back(k, i+1);
+                }
+            }
+
+            const ser_context context{};
+            visitor.begin_object(results[0].events.tag(0), context, ec);
+            for (std::size_t j = 0; j < columns.size() && !ec; ++j)
+            {
+                const column& c = columns[j];
+                visitor.key(c.name, context, ec);
+                visitor.begin_array(c.tag, context, ec);
+                for (const auto& value : c.values)
+                {
+                    const auto& events = results[value.first].events;
+                    const std::size_t i = value.second;
+                    if (events.event_type(i) == staj_event_type::begin_array)
+                    {
+                        events.replay(i + 1, events.next(i) - 1, visitor, ec);
+                    }
+                    else
+                    {
+                        events.replay(i, events.next(i), visitor, ec);
+                    }
+                }
+                visitor.end_array(context, ec);
+            }
+            visitor.end_object(context, ec);
+        }
+
+        std::size_t count_header_rows()
+        {
+            if (header_length_ == 0)
+            {
+                return 0;
+            }
+            chunk_events header(alloc_);
+            parse(string_view_type(input_.data(), header_length_), string_view_type(), header.events, header);
+            const auto& events = header.events;
+            if (header.ec || events.size() == 0 || events.event_type(0) != staj_event_type::begin_array)
+            {
+                return 0;
+            }
+            std::size_t count = 0;
+            const std::size_t last = events.next(0) - 1;
+            for (std::size_t i = 1; i < last; i = events.next(i))
+            {
+                ++count;
+            }
+            return count;
+        }
+
+        // Parses chunks after the first on their own threads
+        template <class Result>
+        void start_threads(std::vector<Result>& results, std::vector<std::thread>& threads)
+        {
+            threads.reserve(results.size());
+            for (std::size_t k = 1; k < results.size(); ++k)
+            {
+                threads.emplace_back([this, k, &results]() { run_chunk(k, results[k]); });
+            }
+        }
+
+        template <class Result>
+        void run_chunk(std::size_t k, Result& result) noexcept
+        {
+            JSONCONS_TRY
+            {
+                parse_chunk(k, result);
+            }
+            JSONCONS_CATCH(...)
+            {
+                result.exception = std::current_exception();
+            }
+        }
+
+        template <class Result>
+        static bool check_result(const Result& result, std::error_code& ec, std::size_t& line, std::size_t& column)
+        {
+            if (result.exception)
+            {
+                std::rethrow_exception(result.exception);
+            }
+            if (result.ec)
+            {
+                ec = result.ec;
+                line = result.line;
+                column = result.column;
+                return false;
+            }
+            return true;
+        }
+
+        template <class Result>
+        void parse_chunk(std::size_t k, Result& result)
+        {
+            const chunk& c = chunks_[k];
+            string_view_type body(input_.data() + c.offset, c.length);
+            if (k == 0)
+            {
+                parse_into(string_view_type(), body, result);
+            }
+            else
+            {
+                parse_into(string_view_type(input_.data(), header_length_), body, result);
+                // Report lines in the whole input
+                if (result.ec && result.line > header_line_breaks_)
+                {
+                    result.line = c.line + (result.line - header_line_breaks_ - 1);
+                }
+            }
+        }
+
+        template <class Json>
+        void parse_into(string_view_type header, string_view_type body, chunk_result<Json>& result)
+        {
+            json_decoder<Json,TempAllocator> decoder(typename Json::allocator_type(), alloc_);
+            parse(header, body, decoder, result);
+            if (!result.ec && decoder.is_valid())
+            {
+                result.value = decoder.get_result();
+            }
+        }
+
+        void parse_into(string_view_type header, string_view_type body, chunk_events& result)
+        {
+            parse(header, body, result.events, result);
+        }
+
+        template <class Result>
+        void parse(string_view_type header, string_view_type body, basic_json_visitor<CharT>& visitor, Result& result)
+        {
+            basic_csv_parser<CharT,TempAllocator> parser(options_, alloc_);
+
+            string_view_type pieces[] = {header, body};
+            std::size_t next = 0;
+            while (!parser.stopped())
+            {
+                if (parser.source_exhausted())
+                {
+                    while (next < 2 && pieces[next].empty())
+                    {
+                        ++next;
+                    }
+                    if (next < 2)
+                    {
+                        parser.update(pieces[next].data(), pieces[next].size());
+                        ++next;
+                    }
+                }
+                parser.parse_some(visitor, result.ec);
+                if (result.ec)
+                {
+                    result.line = parser.line();
+                    result.column = parser.column();
+                    return;
+                }
+            }
+        }
+    };
+
+    using parallel_csv_reader = basic_parallel_csv_reader<char>;
+    using wparallel_csv_reader = basic_parallel_csv_reader<wchar_t>;
+
+}}
+
+#endif
@@ -0,0 +1,594 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CSV_TRANSCODE_CSV_HPP
+#define JSONCONS_CSV_TRANSCODE_CSV_HPP
+
+#include <string>
+#include <vector>
+#include <memory> // std::allocator
+#include <system_error>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/staj_cursor.hpp>
+#include <jsoncons/conv_error.hpp>
+#include <jsoncons_ext/csv/csv_options.hpp>
+#include <jsoncons_ext/csv/csv_reader.hpp>
+#include <jsoncons_ext/csv/csv_columns.hpp>
+
+namespace jsoncons { namespace csv {
+
+namespace detail {
+
+    // Holds the events of one record, then sends them to the destination with the lengths
+    // of its arrays and objects. Records are sent as elements of one array of unknown length,
+    // or for a sequence, as top level values. Record buffers are reused.
+
+    template <class CharT,class TempAllocator>
+    class csv_record_buffer final : public basic_json_visitor<CharT>
+    {
+    public:
+        using typename basic_json_visitor<CharT>::string_view_type;
+    private:
+        using char_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<CharT>;
+        using string_type = std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type>;
+
+        struct item
+        {
+            staj_event_type event_type;
+            semantic_tag tag;
+            std::size_t length;
+            union
+            {
+                bool bool_value;
+                int64_t int64_value;
+                uint64_t uint64_value;
+                double double_value;
+                std::size_t offset;
+            };
+
+            item(staj_event_type event_type, semantic_tag tag)
+                : event_type(event_type), tag(tag), length(0), uint64_value(0)
+            {
+            }
+        };
+
+        using item_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<item>;
+        using size_t_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<std::size_t>;
+        using byte_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<uint8_t>;
+
+        basic_json_visitor<CharT>* destination_;
+        bool sequence_;
+        std::vector<item,item_allocator_type> items_;
+        std::vector<std::size_t,size_t_allocator_type> containers_;
+        string_type strings_;
+        std::vector<uint8_t,byte_allocator_type> bytes_;
+        int level_;
+    public:
+        csv_record_buffer(basic_json_visitor<CharT>& destination, bool sequence, const TempAllocator& alloc)
+            : destination_(std::addressof(destination)),
+              sequence_(sequence),
+              items_(alloc),
+              containers_(alloc),
+              strings_(alloc),
+              bytes_(alloc),
+              level_(0)
+        {
+        }
+
+    private:
+        void visit_flush() override
+        {
+            destination_->flush();
+        }
+
+        bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code& ec) override
+        {
+            if (level_ == 0)
+            {
+                ec = conv_errc::conversion_failed;
+                return false;
+            }
+            begin_container(staj_event_type::begin_object, tag);
+            return true;
+        }
+
+        bool visit_end_object(const ser_context& context, std::error_code& ec) override
+        {
+            return end_container(staj_event_type::end_object, context, ec);
+        }
+
+        bool visit_begin_array(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (level_ == 0)
+            {
+                level_ = 1;
+                return sequence_ ? true : destination_->begin_array(tag, context, ec);
+            }
+            begin_container(staj_event_type::begin_array, tag);
+            return true;
+        }
+
+        bool visit_end_array(const ser_context& context, std::error_code& ec) override
+        {
+            if (level_ == 1)
+            {
+                level_ = 0;
+                if (!sequence_ && !destination_->end_array(context, ec))
+                {
+                    return false;
+                }
+                destination_->flush();
+                return true;
+            }
+            return end_container(staj_event_type::end_array, context, ec);
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            items_.emplace_back(staj_event_type::key, semantic_tag::none);
+            set_string(items_.back(), name);
+            ++items_[containers_.back()].length;
+            return true;
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            add_value(staj_event_type::null_value, tag);
+            return true;
+        }
+
+        bool visit_string(const string_view_type& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            set_string(add_value(staj_event_type::string_value, tag), value);
+            return true;
+        }
+
+        bool visit_byte_string(const byte_string_view& value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            item& val = add_value(staj_event_type::byte_string_value, tag);
+            val.offset = bytes_.size();
+            val.length = value.size();
+            bytes_.insert(bytes_.end(), value.begin(), value.end());
+            return true;
+        }
+
+        bool visit_int64(int64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            add_value(staj_event_type::int64_value, tag).int64_value = value;
+            return true;
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            add_value(staj_event_type::uint64_value, tag).uint64_value = value;
+            return true;
+        }
+
+        bool visit_double(double value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            add_value(staj_event_type::double_value, tag).double_value = value;
+            return true;
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            add_value(staj_event_type::bool_value, tag).bool_value = value;
+            return true;
+        }
+
+        void count_in_parent()
+        {
+            if (!containers_.empty() && items_[containers_.back()].event_type == staj_event_type::begin_array)
+            {
+                ++items_[containers_.back()].length;
+            }
+        }
+
+        item& add_value(staj_event_type event_type, semantic_tag tag)
+        {
+            count_in_parent();
+            items_.emplace_back(event_type, tag);
+            return items_.back();
+        }
+
+        void set_string(item& val, const string_view_type& value)
+        {
+            val.offset = strings_.size();
+            val.length = value.size();
+            strings_.append(value.data(), value.size());
+        }
+
+        void begin_container(staj_event_type event_type, semantic_tag tag)
+        {
+            count_in_parent();
+            containers_.push_back(items_.size());
+            items_.emplace_back(event_type, tag);
+            ++level_;
+        }
+
+        bool end_container(staj_event_type event_type, const ser_context& context, std::error_code& ec)
+        {
+            items_.emplace_back(event_type, semantic_tag::none);
+            containers_.pop_back();
+            --level_;
+            if (level_ == 1)
+            {
+                bool more = replay(context, ec);
+                items_.clear();
+                strings_.clear();
+                bytes_.clear();
+                return more;
+            }
+            return true;
+        }
+
+        bool replay(const ser_context& context, std::error_code& ec)
+        {
+            bool more = true;
+            for (auto it = items_.begin(); more && !ec && it != items_.end(); ++it)
+            {
+                const item& val = *it;
+                switch (val.event_type)
+                {
+                    case staj_event_type::begin_array:
+                        more = destination_->begin_array(val.length, val.tag, context, ec);
+                        break;
+                    case staj_event_type::end_array:
+                        more = destination_->end_array(context, ec);
+                        break;
+                    case staj_event_type::begin_object:
+                        more = destination_->begin_object(val.length, val.tag, context, ec);
+                        break;
+                    case staj_event_type::end_object:
+                        more = destination_->end_object(context, ec);
+                        break;
+                    case staj_event_type::key:
+                        more = destination_->key(string_view_type(strings_.data() + val.offset, val.length), context, ec);
+                        break;
+                    case staj_event_type::string_value:
+                        more = destination_->string_value(string_view_type(strings_.data() + val.offset, val.length), val.tag, context, ec);
+                        break;
+                    case staj_event_type::byte_string_value:
+                        more = destination_->byte_string_value(byte_string_view(bytes_.data() + val.offset, val.length), val.tag, context, ec);
+                        break;
+                    case staj_event_type::null_value:
+                        more = destination_->null_value(val.tag, context, ec);
+                        break;
+                    case staj_event_type::bool_value:
+                        more = destination_->bool_value(val.bool_value, val.tag, context, ec);
+                        break;
+                    case staj_event_type::int64_value:
+                        more = destination_->int64_value(val.int64_value, val.tag, context, ec);
+                        break;
+                    case staj_event_type::uint64_value:
+                        more = destination_->uint64_value(val.uint64_value, val.tag, context, ec);
+                        break;
+                    case staj_event_type::double_value:
+                        more = destination_->double_value(val.double_value, val.tag, context, ec);
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return more && !ec;
+        }
+    };
+
+    // Sends each column as a typed array when it is an integer or float column without nulls,
+    // otherwise as an array of values
+
+    template <class CharT,class Allocator>
+    bool write_csv_columns(const basic_csv_columns<CharT,Allocator>& columns,
+                           basic_json_visitor<CharT>& visitor,
+                           const ser_context& context,
+                           std::error_code& ec)
+    {
+        using string_view_type = typename basic_csv_columns<CharT,Allocator>::string_view_type;
+
+        visitor.begin_object(columns.size(), semantic_tag::none, context, ec);
+        for (const auto& column : columns)
+        {
+            if (ec) {return false;}
+            visitor.key(string_view_type(column.name()), context, ec);
+            if (column.type() == csv_column_type::integer_t && !column.has_nulls())
+            {
+                const auto& values = column.integer_values();
+                visitor.typed_array(jsoncons::span<const int64_t>(values.data(), values.size()), semantic_tag::none, context, ec);
+            }
+            else if (column.type() == csv_column_type::float_t && !column.has_nulls())
+            {
+                const auto& values = column.float_values();
+                visitor.typed_array(jsoncons::span<const double>(values.data(), values.size()), semantic_tag::none, context, ec);
+            }
+            else
+            {
+                visitor.begin_array(column.size(), semantic_tag::none, context, ec);
+                for (std::size_t i = 0; !ec && i < column.size(); ++i)
+                {
+                    if (column.is_null(i))
+                    {
+                        visitor.null_value(semantic_tag::none, context, ec);
+                        continue;
+                    }
+                    switch (column.type())
+                    {
+                        case csv_column_type::integer_t:
+                            visitor.int64_value(column.integer_values()[i], semantic_tag::none, context, ec);
+                            break;
+                        case csv_column_type::float_t:
+                            visitor.double_value(column.float_values()[i], semantic_tag::none, context, ec);
+                            break;
+                        case csv_column_type::boolean_t:
+                            visitor.bool_value(column.boolean_values()[i], semantic_tag::none, context, ec);
+                            break;
+                        default:
+                            visitor.string_value(column.string_value(i), semantic_tag::none, context, ec);
+                            break;
+                    }
+                }
+                if (!ec)
+                {
+                    visitor.end_array(context, ec);
+                }
+            }
+        }
+        if (ec) {return false;}
+        return visitor.end_object(context, ec);
+    }
+
+    // Decodes rows into typed columns, and sends each block of rows as an object of columns.
+    // Blocks are sent as elements of one array of unknown length, or for a sequence, as top
+    // level values. All rows in one block are sent as a single object.
+
+    template <class CharT,class TempAllocator>
+    class csv_column_blocks final : public basic_json_visitor<CharT>
+    {
+    public:
+        using typename basic_json_visitor<CharT>::string_view_type;
+    private:
+        basic_json_visitor<CharT>* destination_;
+        std::size_t block_rows_;
+        bool wrap_blocks_;
+        basic_csv_columns_decoder<CharT,TempAllocator> decoder_;
+        int level_;
+    public:
+        csv_column_blocks(basic_json_visitor<CharT>& destination, std::size_t block_rows, bool sequence, const TempAllocator& alloc)
+            : destination_(std::addressof(destination)),
+              block_rows_(block_rows),
+              wrap_blocks_(!sequence && block_rows != 0),
+              decoder_(alloc),
+              level_(0)
+        {
+        }
+
+    private:
+        bool write_block(const ser_context& context, std::error_code& ec)
+        {
+            auto rows = decoder_.take_rows();
+            return write_csv_columns(rows, *destination_, context, ec);
+        }
+
+        bool end_row(const ser_context& context, std::error_code& ec)
+        {
+            if (block_rows_ != 0 && decoder_.row_count() >= block_rows_)
+            {
+                return write_block(context, ec);
+            }
+            return true;
+        }
+
+        void visit_flush() override
+        {
+            destination_->flush();
+        }
+
+        bool visit_begin_object(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            ++level_;
+            return decoder_.begin_object(tag, context, ec);
+        }
+
+        bool visit_end_object(const ser_context& context, std::error_code& ec) override
+        {
+            --level_;
+            if (!decoder_.end_object(context, ec))
+            {
+                return false;
+            }
+            return end_row(context, ec);
+        }
+
+        bool visit_begin_array(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            if (level_++ == 0 && wrap_blocks_ && !destination_->begin_array(semantic_tag::none, context, ec))
+            {
+                return false;
+            }
+            return decoder_.begin_array(tag, context, ec);
+        }
+
+        bool visit_end_array(const ser_context& context, std::error_code& ec) override
+        {
+            --level_;
+            if (!decoder_.end_array(context, ec))
+            {
+                return false;
+            }
+            if (level_ == 0)
+            {
+                if (decoder_.row_count() > 0 || block_rows_ == 0)
+                {
+                    if (!write_block(context, ec))
+                    {
+                        return false;
+                    }
+                }
+                if (wrap_blocks_ && !destination_->end_array(context, ec))
+                {
+                    return false;
+                }
+                destination_->flush();
+                return true;
+            }
+            return end_row(context, ec);
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context& context, std::error_code& ec) override
+        {
+            return decoder_.key(name, context, ec);
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            return decoder_.null_value(tag, context, ec);
+        }
+
+        bool visit_string(const string_view_type& value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            return decoder_.string_value(value, tag, context, ec);
+        }
+
+        bool visit_byte_string(const byte_string_view& value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            return decoder_.byte_string_value(value, tag, context, ec);
+        }
+
+        bool visit_int64(int64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            return decoder_.int64_value(value, tag, context, ec);
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            return decoder_.uint64_value(value, tag, context, ec);
+        }
+
+        bool visit_double(double value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            return decoder_.double_value(value, tag, context, ec);
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            return decoder_.bool_value(value, tag, context, ec);
+        }
+    };
+
+    template <class CharT,class Source,class TempAllocator,class Sourceable>
+    void transcode_csv(Sourceable&& source,
+                       basic_json_visitor<CharT>& visitor,
+                       const basic_csv_decode_options<CharT>& options,
+                       std::size_t block_rows,
+                       bool sequence,
+                       const TempAllocator& temp_alloc,
+                       std::error_code& ec,
+                       std::size_t& line,
+                       std::size_t& column)
+    {
+        if (options.mapping_kind() == csv_mapping_kind::m_columns)
+        {
+            csv_column_blocks<CharT,TempAllocator> blocks(visitor, block_rows, sequence, temp_alloc);
+            basic_csv_reader<CharT,Source,TempAllocator> reader(std::forward<Sourceable>(source), blocks, columns_decode_options(options), temp_alloc);
+            reader.read(ec);
+            line = reader.line();
+            column = reader.column();
+        }
+        else
+        {
+            csv_record_buffer<CharT,TempAllocator> records(visitor, sequence, temp_alloc);
+            basic_csv_reader<CharT,Source,TempAllocator> reader(std::forward<Sourceable>(source), records, options, temp_alloc);
+            reader.read(ec);
+            line = reader.line();
+            column = reader.column();
+        }
+    }
+
+} // namespace detail
+
+    // Sends the records to the visitor as one array of unknown length, each record an array or
+    // object with its length, or for the m_columns mapping, each block of block_rows rows as an
+    // object of columns in one array of unknown length (all rows as one object if zero)
+
+    template <class Source,class TempAllocator=std::allocator<char>>
+    typename std::enable_if<extension_traits::is_sequence_of<Source,typename Source::value_type>::value,void>::type
+    transcode_csv(const Source& s,
+                  basic_json_visitor<typename Source::value_type>& visitor,
+                  const basic_csv_decode_options<typename Source::value_type>& options = basic_csv_decode_options<typename Source::value_type>(),
+                  std::size_t block_rows = 0,
+                  const TempAllocator& temp_alloc = TempAllocator())
+    {
+        using char_type = typename Source::value_type;
+
+        std::error_code ec;
+        std::size_t line = 0;
+        std::size_t column = 0;
+        detail::transcode_csv<char_type,jsoncons::string_source<char_type>>(s, visitor, options, block_rows, false, temp_alloc, ec, line, column);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec, line, column));
+        }
+    }
+
+    template <class CharT,class TempAllocator=std::allocator<char>>
+    void transcode_csv(std::basic_istream<CharT>& is,
+                       basic_json_visitor<CharT>& visitor,
+                       const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>(),
+                       std::size_t block_rows = 0,
+                       const TempAllocator& temp_alloc = TempAllocator())
+    {
+        std::error_code ec;
+        std::size_t line = 0;
+        std::size_t column = 0;
+        detail::transcode_csv<CharT,jsoncons::stream_source<CharT>>(is, visitor, options, block_rows, false, temp_alloc, ec, line, column);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec, line, column));
+        }
+    }
+
+    // Like transcode_csv, but sends each record, or each block of rows, as a top level value,
+    // for encoders that need the length of every array, such as msgpack_encoder
+
+    template <class Source,class TempAllocator=std::allocator<char>>
+    typename std::enable_if<extension_traits::is_sequence_of<Source,typename Source::value_type>::value,void>::type
+    transcode_csv_sequence(const Source& s,
+                           basic_json_visitor<typename Source::value_type>& visitor,
+                           const basic_csv_decode_options<typename Source::value_type>& options = basic_csv_decode_options<typename Source::value_type>(),
+                           std::size_t block_rows = 0,
+                           const TempAllocator& temp_alloc = TempAllocator())
+    {
+        using char_type = typename Source::value_type;
+
+        std::error_code ec;
+        std::size_t line = 0;
+        std::size_t column = 0;
+        detail::transcode_csv<char_type,jsoncons::string_source<char_type>>(s, visitor, options, block_rows, true, temp_alloc, ec, line, column);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec, line, column));
+        }
+    }
+
+    template <class CharT,class TempAllocator=std::allocator<char>>
+    void transcode_csv_sequence(std::basic_istream<CharT>& is,
+                                basic_json_visitor<CharT>& visitor,
+                                const basic_csv_decode_options<CharT>& options = basic_csv_decode_options<CharT>(),
+                                std::size_t block_rows = 0,
+                                const TempAllocator& temp_alloc = TempAllocator())
+    {
+        std::error_code ec;
+        std::size_t line = 0;
+        std::size_t column = 0;
+        detail::transcode_csv<CharT,jsoncons::stream_source<CharT>>(is, visitor, options, block_rows, true, temp_alloc, ec, line, column);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec, line, column));
+        }
+    }
+
+}}
+
+#endif
@@ -305,6 +305,10 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
    jsoncons::jsonpatch::detail::operation_unwinder<Json> unwinder(target);
    std::error_code local_ec;
 
+    // Values are read through a const reference, so that reading does not unshare 
+    // arrays and objects held by a copy on write target
+    const Json& root = target;
+
     // Validate
      
     for (const auto& operation : patch.array_range())
@@ -338,7 +342,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
 
         if (op ==jsoncons::jsonpatch::detail::jsonpatch_names<char_type>::test_name())
         {
-            Json val = jsonpointer::get(target,location,local_ec);
+            const Json& val = jsonpointer::get(root,location,local_ec);
             if (local_ec)
             {
                 ec = jsonpatch_errc::test_failed;
@@ -376,7 +380,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
             if (insert_ec) // try a replace
             {
                 std::error_code select_ec;
-                Json orig_val = jsonpointer::get(target,npath,select_ec);
+                Json orig_val = jsonpointer::get(root,npath,select_ec);
                 if (select_ec) // shouldn't happen
                 {
                     ec = jsonpatch_errc::add_failed;
@@ -400,7 +404,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
         }
         else if (op ==jsoncons::jsonpatch::detail::jsonpatch_names<char_type>::remove_name())
         {
-            Json val = jsonpointer::get(target,location,local_ec);
+            Json val = jsonpointer::get(root,location,local_ec);
             if (local_ec)
             {
                 ec = jsonpatch_errc::remove_failed;
@@ -418,7 +422,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
         }
         else if (op ==jsoncons::jsonpatch::detail::jsonpatch_names<char_type>::replace_name())
         {
-            Json val = jsonpointer::get(target,location,local_ec);
+            Json val = jsonpointer::get(root,location,local_ec);
             if (local_ec)
             {
                 ec = jsonpatch_errc::replace_failed;
@@ -459,7 +463,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
                 return;
             }
 
-            Json val = jsonpointer::get(target, from_pointer, local_ec);
+            Json val = jsonpointer::get(root, from_pointer, local_ec);
             if (local_ec)
             {
                 ec = jsonpatch_errc::move_failed;
@@ -481,7 +485,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
             if (insert_ec) // try a replace
             {
                 std::error_code select_ec;
-                Json orig_val = jsonpointer::get(target,npath,select_ec);
+                Json orig_val = jsonpointer::get(root,npath,select_ec);
                 if (select_ec) // shouldn't happen
                 {
                     ec = jsonpatch_errc::copy_failed;
@@ -513,7 +517,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
                 return;
             }
             string_type from = it_from->value().as_string();
-            Json val = jsonpointer::get(target,from,local_ec);
+            Json val = jsonpointer::get(root,from,local_ec);
             if (local_ec)
             {
                 ec = jsonpatch_errc::copy_failed;
@@ -527,7 +531,7 @@ void apply_patch(Json& target, const Json& patch, std::error_code& ec)
             if (insert_ec) // Failed, try a replace
             {
                 std::error_code select_ec;
-                Json orig_val = jsonpointer::get(target,npath, select_ec);
+                Json orig_val = jsonpointer::get(root,npath, select_ec);
                 if (select_ec) // shouldn't happen
                 {
                     ec = jsonpatch_errc::copy_failed;
@@ -56,7 +56,7 @@ namespace mergepatch {
 
     namespace detail {
         template <class Json>
-        Json apply_merge_patch_(Json& target, const Json& patch)
+        void apply_merge_patch_(Json& target, const Json& patch)
         {
             if (patch.is_object())
             {
@@ -69,24 +69,25 @@ namespace mergepatch {
                     auto it = target.find(member.key());
                     if (it != target.object_range().end())
                     {
-                        Json item = it->value();
+                        Json item = std::move(it->value());
                         target.erase(it);
                         if (!member.value().is_null())
                         {
-                            target.try_emplace(member.key(), apply_merge_patch_(item, member.value()));
+                            apply_merge_patch_(item, member.value());
+                            target.try_emplace(member.key(), std::move(item));
                         }
                     }
                     else if (!member.value().is_null())
                     {
                         Json item(json_object_arg);
-                        target.try_emplace(member.key(), apply_merge_patch_(item, member.value()));
+                        apply_merge_patch_(item, member.value());
+                        target.try_emplace(member.key(), std::move(item));
                     }
                 }
-                return target;
             }
             else
             {
-                return patch;
+                target = patch;
             }
         }
     } // namespace detail
@@ -94,7 +95,7 @@ namespace mergepatch {
     template <class Json>
     void apply_merge_patch(Json& target, const Json& patch)
     {
-        target = detail::apply_merge_patch_(target, patch);
+        detail::apply_merge_patch_(target, patch);
     }
 
 } // namespace mergepatch
@@ -14,12 +14,72 @@
 #include <istream> // std::basic_istream
 #include <jsoncons/json.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/columnar_arrays.hpp>
 #include <jsoncons_ext/msgpack/msgpack_encoder.hpp>
 #include <jsoncons_ext/msgpack/msgpack_reader.hpp>
 
 namespace jsoncons { 
 namespace msgpack {
 
+namespace detail {
+
+    // Encodes an array of objects column by column into a nested MessagePack data item, 
+    // and writes it as an ext value
+
+    template <class Json>
+    class columnar_block_encoder
+    {
+        using char_type = typename Json::char_type;
+
+        msgpack_options options_;
+        std::vector<uint8_t> buffer_;
+        jsoncons::detail::columnar_block_writer<Json> writer_;
+    public:
+        explicit columnar_block_encoder(const msgpack_encode_options& options)
+        {
+            options_.max_nesting_depth(options.max_nesting_depth());
+        }
+
+        void operator()(const Json& j, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+        {
+            buffer_.clear();
+            {
+                basic_msgpack_encoder<jsoncons::bytes_sink<std::vector<uint8_t>>> encoder(buffer_, options_);
+                auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
+                writer_.write(j, adaptor, ec);
+            }
+            if (ec)
+            {
+                return;
+            }
+            visitor.byte_string_value(byte_string_view(buffer_), columnar_array_ext_type, ser_context(), ec);
+        }
+    };
+
+    template <class Json, class Encoder>
+    void dump_json(const Json& j, Encoder& encoder, const msgpack_encode_options& options)
+    {
+        using char_type = typename Json::char_type;
+        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
+        if (options.columnar_arrays())
+        {
+            columnar_block_encoder<Json> write_block(options);
+            std::error_code ec;
+            jsoncons::detail::dump_columnar(j, adaptor, write_block, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+            adaptor.flush();
+        }
+        else
+        {
+            j.dump(adaptor);
+        }
+    }
+
+} // namespace detail
+
     template<class T, class ByteContainer>
     typename std::enable_if<extension_traits::is_basic_json<T>::value &&
                             extension_traits::is_back_insertable_byte_container<ByteContainer>::value,void>::type 
@@ -27,10 +87,8 @@ namespace msgpack {
                    ByteContainer& cont, 
                    const msgpack_encode_options& options = msgpack_encode_options())
     {
-        using char_type = typename T::char_type;
         basic_msgpack_encoder<jsoncons::bytes_sink<ByteContainer>> encoder(cont, options);
-        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
-        j.dump(adaptor);
+        detail::dump_json(j, encoder, options);
     }
 
     template<class T, class ByteContainer>
@@ -55,10 +113,8 @@ namespace msgpack {
                    std::ostream& os, 
                    const msgpack_encode_options& options = msgpack_encode_options())
     {
-        using char_type = typename T::char_type;
         msgpack_stream_encoder encoder(os, options);
-        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
-        j.dump(adaptor);
+        detail::dump_json(j, encoder, options);
     }
 
     template<class T>
@@ -76,6 +132,160 @@ namespace msgpack {
         }
     }
 
+    // encoded size
+
+    template<class T>
+    typename std::enable_if<extension_traits::is_basic_json<T>::value,std::size_t>::type 
+    encoded_size(const T& j, 
+                 const msgpack_encode_options& options = msgpack_encode_options())
+    {
+        std::size_t size = 0;
+        basic_msgpack_encoder<jsoncons::counting_sink<uint8_t>> encoder(jsoncons::counting_sink<uint8_t>(size), options);
+        detail::dump_json(j, encoder, options);
+        return size;
+    }
+
+    template<class T>
+    typename std::enable_if<!extension_traits::is_basic_json<T>::value,std::size_t>::type 
+    encoded_size(const T& val, 
+                 const msgpack_encode_options& options = msgpack_encode_options())
+    {
+        std::size_t size = 0;
+        basic_msgpack_encoder<jsoncons::counting_sink<uint8_t>> encoder(jsoncons::counting_sink<uint8_t>(size), options);
+        std::error_code ec;
+        encode_traits<T,char>::encode(val, encoder, json(), ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        return size;
+    }
+
+    // to fixed size buffer
+
+    template<class T>
+    typename std::enable_if<extension_traits::is_basic_json<T>::value,std::size_t>::type 
+    encode_msgpack(const T& j, 
+                   jsoncons::span<uint8_t> buffer, 
+                   const msgpack_encode_options& options = msgpack_encode_options())
+    {
+        std::size_t size = 0;
+        {
+            basic_msgpack_encoder<jsoncons::span_sink<uint8_t>> encoder(jsoncons::span_sink<uint8_t>(buffer, size), options);
+            detail::dump_json(j, encoder, options);
+        }
+        if (size > buffer.size())
+        {
+            JSONCONS_THROW(ser_error(msgpack_errc::buffer_too_small));
+        }
+        return size;
+    }
+
+    template<class T>
+    typename std::enable_if<!extension_traits::is_basic_json<T>::value,std::size_t>::type 
+    encode_msgpack(const T& val, 
+                   jsoncons::span<uint8_t> buffer, 
+                   const msgpack_encode_options& options = msgpack_encode_options())
+    {
+        std::size_t size = 0;
+        {
+            basic_msgpack_encoder<jsoncons::span_sink<uint8_t>> encoder(jsoncons::span_sink<uint8_t>(buffer, size), options);
+            std::error_code ec;
+            encode_traits<T,char>::encode(val, encoder, json(), ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+        if (size > buffer.size())
+        {
+            JSONCONS_THROW(ser_error(msgpack_errc::buffer_too_small));
+        }
+        return size;
+    }
+
+    // basic_msgpack_batch_encoder
+
+    // Encodes a sequence of records into one byte container, reusing the 
+    // encoder's stacks and buffers, and records the offset of each record.
+
+    template <class ByteContainer=std::vector<uint8_t>,class TempAllocator=std::allocator<char>>
+    class basic_msgpack_batch_encoder
+    {
+    public:
+        using container_type = ByteContainer;
+        using allocator_type = TempAllocator;
+    private:
+        container_type* cont_ptr_;
+        msgpack_encode_options options_;
+        std::vector<std::size_t> offsets_;
+        std::size_t offset_;
+        bool dirty_;
+        basic_msgpack_encoder<jsoncons::bytes_sink<ByteContainer>,TempAllocator> encoder_;
+
+        // Noncopyable and nonmoveable
+        basic_msgpack_batch_encoder(const basic_msgpack_batch_encoder&) = delete;
+        basic_msgpack_batch_encoder& operator=(const basic_msgpack_batch_encoder&) = delete;
+    public:
+        explicit basic_msgpack_batch_encoder(container_type& cont, 
+                                             const msgpack_encode_options& options = msgpack_encode_options(),
+                                             const TempAllocator& temp_alloc = TempAllocator())
+            : cont_ptr_(std::addressof(cont)), 
+              options_(options),
+              offset_(cont.size()), 
+              dirty_(false),
+              encoder_(cont, options, temp_alloc)
+        {
+        }
+
+        template <class T>
+        std::size_t encode(const T& val)
+        {
+            if (dirty_)
+            {
+                offset_ = cont_ptr_->size();
+                encoder_.reset();
+            }
+            dirty_ = true;
+            encode(val, std::integral_constant<bool,extension_traits::is_basic_json<T>::value>());
+            offsets_.push_back(offset_);
+            return offset_;
+        }
+
+        const std::vector<std::size_t>& offsets() const
+        {
+            return offsets_;
+        }
+
+        void reset(container_type& cont)
+        {
+            cont_ptr_ = std::addressof(cont);
+            offsets_.clear();
+            offset_ = cont.size();
+            dirty_ = false;
+            encoder_.reset(jsoncons::bytes_sink<ByteContainer>(cont));
+        }
+    private:
+        template <class T>
+        void encode(const T& j, std::true_type)
+        {
+            detail::dump_json(j, encoder_, options_);
+        }
+
+        template <class T>
+        void encode(const T& val, std::false_type)
+        {
+            std::error_code ec;
+            encode_traits<T,char>::encode(val, encoder_, json(), ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+    };
+
+    using msgpack_batch_encoder = basic_msgpack_batch_encoder<std::vector<uint8_t>>;
+
     // with temp_allocator_arg_t
 
     template<class T, class ByteContainer, class Allocator, class TempAllocator>
@@ -85,10 +295,8 @@ namespace msgpack {
                    ByteContainer& cont, 
                    const msgpack_encode_options& options = msgpack_encode_options())
     {
-        using char_type = typename T::char_type;
         basic_msgpack_encoder<jsoncons::bytes_sink<ByteContainer>,TempAllocator> encoder(cont, options, alloc_set.get_temp_allocator());
-        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
-        j.dump(adaptor);
+        detail::dump_json(j, encoder, options);
     }
 
     template<class T, class ByteContainer, class Allocator, class TempAllocator>
@@ -114,10 +322,8 @@ namespace msgpack {
                    std::ostream& os, 
                    const msgpack_encode_options& options = msgpack_encode_options())
     {
-        using char_type = typename T::char_type;
         basic_msgpack_encoder<jsoncons::binary_stream_sink,TempAllocator> encoder(os, options, alloc_set.get_temp_allocator());
-        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
-        j.dump(adaptor);
+        detail::dump_json(j, encoder, options);
     }
 
     template<class T,class Allocator,class TempAllocator>
@@ -383,10 +383,7 @@ namespace msgpack {
                 binary::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
             }
 
-            for (auto c : sv)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::sink_append(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
         }
 
         bool visit_byte_string(const byte_string_view& b, 
@@ -415,10 +412,7 @@ namespace msgpack {
                 binary::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
             }
 
-            for (auto c : b)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::sink_append(sink_, reinterpret_cast<const uint8_t*>(b.data()), b.size());
 
             end_value();
             return true;
@@ -474,10 +468,7 @@ namespace msgpack {
                     break;
             }
 
-            for (auto c : b)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::sink_append(sink_, reinterpret_cast<const uint8_t*>(b.data()), b.size());
 
             end_value();
             return true;
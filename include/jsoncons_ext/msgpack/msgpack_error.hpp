@@ -25,7 +25,9 @@ enum class msgpack_errc
     max_nesting_depth_exceeded,
     length_is_negative,
     invalid_timestamp,
-    unknown_type
+    unknown_type,
+    buffer_too_small,
+    invalid_columnar_array
 };
 
 class msgpack_error_category_impl
@@ -62,6 +64,10 @@ public:
                 return "Invalid timestamp";
             case msgpack_errc::unknown_type:
                 return "An unknown type was found in the stream";
+            case msgpack_errc::buffer_too_small:
+                return "Output buffer is too small for the encoded value";
+            case msgpack_errc::invalid_columnar_array:
+                return "Invalid array of objects written column by column";
             default:
                 return "Unknown MessagePack parser error";
         }
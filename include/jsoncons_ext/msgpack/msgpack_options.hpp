@@ -21,11 +21,12 @@ class msgpack_options_common
     friend class msgpack_options;
 
     int max_nesting_depth_;
+    bool columnar_arrays_;
 protected:
     virtual ~msgpack_options_common() = default;
 
     msgpack_options_common()
-        : max_nesting_depth_(1024)
+        : max_nesting_depth_(1024), columnar_arrays_(false)
     {
     }
 
@@ -38,6 +39,11 @@ public:
     {
         return max_nesting_depth_;
     }
+
+    bool columnar_arrays() const 
+    {
+        return columnar_arrays_;
+    }
 };
 
 class msgpack_decode_options : public virtual msgpack_options_common
@@ -62,12 +68,19 @@ class msgpack_options final : public msgpack_decode_options, public msgpack_enco
 {
 public:
     using msgpack_options_common::max_nesting_depth;
+    using msgpack_options_common::columnar_arrays;
 
     msgpack_options& max_nesting_depth(int value)
     {
         this->max_nesting_depth_ = value;
         return *this;
     }
+
+    msgpack_options& columnar_arrays(bool value)
+    {
+        this->columnar_arrays_ = value;
+        return *this;
+    }
 };
 
 }}
@@ -20,10 +20,11 @@
 #include <jsoncons_ext/msgpack/msgpack_error.hpp>
 #include <jsoncons_ext/msgpack/msgpack_options.hpp>
 #include <jsoncons/item_event_visitor.hpp>
+#include <jsoncons/detail/columnar_arrays.hpp>
 
 namespace jsoncons { namespace msgpack {
 
-enum class parse_mode {root,accept,array,map_key,map_value};
+enum class parse_mode {root,accept,array,map_key,map_value,columnar};
 
 struct parse_state 
 {
@@ -53,6 +54,7 @@ class basic_msgpack_parser : public ser_context
 
     static constexpr int64_t nanos_in_second = 1000000000;
 
+    Allocator alloc_;
     Source source_;
     msgpack_decode_options options_;
     bool more_;
@@ -61,20 +63,23 @@ class basic_msgpack_parser : public ser_context
     std::vector<uint8_t,byte_allocator_type> bytes_buffer_;
     std::vector<parse_state,parse_state_allocator_type> state_stack_;
     int nesting_depth_;
+    jsoncons::detail::columnar_block_reader<Allocator> columnar_reader_;
 
 public:
     template <class Sourceable>
     basic_msgpack_parser(Sourceable&& source,
                          const msgpack_decode_options& options = msgpack_decode_options(),
                          const Allocator& alloc = Allocator())
-       : source_(std::forward<Sourceable>(source)),
+       : alloc_(alloc),
+         source_(std::forward<Sourceable>(source)),
          options_(options),
          more_(true), 
          done_(false),
          text_buffer_(alloc),
          bytes_buffer_(alloc),
          state_stack_(alloc),
-         nesting_depth_(0)
+         nesting_depth_(0),
+         columnar_reader_(alloc)
     {
         state_stack_.emplace_back(parse_mode::root,0);
     }
@@ -173,6 +178,18 @@ public:
                     }
                     break;
                 }
+                case parse_mode::columnar:
+                {
+                    if (state_stack_.back().index < state_stack_.back().length)
+                    {
+                        more_ = columnar_reader_.produce_event(state_stack_.back().index++, visitor, *this, ec);
+                    }
+                    else
+                    {
+                        end_array(visitor, ec);
+                    }
+                    break;
+                }
                 case parse_mode::root:
                 {
                     state_stack_.back().mode = parse_mode::accept;
@@ -195,8 +212,172 @@ public:
             }
         }
     }
+
+    // Skips the remaining items of the innermost array or map without
+    // producing events, so that the next call to parse produces its end.
+    // All MessagePack lengths are definite, so nested items are passed over
+    // by keeping a count of the items still to be skipped.
+    void skip_to_end(std::error_code& ec)
+    {
+        more_ = true;
+        parse_state& state = state_stack_.back();
+        if (state.mode == parse_mode::columnar)
+        {
+            // Rows are produced from a block that has already been read
+            const std::size_t per_row = columnar_reader_.row_event_count();
+            const std::size_t pos = state.index % per_row;
+            state.index = pos != 0 ? state.index + (per_row - 1 - pos) : state.length;
+            return;
+        }
+        if (state.mode != parse_mode::array && state.mode != parse_mode::map_key)
+        {
+            return;
+        }
+        uint64_t count = state.length - state.index;
+        if (state.mode == parse_mode::map_key)
+        {
+            count *= 2;
+        }
+        state.index = state.length;
+
+        while (count > 0)
+        {
+            --count;
+            uint8_t type;
+            if (source_.read(&type, 1) == 0)
+            {
+                ec = msgpack_errc::unexpected_eof;
+                more_ = false;
+                return;
+            }
+            if (type <= 0x7f || type >= 0xe0) 
+            {
+                // positive or negative fixint
+                continue;
+            }
+            if (type <= 0x8f) 
+            {
+                count += 2*static_cast<uint64_t>(type & 0x0f); // fixmap
+                continue;
+            }
+            if (type <= 0x9f) 
+            {
+                count += type & 0x0f; // fixarray
+                continue;
+            }
+            if (type <= 0xbf) 
+            {
+                skip_bytes(type & 0x1f, ec); // fixstr
+                if (ec)
+                {
+                    return;
+                }
+                continue;
+            }
+            switch (type)
+            {
+                case jsoncons::msgpack::msgpack_type::nil_type: 
+                case jsoncons::msgpack::msgpack_type::true_type:
+                case jsoncons::msgpack::msgpack_type::false_type:
+                    break;
+                case jsoncons::msgpack::msgpack_type::uint8_type: 
+                case jsoncons::msgpack::msgpack_type::int8_type: 
+                    skip_bytes(1, ec);
+                    break;
+                case jsoncons::msgpack::msgpack_type::uint16_type: 
+                case jsoncons::msgpack::msgpack_type::int16_type: 
+                    skip_bytes(2, ec);
+                    break;
+                case jsoncons::msgpack::msgpack_type::float32_type: 
+                case jsoncons::msgpack::msgpack_type::uint32_type: 
+                case jsoncons::msgpack::msgpack_type::int32_type: 
+                    skip_bytes(4, ec);
+                    break;
+                case jsoncons::msgpack::msgpack_type::float64_type: 
+                case jsoncons::msgpack::msgpack_type::uint64_type: 
+                case jsoncons::msgpack::msgpack_type::int64_type: 
+                    skip_bytes(8, ec);
+                    break;
+                case jsoncons::msgpack::msgpack_type::str8_type: 
+                case jsoncons::msgpack::msgpack_type::str16_type: 
+                case jsoncons::msgpack::msgpack_type::str32_type: 
+                case jsoncons::msgpack::msgpack_type::bin8_type: 
+                case jsoncons::msgpack::msgpack_type::bin16_type: 
+                case jsoncons::msgpack::msgpack_type::bin32_type: 
+                {
+                    std::size_t len = get_size(type, ec);
+                    if (!more_)
+                    {
+                        return;
+                    }
+                    skip_bytes(len, ec);
+                    break;
+                }
+                case jsoncons::msgpack::msgpack_type::fixext1_type: 
+                case jsoncons::msgpack::msgpack_type::fixext2_type: 
+                case jsoncons::msgpack::msgpack_type::fixext4_type: 
+                case jsoncons::msgpack::msgpack_type::fixext8_type: 
+                case jsoncons::msgpack::msgpack_type::fixext16_type: 
+                case jsoncons::msgpack::msgpack_type::ext8_type: 
+                case jsoncons::msgpack::msgpack_type::ext16_type: 
+                case jsoncons::msgpack::msgpack_type::ext32_type: 
+                {
+                    std::size_t len = get_size(type, ec);
+                    if (!more_)
+                    {
+                        return;
+                    }
+                    skip_bytes(len + 1, ec); // ext type and payload
+                    break;
+                }
+                case jsoncons::msgpack::msgpack_type::array16_type: 
+                case jsoncons::msgpack::msgpack_type::array32_type: 
+                {
+                    std::size_t len = get_size(type, ec);
+                    if (!more_)
+                    {
+                        return;
+                    }
+                    count += len;
+                    break;
+                }
+                case jsoncons::msgpack::msgpack_type::map16_type : 
+                case jsoncons::msgpack::msgpack_type::map32_type : 
+                {
+                    std::size_t len = get_size(type, ec);
+                    if (!more_)
+                    {
+                        return;
+                    }
+                    count += 2*static_cast<uint64_t>(len);
+                    break;
+                }
+                default:
+                {
+                    ec = msgpack_errc::unknown_type;
+                    more_ = false;
+                    return;
+                }
+            }
+            if (ec)
+            {
+                return;
+            }
+        }
+    }
 private:
 
+    void skip_bytes(std::size_t length, std::error_code& ec)
+    {
+        std::size_t position = source_.position();
+        source_.ignore(length);
+        if (source_.position() - position != length)
+        {
+            ec = msgpack_errc::unexpected_eof;
+            more_ = false;
+        }
+    }
+
     void read_item(item_event_visitor& visitor, std::error_code& ec)
     {
         if (source_.is_error())
@@ -582,10 +763,17 @@ private:
                             return;
                         }
 
-                        more_ = visitor.byte_string_value(byte_string_view(bytes_buffer_.data(),bytes_buffer_.size()), 
-                                                          static_cast<uint8_t>(ext_type), 
-                                                          *this,
-                                                          ec);
+                        if (ext_type == columnar_array_ext_type && options_.columnar_arrays())
+                        {
+                            begin_columnar_array(visitor, ec);
+                        }
+                        else
+                        {
+                            more_ = visitor.byte_string_value(byte_string_view(bytes_buffer_.data(),bytes_buffer_.size()), 
+                                                              static_cast<uint8_t>(ext_type), 
+                                                              *this,
+                                                              ec);
+                        }
                     }
                     break;
                 }
@@ -631,6 +819,36 @@ private:
         more_ = visitor.begin_array(length, semantic_tag::none, *this, ec);
     }
 
+    // Reads a block written column by column from bytes_buffer_, 
+    // its rows are then produced by parse
+    void begin_columnar_array(item_event_visitor& visitor, std::error_code& ec)
+    {
+        columnar_reader_.reset();
+        basic_msgpack_parser<bytes_source,Allocator> parser(bytes_buffer_, options_, alloc_);
+        parser.parse(columnar_reader_, ec);
+        if (ec)
+        {
+            more_ = false;
+            return;
+        }
+        if (!columnar_reader_.done())
+        {
+            ec = msgpack_errc::invalid_columnar_array;
+            more_ = false;
+            return;
+        }
+        // The array and its row objects
+        if (JSONCONS_UNLIKELY(nesting_depth_ + 2 > options_.max_nesting_depth()))
+        {
+            ec = msgpack_errc::max_nesting_depth_exceeded;
+            more_ = false;
+            return;
+        } 
+        ++nesting_depth_;
+        state_stack_.emplace_back(parse_mode::columnar, columnar_reader_.event_count());
+        more_ = visitor.begin_array(columnar_reader_.num_rows(), semantic_tag::none, *this, ec);
+    }
+
     void end_array(item_event_visitor& visitor, std::error_code& ec)
     {
         --nesting_depth_;
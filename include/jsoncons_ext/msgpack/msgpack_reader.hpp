@@ -71,6 +71,13 @@ public:
     {
     }
 
+    template <class Sourceable>
+    void reset(Sourceable&& source)
+    {
+        parser_.reset(std::forward<Sourceable>(source));
+        adaptor_.reset();
+    }
+
     void read()
     {
         std::error_code ec;
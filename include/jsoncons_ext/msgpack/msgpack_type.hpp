@@ -56,6 +56,9 @@ namespace jsoncons { namespace msgpack {
         const uint8_t map32_type = 0xdf;
         const uint8_t negative_fixint_base_type = 0xe0;
     }
+
+    // Extension type of a byte string that holds an array of objects encoded column by column
+    const uint8_t columnar_array_ext_type = 0x63;
  
 } // namespace msgpack
 } // namespace jsoncons
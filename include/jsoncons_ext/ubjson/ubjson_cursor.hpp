@@ -186,6 +186,34 @@ public:
         read_next(ec);
     }
 
+    void skip() override
+    {
+        std::error_code ec;
+        skip(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,parser_.line(),parser_.column()));
+        }
+    }
+
+    void skip(std::error_code& ec) override
+    {
+        switch (current().event_type())
+        {
+            case staj_event_type::begin_object:
+            case staj_event_type::begin_array:
+                parser_.skip_to_end(ec);
+                if (ec)
+                {
+                    return;
+                }
+                break;
+            default:
+                break;
+        }
+        basic_staj_cursor<char_type>::skip(ec);
+    }
+
     const ser_context& context() const override
     {
         return *this;
@@ -310,7 +310,338 @@ public:
             }
         }
     }
+
+    // Skips the remaining items of the innermost array or object without
+    // producing events, so that the next call to parse produces its end.
+    // Strongly typed containers with a fixed size element type are
+    // passed over with a single seek.
+    void skip_to_end(std::error_code& ec)
+    {
+        more_ = true;
+        parse_state& state = state_stack_.back();
+        switch (state.mode)
+        {
+            case parse_mode::array:
+            case parse_mode::map_key:
+            {
+                const bool is_map = state.mode == parse_mode::map_key;
+                while (state_stack_.back().index < state_stack_.back().length)
+                {
+                    ++state_stack_.back().index;
+                    if (is_map)
+                    {
+                        skip_key(ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                    }
+                    skip_type_and_value(1, ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                }
+                break;
+            }
+            case parse_mode::strongly_typed_array:
+            case parse_mode::strongly_typed_map_key:
+            {
+                const bool is_map = state.mode == parse_mode::strongly_typed_map_key;
+                const uint8_t type = state.type;
+                std::size_t count = state.length - state.index;
+                state.index = state.length;
+
+                std::size_t size = fixed_value_size(type);
+                if (!is_map && size != (std::numeric_limits<std::size_t>::max)())
+                {
+                    if (size > 0 && count > (std::numeric_limits<std::size_t>::max)() / size)
+                    {
+                        ec = ubjson_errc::number_too_large;
+                        more_ = false;
+                        return;
+                    }
+                    skip_bytes(count*size, ec);
+                    return;
+                }
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (is_map)
+                    {
+                        skip_key(ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                    }
+                    skip_value(type, 1, ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                }
+                break;
+            }
+            case parse_mode::indefinite_array:
+            case parse_mode::indefinite_map_key:
+            {
+                const bool is_map = state.mode == parse_mode::indefinite_map_key;
+                const uint8_t end_marker = is_map ? jsoncons::ubjson::ubjson_type::end_object_marker : jsoncons::ubjson::ubjson_type::end_array_marker;
+                while (true)
+                {
+                    auto c = source_.peek();
+                    if (c.eof)
+                    {
+                        ec = ubjson_errc::unexpected_eof;
+                        more_ = false;
+                        return;
+                    }
+                    if (c.value == end_marker)
+                    {
+                        break;
+                    }
+                    if (is_map)
+                    {
+                        skip_key(ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                    }
+                    skip_type_and_value(1, ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
 private:
+    static std::size_t fixed_value_size(uint8_t type)
+    {
+        switch (type)
+        {
+            case jsoncons::ubjson::ubjson_type::null_type: 
+            case jsoncons::ubjson::ubjson_type::no_op_type: 
+            case jsoncons::ubjson::ubjson_type::true_type:
+            case jsoncons::ubjson::ubjson_type::false_type:
+                return 0;
+            case jsoncons::ubjson::ubjson_type::int8_type: 
+            case jsoncons::ubjson::ubjson_type::uint8_type: 
+            case jsoncons::ubjson::ubjson_type::char_type: 
+                return 1;
+            case jsoncons::ubjson::ubjson_type::int16_type: 
+                return 2;
+            case jsoncons::ubjson::ubjson_type::int32_type: 
+            case jsoncons::ubjson::ubjson_type::float32_type: 
+                return 4;
+            case jsoncons::ubjson::ubjson_type::int64_type: 
+            case jsoncons::ubjson::ubjson_type::float64_type: 
+                return 8;
+            default:
+                return (std::numeric_limits<std::size_t>::max)();
+        }
+    }
+
+    void skip_bytes(std::size_t length, std::error_code& ec)
+    {
+        std::size_t position = source_.position();
+        source_.ignore(length);
+        if (source_.position() - position != length)
+        {
+            ec = ubjson_errc::unexpected_eof;
+            more_ = false;
+        }
+    }
+
+    void skip_key(std::error_code& ec)
+    {
+        std::size_t length = get_length(ec);
+        if (ec)
+        {
+            ec = ubjson_errc::key_expected;
+            more_ = false;
+            return;
+        }
+        skip_bytes(length, ec);
+    }
+
+    void skip_type_and_value(int depth, std::error_code& ec)
+    {
+        uint8_t b;
+        if (source_.read(&b, 1) == 0)
+        {
+            ec = ubjson_errc::unexpected_eof;
+            more_ = false;
+            return;
+        }
+        skip_value(b, depth, ec);
+    }
+
+    void skip_value(uint8_t type, int depth, std::error_code& ec)
+    {
+        std::size_t size = fixed_value_size(type);
+        if (size != (std::numeric_limits<std::size_t>::max)())
+        {
+            skip_bytes(size, ec);
+            return;
+        }
+        switch (type)
+        {
+            case jsoncons::ubjson::ubjson_type::string_type: 
+            case jsoncons::ubjson::ubjson_type::high_precision_number_type: 
+            {
+                std::size_t length = get_length(ec);
+                if (ec)
+                {
+                    return;
+                }
+                skip_bytes(length, ec);
+                break;
+            }
+            case jsoncons::ubjson::ubjson_type::start_array_marker: 
+            case jsoncons::ubjson::ubjson_type::start_object_marker: 
+            {
+                if (JSONCONS_UNLIKELY(nesting_depth_ + depth > options_.max_nesting_depth()))
+                {
+                    ec = ubjson_errc::max_nesting_depth_exceeded;
+                    more_ = false;
+                    return;
+                } 
+                const bool is_map = type == jsoncons::ubjson::ubjson_type::start_object_marker;
+                auto c = source_.peek();
+                if (c.eof)
+                {
+                    ec = ubjson_errc::unexpected_eof;
+                    more_ = false;
+                    return;
+                }
+                uint8_t item_type = 0;
+                bool strongly_typed = false;
+                if (c.value == jsoncons::ubjson::ubjson_type::type_marker)
+                {
+                    source_.ignore(1);
+                    if (source_.read(&item_type, 1) == 0)
+                    {
+                        ec = ubjson_errc::unexpected_eof;
+                        more_ = false;
+                        return;
+                    }
+                    c = source_.peek();
+                    if (c.eof)
+                    {
+                        ec = ubjson_errc::unexpected_eof;
+                        more_ = false;
+                        return;
+                    }
+                    if (c.value != jsoncons::ubjson::ubjson_type::count_marker)
+                    {
+                        ec = ubjson_errc::count_required_after_type;
+                        more_ = false;
+                        return;
+                    }
+                    strongly_typed = true;
+                }
+                if (c.value == jsoncons::ubjson::ubjson_type::count_marker)
+                {
+                    source_.ignore(1);
+                    std::size_t length = get_length(ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    if (length > options_.max_items())
+                    {
+                        ec = ubjson_errc::max_items_exceeded;
+                        more_ = false;
+                        return;
+                    }
+                    if (strongly_typed && !is_map)
+                    {
+                        size = fixed_value_size(item_type);
+                        if (size != (std::numeric_limits<std::size_t>::max)())
+                        {
+                            if (size > 0 && length > (std::numeric_limits<std::size_t>::max)() / size)
+                            {
+                                ec = ubjson_errc::number_too_large;
+                                more_ = false;
+                                return;
+                            }
+                            skip_bytes(length*size, ec);
+                            return;
+                        }
+                    }
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        if (is_map)
+                        {
+                            skip_key(ec);
+                            if (ec)
+                            {
+                                return;
+                            }
+                        }
+                        if (strongly_typed)
+                        {
+                            skip_value(item_type, depth+1, ec);
+                        }
+                        else
+                        {
+                            skip_type_and_value(depth+1, ec);
+                        }
+                        if (ec)
+                        {
+                            return;
+                        }
+                    }
+                }
+                else
+                {
+                    const uint8_t end_marker = is_map ? jsoncons::ubjson::ubjson_type::end_object_marker : jsoncons::ubjson::ubjson_type::end_array_marker;
+                    while (true)
+                    {
+                        c = source_.peek();
+                        if (c.eof)
+                        {
+                            ec = ubjson_errc::unexpected_eof;
+                            more_ = false;
+                            return;
+                        }
+                        if (c.value == end_marker)
+                        {
+                            source_.ignore(1);
+                            break;
+                        }
+                        if (is_map)
+                        {
+                            skip_key(ec);
+                            if (ec)
+                            {
+                                return;
+                            }
+                        }
+                        skip_type_and_value(depth+1, ec);
+                        if (ec)
+                        {
+                            return;
+                        }
+                    }
+                }
+                break;
+            }
+            default:
+            {
+                ec = ubjson_errc::unknown_type;
+                more_ = false;
+                break;
+            }
+        }
+    }
+
     void read_type_and_value(json_visitor& visitor, std::error_code& ec)
     {
         if (source_.is_error())
@@ -302,3 +302,62 @@ TEMPLATE_TEST_CASE("bson_cursor reset test", "",
         check_bson_cursor_document("third document", cursor, "c", 3);
     }
 }
+
+TEST_CASE("bson_cursor skip test")
+{
+    ojson j = ojson::parse(R"(
+    {
+        "first": [1, {"x": "skipped string", "y": [1.5, -2, true, null]}, "abc"],
+        "second": {"c": -5, "d": "skipped too"},
+        "third": 10
+    }
+    )");
+    std::vector<uint8_t> data;
+    bson::encode_bson(j, data);
+
+    SECTION("nested documents")
+    {
+        bson::bson_bytes_cursor cursor(data);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("first"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("second"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("third"));
+        cursor.next();
+        CHECK(cursor.current().get<int>() == 10);
+        cursor.skip(); // not a container, same as next
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.done());
+    }
+
+    SECTION("skip root")
+    {
+        bson::bson_bytes_cursor cursor(data);
+        std::error_code ec;
+        cursor.skip(ec);
+        REQUIRE_FALSE(ec);
+        CHECK(cursor.done());
+    }
+
+    SECTION("unexpected eof")
+    {
+        data.resize(20);
+
+        bson::bson_bytes_cursor cursor(data);
+        cursor.next();
+        cursor.next();
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == bson::bson_errc::unexpected_eof);
+    }
+}
+
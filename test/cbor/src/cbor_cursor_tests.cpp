@@ -384,3 +384,137 @@ TEMPLATE_TEST_CASE("cbor_cursor reset test", "",
         CHECK(cursor.done());
     }
 }
+
+TEST_CASE("cbor_cursor skip test")
+{
+    ojson j = ojson::parse(R"(
+    {
+        "first": [1, {"x": "skipped string", "y": [1.5, -2, true, null]}, "abc"],
+        "second": {"c": -5, "d": "skipped too"},
+        "third": 10
+    }
+    )");
+
+    SECTION("definite lengths")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+
+        cbor::cbor_bytes_cursor cursor(data);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("first"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("second"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("third"));
+        cursor.skip(); // not a container, same as next
+        REQUIRE(cursor.current().event_type() == staj_event_type::uint64_value);
+        CHECK(cursor.current().get<int>() == 10);
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.done());
+    }
+
+    SECTION("skip root")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+
+        cbor::cbor_bytes_cursor cursor(data);
+        std::error_code ec;
+        cursor.skip(ec);
+        REQUIRE_FALSE(ec);
+        CHECK(cursor.done());
+    }
+
+    SECTION("stringrefs in skipped items")
+    {
+        ojson k = ojson::parse(R"(
+        {
+            "skipped": ["repeated string", "repeated string", "another string"],
+            "kept": ["another string", "repeated string"]
+        }
+        )");
+        std::vector<uint8_t> data;
+        cbor::cbor_options options;
+        options.pack_strings(true);
+        cbor::encode_cbor(k, data, options);
+
+        cbor::cbor_bytes_cursor cursor(data);
+        cursor.next();
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("kept"));
+        cursor.next();
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("another string"));
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("repeated string"));
+    }
+
+    SECTION("indefinite lengths")
+    {
+        std::vector<uint8_t> data = {
+            0x9f, // indefinite array
+                0xbf, // indefinite map
+                    0x61,'a', 0x9f,0x01,0x7f,0x62,'b','c',0x61,'d',0xff,0xff, // "a": [1,"bcd"]
+                    0x61,'e', 0xf5, // "e": true
+                0xff,
+                0x63,'x','y','z', // "xyz"
+            0xff
+        };
+
+        cbor::cbor_bytes_cursor cursor(data);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::string_value);
+        CHECK(cursor.current().get<std::string>() == std::string("xyz"));
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::end_array);
+        cursor.next();
+        CHECK(cursor.done());
+    }
+
+    SECTION("typed array")
+    {
+        std::vector<uint8_t> data = {
+            0x82, // array(2)
+                0xd8,0x40,0x43,0x01,0x02,0x03, // uint8 typed array [1,2,3]
+                0x07
+        };
+
+        cbor::cbor_bytes_cursor cursor(data);
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::uint64_value);
+        CHECK(cursor.current().get<int>() == 7);
+    }
+
+    SECTION("unexpected eof")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+        data.resize(20);
+
+        cbor::cbor_bytes_cursor cursor(data);
+        cursor.next();
+        cursor.next();
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+    }
+}
+
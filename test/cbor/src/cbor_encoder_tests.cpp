@@ -529,3 +529,25 @@ TEMPLATE_TEST_CASE("test_cbor_encoder_reset", "",
     f.encoder.flush();
     CHECK(f.bytes2() == expected_full);
 }
+
+TEST_CASE("cbor encoder with chunked_sink")
+{
+    json j = json::parse(R"({"data":[1,2,3,-4.5,"a text string that spans blocks"],"flag":false})");
+
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(j, expected);
+
+    chunked_buffer<uint8_t> buf(16);
+    {
+        cbor::basic_cbor_encoder<chunked_sink<uint8_t>> encoder(buf);
+        j.dump(encoder);
+    }
+    std::vector<uint8_t> result;
+    for (std::size_t i = 0; i < buf.segment_count(); ++i)
+    {
+        auto seg = buf.segment(i);
+        result.insert(result.end(), seg.begin(), seg.end());
+    }
+    CHECK(buf.segment_count() > 1);
+    CHECK(result == expected);
+}
@@ -734,3 +734,23 @@ TEST_CASE("CBOR stringref tag 3")
 
     CHECK(expected == j);
 }
+
+TEST_CASE("cbor to json_tape")
+{
+    json j = json::parse(R"({"name":"a","values":[1,-2,3.5],"flag":true})");
+    j["data"] = json(byte_string_arg, std::vector<uint8_t>{1,2,3}, semantic_tag::base64url);
+
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(j, data);
+
+    json_tape_decoder decoder;
+    cbor::cbor_bytes_reader reader(data, decoder);
+    reader.read();
+    json_tape tape = decoder.get_result();
+
+    auto root = tape.root();
+    CHECK(root["values"][1].as<int>() == -2);
+    CHECK(root["data"].as_byte_string_view().size() == 3);
+    CHECK(root["data"].tag() == semantic_tag::base64url);
+    CHECK(root.to_json<json>() == j);
+}
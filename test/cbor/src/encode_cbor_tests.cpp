@@ -248,3 +248,355 @@ TEST_CASE("encode_cbor allocator_set for temp only")
 }
 
 #endif
+
+TEST_CASE("cbor encoded_size and fixed size buffer")
+{
+    json j = json::parse(R"(
+    {
+        "name" : "John Smith",
+        "photo" : null,
+        "tags" : ["a", "bb", "ccc", 1, -1000, 1.5, true],
+        "scores" : {"math" : 95, "physics" : 83.25}
+    }
+    )");
+    j["photo"] = json(byte_string_arg, std::vector<uint8_t>(300, 'x'));
+
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(j, expected);
+
+    SECTION("json encoded_size")
+    {
+        CHECK(cbor::encoded_size(j) == expected.size());
+    }
+    SECTION("custom encoded_size")
+    {
+        ns::Person person{"John Smith"};
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(person, data);
+        CHECK(cbor::encoded_size(person) == data.size());
+    }
+    SECTION("pre-reserved container")
+    {
+        std::vector<uint8_t> data;
+        data.reserve(cbor::encoded_size(j));
+        const uint8_t* p = data.data();
+        cbor::encode_cbor(j, data);
+        CHECK(data.data() == p);
+        CHECK(data == expected);
+    }
+    SECTION("fixed size buffer")
+    {
+        std::vector<uint8_t> buffer(1024, 0xff);
+        std::size_t n = cbor::encode_cbor(j, jsoncons::span<uint8_t>(buffer.data(), buffer.size()));
+        REQUIRE(n == expected.size());
+        CHECK(std::equal(expected.begin(), expected.end(), buffer.begin()));
+        CHECK(buffer[n] == 0xff);
+    }
+    SECTION("buffer too small")
+    {
+        std::vector<uint8_t> buffer(expected.size() - 1);
+        REQUIRE_THROWS_WITH(cbor::encode_cbor(j, jsoncons::span<uint8_t>(buffer.data(), buffer.size())),
+                            Catch::Matchers::Contains(cbor::make_error_code(cbor::cbor_errc::buffer_too_small).message()));
+    }
+}
+
+TEST_CASE("cbor_batch_encoder and cbor_batch_decoder")
+{
+    std::vector<json> records;
+    records.push_back(json::parse(R"({"id":1,"name":"Alice","tags":["x","y"]})"));
+    records.push_back(json::parse(R"({"id":2,"name":"Bob","tags":["x","y"]})"));
+    records.push_back(json::parse(R"([1.5,"Alice",null,true])"));
+
+    SECTION("json records")
+    {
+        std::vector<uint8_t> expected;
+        std::vector<std::size_t> expected_offsets;
+        for (const auto& rec : records)
+        {
+            expected_offsets.push_back(expected.size());
+            cbor::encode_cbor(rec, expected);
+        }
+
+        std::vector<uint8_t> data;
+        cbor::cbor_batch_encoder encoder(data);
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            CHECK(encoder.encode(records[i]) == expected_offsets[i]);
+        }
+        CHECK(encoder.offsets() == expected_offsets);
+        CHECK(data == expected);
+
+        cbor::cbor_batch_decoder<json> decoder;
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            std::size_t end = i+1 < records.size() ? expected_offsets[i+1] : data.size();
+            std::vector<uint8_t> record(data.begin()+expected_offsets[i], data.begin()+end);
+            CHECK(decoder.decode(record) == records[i]);
+        }
+    }
+    SECTION("custom records and reset")
+    {
+        std::vector<uint8_t> data1;
+        cbor::cbor_batch_encoder encoder(data1);
+        encoder.encode(ns::Person{"John Smith"});
+        encoder.encode(ns::Person{"Jane Doe"});
+        CHECK(encoder.offsets().size() == 2);
+
+        std::vector<uint8_t> data2;
+        encoder.reset(data2);
+        CHECK(encoder.offsets().empty());
+        encoder.encode(ns::Person{"Jane Doe"});
+        CHECK(encoder.offsets() == std::vector<std::size_t>{0});
+
+        std::vector<uint8_t> record(data1.begin()+encoder.offsets()[0], data1.end());
+        CHECK(data2 == std::vector<uint8_t>(data1.begin()+static_cast<std::ptrdiff_t>(data1.size()-data2.size()), data1.end()));
+        CHECK(cbor::decode_cbor<ns::Person>(data2).name == "Jane Doe");
+    }
+    SECTION("decoder recovers after error")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(records[0], data);
+        std::vector<uint8_t> truncated(data.begin(), data.begin()+static_cast<std::ptrdiff_t>(data.size()/2));
+
+        cbor::cbor_batch_decoder<json> decoder;
+        std::error_code ec;
+        decoder.decode(truncated, ec);
+        CHECK(ec);
+        ec = std::error_code();
+        CHECK(decoder.decode(data, ec) == records[0]);
+        CHECK_FALSE(ec);
+    }
+}
+
+TEST_CASE("cbor_batch_encoder with pack_strings")
+{
+    json rec = json::parse(R"([{"name":"Alice","name2":"Alice"},"Alice"])");
+
+    cbor::cbor_options options;
+    options.pack_strings(true);
+
+    std::vector<uint8_t> data;
+    cbor::cbor_batch_encoder encoder(data, options);
+    encoder.encode(rec);
+    encoder.encode(rec);
+    REQUIRE(encoder.offsets().size() == 2);
+
+    std::vector<uint8_t> first(data.begin(), data.begin()+static_cast<std::ptrdiff_t>(encoder.offsets()[1]));
+    std::vector<uint8_t> second(data.begin()+static_cast<std::ptrdiff_t>(encoder.offsets()[1]), data.end());
+    CHECK(first == second);
+
+    cbor::cbor_batch_decoder<json> decoder;
+    CHECK(decoder.decode(first) == rec);
+    CHECK(decoder.decode(second) == rec);
+}
+
+TEST_CASE("cbor columnar_arrays")
+{
+    json j = json::parse(R"(
+{
+    "readings" : [
+        {"sensor" : "a1", "count" : 1, "temperature" : 20.5, "ok" : true},
+        {"sensor" : "b2", "count" : 300, "temperature" : 21.25, "ok" : false},
+        {"sensor" : "c3", "count" : 70000, "temperature" : 19.1, "ok" : true},
+        {"sensor" : "a1", "count" : -5, "temperature" : 22.0, "ok" : null}
+    ],
+    "other" : [{"a" : 1}, {"b" : 2}],
+    "empty" : []
+}
+    )");
+
+    auto options = cbor::cbor_options{}
+        .columnar_arrays(true);
+
+    SECTION("round trip")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data, options);
+
+        std::vector<uint8_t> row_data;
+        cbor::encode_cbor(j, row_data);
+        CHECK(data != row_data);
+
+        CHECK(cbor::decode_cbor<json>(data, options) == j);
+    }
+
+    SECTION("smaller for many rows")
+    {
+        json rows(json_array_arg);
+        for (int i = 0; i < 100; ++i)
+        {
+            json row;
+            row.try_emplace("id", i);
+            row.try_emplace("value", i*0.5);
+            rows.push_back(std::move(row));
+        }
+
+        CHECK(cbor::encoded_size(rows, options) < cbor::encoded_size(rows));
+
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(rows, data, options);
+        CHECK(cbor::decode_cbor<json>(data, options) == rows);
+    }
+
+    SECTION("with pack_strings")
+    {
+        json blocks(json_array_arg);
+        blocks.push_back(j.at("readings"));
+        blocks.push_back(j.at("readings"));
+
+        auto packed_options = cbor::cbor_options{}
+            .columnar_arrays(true)
+            .pack_strings(true);
+
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(blocks, data, packed_options);
+        CHECK(cbor::decode_cbor<json>(data, packed_options) == blocks);
+    }
+
+    SECTION("cursor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j.at("readings"), data, options);
+
+        cbor::cbor_bytes_cursor cursor(data, options);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        CHECK(cursor.current().size() == 4);
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("count"));
+        cursor.next();
+        CHECK(cursor.current().get<int>() == 300);
+        cursor.next();
+        cursor.next();
+        CHECK_FALSE(cursor.current().get<bool>());
+        cursor.next();
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("b2"));
+        cursor.next();
+        cursor.next();
+        CHECK(cursor.current().get<double>() == 21.25);
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.reset(data);
+        cursor.skip();
+        CHECK(cursor.done());
+    }
+
+    SECTION("tagged values are written row by row")
+    {
+        json rows(json_array_arg);
+        for (int i = 0; i < 3; ++i)
+        {
+            json row;
+            row.try_emplace("time", "2023-01-01T00:00:00Z", semantic_tag::datetime);
+            row.try_emplace("value", json(bigint(i)));
+            rows.push_back(std::move(row));
+        }
+
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(rows, data, options);
+        std::vector<uint8_t> row_data;
+        cbor::encode_cbor(rows, row_data);
+        CHECK(data == row_data);
+
+        json other = cbor::decode_cbor<json>(data, options);
+        CHECK(other == rows);
+        CHECK(other[0].at("time").tag() == semantic_tag::datetime);
+        CHECK(other[2].at("value").tag() == semantic_tag::bigint);
+    }
+
+    SECTION("half values are written row by row")
+    {
+        json rows(json_array_arg);
+        for (int i = 0; i < 3; ++i)
+        {
+            json row;
+            row.try_emplace("value", half_arg, uint16_t(0x3c00));
+            rows.push_back(std::move(row));
+        }
+
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(rows, data, options);
+        std::vector<uint8_t> row_data;
+        cbor::encode_cbor(rows, row_data);
+        CHECK(data == row_data);
+
+        json other = cbor::decode_cbor<json>(data, options);
+        CHECK(other[1].at("value").as<double>() == 1.0);
+    }
+
+    SECTION("doubles outside the range of float")
+    {
+        json rows(json_array_arg);
+        const double values[] = {1.5, 1e300, -1e300, 3.5e38};
+        for (double d : values)
+        {
+            json row;
+            row.try_emplace("value", d);
+            rows.push_back(std::move(row));
+        }
+
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(rows, data, options);
+        CHECK(cbor::decode_cbor<json>(data, options) == rows);
+    }
+
+    SECTION("not decoded without option")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j.at("readings"), data, options);
+
+        json other = cbor::decode_cbor<json>(data);
+        CHECK(other.is_byte_string());
+        CHECK(other.tag() == semantic_tag::ext);
+        CHECK(other.ext_tag() == cbor::detail::columnar_array_tag);
+    }
+}
+
+namespace {
+
+    // A user supplied sink with push_back but no append
+    class push_back_only_sink
+    {
+        std::vector<uint8_t>& buffer_;
+    public:
+        using value_type = uint8_t;
+
+        push_back_only_sink(std::vector<uint8_t>& buffer)
+            : buffer_(buffer)
+        {
+        }
+
+        void push_back(uint8_t ch)
+        {
+            buffer_.push_back(ch);
+        }
+
+        void flush()
+        {
+        }
+    };
+
+} // namespace
+
+TEST_CASE("cbor encode to sink without append")
+{
+    json j;
+    j["name"] = "Jane Doe";
+    j["data"] = json(byte_string_arg, std::vector<uint8_t>{'a','b','c'});
+    j["value"] = json(bigint::from_string("18446744073709551616"));
+
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(j, expected);
+
+    std::vector<uint8_t> buffer;
+    cbor::basic_cbor_encoder<push_back_only_sink> encoder(buffer);
+    j.dump(encoder);
+
+    CHECK(buffer == expected);
+}
@@ -0,0 +1,165 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <cmath>
+
+using namespace jsoncons;
+
+namespace {
+
+    using cjson = basic_json<char,copy_on_write_policy<sorted_policy>>;
+    using cojson = basic_json<char,copy_on_write_policy<order_preserving_policy>>;
+
+    // The address of a member value, found without unsharing
+    template <class Json>
+    const Json* address_of(const Json& j, const typename Json::string_view_type& name)
+    {
+        return std::addressof(j.at(name));
+    }
+
+} // namespace
+
+TEMPLATE_TEST_CASE("copy_on_write_policy tests", "", cjson, cojson)
+{
+    using Json = TestType;
+
+    Json original = Json::parse(R"(
+        {
+            "books": [{"title" : "Sword of Honour", "price" : 12.0}, {"title" : "Moby Dick", "price" : 8.99}],
+            "store": {"name" : "Bookmart", "address" : {"city" : "Toronto", "country" : "Canada"}, "tags" : ["books","music"]}
+        }
+    )");
+
+    SECTION("copies share arrays and objects")
+    {
+        CHECK_FALSE(original.is_shared());
+
+        Json copy = original;
+
+        CHECK(original.is_shared());
+        CHECK(copy.is_shared());
+        CHECK(copy == original);
+        CHECK(address_of(copy, "books") == address_of(original, "books"));
+        CHECK(address_of(copy, "store") == address_of(original, "store"));
+    }
+
+    SECTION("modifying a copy leaves the original unchanged")
+    {
+        const Json expected = Json::parse(original.to_string());
+
+        Json copy = original;
+        copy["store"]["address"]["city"] = "Montreal";
+        copy["books"].push_back(Json::parse(R"({"title" : "Ulysses"})"));
+
+        CHECK(original == expected);
+        CHECK(copy["store"]["address"]["city"].as_string() == "Montreal");
+        CHECK(copy["books"].size() == 3);
+        CHECK(original["books"].size() == 2);
+    }
+
+    SECTION("only the modified path is copied")
+    {
+        Json copy = original;
+        copy["store"]["address"]["city"] = "Montreal";
+        CHECK_FALSE(copy.is_shared());
+        CHECK_FALSE(original.is_shared());
+
+        const Json& c = copy;
+        const Json& o = original;
+        CHECK(std::addressof(c["store"]["name"]) != std::addressof(o["store"]["name"]));
+        CHECK(std::addressof(c["store"]["address"]["country"]) != std::addressof(o["store"]["address"]["country"]));
+        CHECK(std::addressof(c["store"]["tags"][0]) == std::addressof(o["store"]["tags"][0]));
+        CHECK(std::addressof(c["books"][0]) == std::addressof(o["books"][0]));
+    }
+
+    SECTION("modifying the original leaves a copy unchanged")
+    {
+        Json copy = original;
+        original.erase("books");
+
+        CHECK_FALSE(original.contains("books"));
+        CHECK(copy.contains("books"));
+        CHECK(copy["books"][1]["title"].as_string() == "Moby Dick");
+    }
+
+    SECTION("copy assignment")
+    {
+        Json copy(json_array_arg, {1,2,3});
+        copy = original;
+        CHECK(address_of(copy, "books") == address_of(original, "books"));
+
+        copy = static_cast<const Json&>(copy).at("store");
+        CHECK(copy["name"].as_string() == "Bookmart");
+        CHECK(original["store"]["name"].as_string() == "Bookmart");
+    }
+
+    SECTION("self assignment")
+    {
+        Json copy = original;
+        Json& ref = copy;
+        copy = ref;
+        CHECK(copy == original);
+    }
+}
+
+TEMPLATE_TEST_CASE("assigning an unshared value's own member to it", "", json, cjson)
+{
+    using Json = TestType;
+
+    SECTION("array element")
+    {
+        Json j = Json::parse("[[1,2],3]");
+        j = static_cast<const Json&>(j).at(0);
+        CHECK(j == Json::parse("[1,2]"));
+    }
+
+    SECTION("object member")
+    {
+        Json j = Json::parse(R"({"a":{"b":1},"c":2})");
+        j = static_cast<const Json&>(j).at("a");
+        CHECK(j == Json::parse(R"({"b":1})"));
+    }
+
+    SECTION("element of another kind")
+    {
+        Json j = Json::parse(R"([{"b":"a string too long to be stored inline"},3])");
+        j = static_cast<const Json&>(j).at(0).at("b");
+        CHECK(j.as_string() == "a string too long to be stored inline");
+
+        Json k = Json::parse(R"({"a":[1,2]})");
+        k = static_cast<const Json&>(k).at("a");
+        CHECK(k == Json::parse("[1,2]"));
+    }
+}
+
+TEST_CASE("json is_shared test")
+{
+    json j = json::parse(R"({"a" : [1,2,3]})");
+    json copy = j;
+
+    CHECK_FALSE(j.is_shared());
+    CHECK_FALSE(copy.at("a").is_shared());
+}
+
+TEST_CASE("copy_on_write_policy NaN and shared copies")
+{
+    cjson c(json_array_arg);
+    c.push_back(std::nan(""));
+
+    cjson d = c;
+    CHECK(c == c);
+    CHECK(c == d); // shared, elements are not compared
+
+    d[0]; // non-const access unshares d
+    CHECK_FALSE(d.is_shared());
+    CHECK_FALSE(c == d);
+
+    json j(json_array_arg);
+    j.push_back(std::nan(""));
+    json k = j;
+    CHECK(j == j);
+    CHECK_FALSE(j == k);
+}
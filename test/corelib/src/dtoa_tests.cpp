@@ -6,6 +6,10 @@
 #include <catch/catch.hpp>
 #include <iostream>
 #include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <utility>
+#include <vector>
 
 using namespace jsoncons;
 
@@ -56,7 +60,7 @@ static void check_dtoa(double x, const std::vector<std::string>& expected)
     check_safe_dtoa(x,expected);
 }
 
-TEST_CASE("test grisu3")
+TEST_CASE("test shortest dtoa")
 {
     check_dtoa(1.0e100, {"1e+100"});
     check_dtoa(1.0e-100, {"1e-100"});
@@ -98,3 +102,46 @@ TEST_CASE("test grisu3")
     check_dtoa(0.000071, {"7.1e-05"}); 
 }
 
+
+TEST_CASE("test shortest dtoa boundary values")
+{
+    // The safe method gives 15 or 17 digits, not always the shortest, for these
+    std::vector<std::pair<double,std::string>> cases = {
+        {5e-324, "5e-324"},
+        {5e-310, "5e-310"},
+        {2.2250738585072014e-308, "2.2250738585072014e-308"},
+        {1.7976931348623157e308, "1.7976931348623157e+308"},
+        {9007199254740991.0, "9007199254740991.0"},
+        {9007199254740992.0, "9007199254740992.0"},
+        {1e23, "1e+23"},
+        {0.3, "0.3"}
+    };
+    for (const auto& item : cases)
+    {
+        std::string s;
+        REQUIRE(jsoncons::detail::dtoa_general(item.first, '.', s));
+        CHECK(s == item.second);
+    }
+}
+
+TEST_CASE("test shortest dtoa round trip")
+{
+    jsoncons::detail::chars_to to_double;
+    uint64_t bits = 0x3FF0000000000001;
+    for (int i = 0; i < 100000; ++i)
+    {
+        // xorshift
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        double x;
+        std::memcpy(&x, &bits, sizeof(double));
+        if (!std::isfinite(x))
+        {
+            continue;
+        }
+        std::string s;
+        REQUIRE(jsoncons::detail::dtoa_general(x, '.', s));
+        CHECK(to_double(s.c_str(), s.size()) == x);
+    }
+}
@@ -0,0 +1,119 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    using ijson = basic_json<char,interned_key_policy<sorted_policy>>;
+    using iojson = basic_json<char,interned_key_policy<order_preserving_policy>>;
+
+} // namespace
+
+TEST_CASE("interned_key tests")
+{
+    SECTION("construct and compare")
+    {
+        interned_key a("name");
+        interned_key b(std::string("name"));
+        interned_key c;
+
+        CHECK(a.size() == 4);
+        CHECK(a == b);
+        CHECK_FALSE(a.is_same_entry(b));
+        CHECK(a == "name");
+        CHECK(a == std::string("name"));
+        CHECK(c.empty());
+        CHECK(c < a);
+        CHECK(std::string(a.c_str()) == "name");
+
+        interned_key d = a;
+        CHECK(d.is_same_entry(a));
+    }
+
+    SECTION("key table")
+    {
+        interned_key a;
+        {
+            key_table table;
+            a = table.make_key("name", 4);
+            interned_key b = table.make_key(string_view("name"));
+            interned_key c = table.make_key("other", 5);
+
+            CHECK(a.is_same_entry(b));
+            CHECK(a == b);
+            CHECK(a != c);
+            CHECK(table.size() == 2);
+        }
+        // Keys outlive the table
+        CHECK(a == "name");
+    }
+
+    SECTION("many keys")
+    {
+        key_table table;
+        for (int i = 0; i < 1000; ++i)
+        {
+            std::string s = "key" + std::to_string(i);
+            table.make_key(s.data(), s.size());
+        }
+        CHECK(table.size() == 1000);
+        interned_key a = table.make_key("key500", 6);
+        interned_key b = table.make_key("key500", 6);
+        CHECK(a.is_same_entry(b));
+        CHECK(table.size() == 1000);
+    }
+}
+
+TEST_CASE("json with interned keys")
+{
+    std::string input = R"([{"b":1,"a":"x","c":[1,2]},{"a":2,"b":3,"c":null}])";
+
+    SECTION("sorted")
+    {
+        ijson j = ijson::parse(input);
+        CHECK(j.to_string() == json::parse(input).to_string());
+
+        auto first = j[0].object_range().begin();
+        auto second = j[1].object_range().begin();
+        CHECK(first->key() == "a");
+        CHECK(first->key().is_same_entry(second->key()));
+
+        j[0].insert_or_assign("d", 5);
+        j[0].erase("b");
+        CHECK(j[0].contains("d"));
+        CHECK_FALSE(j[0].contains("b"));
+        CHECK(j[1].at("b").as<int>() == 3);
+
+        ijson copy = j;
+        CHECK(copy == j);
+    }
+
+    SECTION("order preserving")
+    {
+        iojson j = iojson::parse(input);
+        CHECK(j.to_string() == ojson::parse(input).to_string());
+        CHECK(j[0].object_range().begin()->key() == "b");
+    }
+
+    SECTION("key table shared across documents")
+    {
+        key_table table;
+        json_decoder<ijson> decoder(table);
+
+        json_string_reader reader1(R"({"id":1,"name":"a"})", decoder);
+        reader1.read();
+        ijson j1 = decoder.get_result();
+
+        json_string_reader reader2(R"({"id":2,"name":"b"})", decoder);
+        reader2.read();
+        ijson j2 = decoder.get_result();
+
+        CHECK(table.size() == 2);
+        CHECK(j1.object_range().begin()->key().is_same_entry(j2.object_range().begin()->key()));
+    }
+}
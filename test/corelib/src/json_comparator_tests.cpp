@@ -8,6 +8,7 @@
 #include <vector>
 #include <utility>
 #include <ctime>
+#include <unordered_set>
 
 using namespace jsoncons;
 
@@ -536,3 +537,112 @@ TEST_CASE("basic_json bool comparator")
     }
 }
 
+
+TEST_CASE("basic_json compare arrays and objects")
+{
+    SECTION("arrays")
+    {
+        json a = json::parse("[1,[2,[3,4]],5]");
+        json b = json::parse("[1,[2,[3,5]],5]");
+        json c = json::parse("[1,[2,[3,4]]]");
+
+        CHECK(a < b);
+        CHECK(b > a);
+        CHECK(c < a);
+        CHECK(a > c);
+        CHECK(a != b);
+        CHECK(a == json::parse("[1.0,[2,[3,4]],5]"));
+    }
+
+    SECTION("objects")
+    {
+        json a = json::parse(R"({"a":1,"b":{"c":[1,2]}})");
+        json b = json::parse(R"({"a":1,"b":{"c":[1,3]}})");
+        json c = json::parse(R"({"a":1,"c":0})");
+        json d = json::parse(R"({"a":1})");
+
+        CHECK(a < b);
+        CHECK(b > a);
+        CHECK(a < c);
+        CHECK(d < a);
+        CHECK(a != b);
+    }
+}
+
+TEST_CASE("basic_json hash")
+{
+    std::hash<json> hasher;
+
+    SECTION("values that compare equal")
+    {
+        CHECK(hasher(json(1)) == hasher(json(1.0)));
+        CHECK(hasher(json(1)) == hasher(json(uint64_t(1))));
+        CHECK(hasher(json(0.0)) == hasher(json(-0.0)));
+        CHECK(hasher(json("1.5", semantic_tag::bigdec)) == hasher(json(1.5)));
+        CHECK(hasher(json()) == hasher(json(json_object_arg)));
+        CHECK(hasher(json::parse("[1,2,3]")) == hasher(json::parse("[1.0,2,3]")));
+        CHECK(hasher(json::parse(R"({"b":[1,2],"a":"x"})")) == hasher(json::parse(R"({"a":"x","b":[1.0,2]})")));
+
+        ojson o1 = ojson::parse(R"({"b":2,"a":1})");
+        ojson o2 = o1;
+        o2["c"] = 3;
+        o2.erase("c");
+        CHECK(o1 == o2);
+        CHECK(std::hash<ojson>{}(o1) == std::hash<ojson>{}(o2));
+    }
+
+    SECTION("big numbers and strings")
+    {
+        json big("1", semantic_tag::bigint);
+        json text("1");
+        CHECK(big == text);
+        CHECK(text == big);
+        CHECK(hasher(big) == hasher(text));
+
+        json bigdec("1.50", semantic_tag::bigdec);
+        CHECK(bigdec == json(1.5));
+        CHECK(bigdec == json("1.5"));
+        CHECK(hasher(bigdec) == hasher(json(1.5)));
+        CHECK(hasher(bigdec) == hasher(json("1.5")));
+
+        json bigfloat("0x3p-1", semantic_tag::bigfloat);
+        CHECK(bigfloat == json(1.5));
+        CHECK(hasher(bigfloat) == hasher(json(1.5)));
+
+        std::unordered_set<json> set{big, text};
+        CHECK(set.size() == 1);
+    }
+
+    SECTION("big numbers that are not numbers")
+    {
+        json bad("abc", semantic_tag::bigdec);
+        CHECK(bad == json("abc"));
+        CHECK(bad != json(1.5));
+        CHECK(json("1.5", semantic_tag::bigdec) != json("abc"));
+        CHECK(hasher(bad) == hasher(json("abc")));
+        CHECK(hasher(json("2023-01-01", semantic_tag::bigint)) == hasher(json("2023-01-01")));
+        CHECK(json("2023-01-01", semantic_tag::bigint) != json(2023));
+    }
+
+    SECTION("values that differ")
+    {
+        CHECK(hasher(json::parse("[1,2]")) != hasher(json::parse("[2,1]")));
+        CHECK(hasher(json::parse(R"({"a":1,"b":2})")) != hasher(json::parse(R"({"a":2,"b":1})")));
+        CHECK(hasher(json("abc")) != hasher(json("abd")));
+        CHECK(hasher(json(true)) != hasher(json(false)));
+        CHECK(hasher(json::null()) != hasher(json(json_array_arg)));
+    }
+
+    SECTION("unordered_set")
+    {
+        std::unordered_set<json> set;
+        set.insert(json::parse(R"({"id":1,"tags":["a","b"]})"));
+        set.insert(json::parse(R"({"tags":["a","b"],"id":1.0})"));
+        set.insert(json::parse(R"({"id":2,"tags":["a","b"]})"));
+        set.insert(json::parse(R"([1,2])"));
+
+        CHECK(set.size() == 3);
+        CHECK(set.count(json::parse(R"({"id":2,"tags":["a","b"]})")) == 1);
+        CHECK(set.count(json::parse(R"({"id":2,"tags":["b","a"]})")) == 0);
+    }
+}
@@ -115,3 +115,43 @@ TEMPLATE_TEST_CASE("test_json_encoder_reset", "",
     f.encoder.flush();
     CHECK(f.string2() == R"(["foo",42])");
 }
+
+TEST_CASE("json_encoder escapes characters at any position in a long string")
+{
+    const std::string run(40, 'a');
+
+    SECTION("default options")
+    {
+        const char specials[] = {'\"', '\\', '\n', '\x01', '\x7f', '/'};
+        const std::string escaped[] = {"\\\"", "\\\\", "\\n", "\\u0001", "\\u007F", "/"};
+        for (std::size_t k = 0; k < 6; ++k)
+        {
+            for (std::size_t pos = 0; pos <= run.size(); ++pos)
+            {
+                std::string s = run;
+                s.insert(pos, 1, specials[k]);
+                s += "\xc3\xa9";
+
+                std::string output;
+                json(s).dump(output);
+                CHECK(output == "\"" + run.substr(0, pos) + escaped[k] + run.substr(pos) + "\xc3\xa9\"");
+            }
+        }
+    }
+
+    SECTION("escape_solidus and escape_all_non_ascii")
+    {
+        auto options = json_options{}
+            .escape_solidus(true)
+            .escape_all_non_ascii(true);
+        for (std::size_t pos = 0; pos <= run.size(); ++pos)
+        {
+            std::string s = run;
+            s.insert(pos, "/\xf0\x9f\x98\x80");
+
+            std::string output;
+            json(s).dump(output, options);
+            CHECK(output == "\"" + run.substr(0, pos) + "\\/\\uD83D\\uDE00" + run.substr(pos) + "\"");
+        }
+    }
+}
@@ -1175,3 +1175,57 @@ TEST_CASE("test_json_merge_or_update_move")
     }
 }
 
+
+TEST_CASE("json parse duplicate keys")
+{
+    std::string ascending = R"({"a":1,"b":2,"c":{"x":true,"y":false}})";
+    std::string unsorted = R"({"c":3,"a":1,"b":2})";
+    std::string duplicates = R"({"b":1,"a":2,"b":3,"a":4})";
+
+    SECTION("ascending keys")
+    {
+        json j = json::parse(ascending);
+        REQUIRE(j.size() == 3);
+        CHECK(j["a"].as<int>() == 1);
+        CHECK(j["c"]["y"].as<bool>() == false);
+        CHECK(j.object_range().begin()->key() == "a");
+    }
+
+    SECTION("unsorted keys")
+    {
+        json j = json::parse(unsorted);
+        REQUIRE(j.size() == 3);
+        CHECK(j.object_range().begin()->key() == "a");
+        CHECK(j["c"].as<int>() == 3);
+    }
+
+    SECTION("first wins")
+    {
+        json j = json::parse(duplicates);
+        CHECK(j == json::parse(R"({"a":2,"b":1})"));
+    }
+
+    SECTION("last wins")
+    {
+        auto options = json_options{}
+            .duplicate_keys(duplicate_key_policy::last_wins);
+        json j = json::parse(duplicates, options);
+        CHECK(j == json::parse(R"({"a":4,"b":3})"));
+    }
+
+    SECTION("error")
+    {
+        auto options = json_options{}
+            .duplicate_keys(duplicate_key_policy::error);
+        CHECK(json::parse(unsorted, options).size() == 3);
+        REQUIRE_THROWS_AS(json::parse(duplicates, options), ser_error);
+        REQUIRE_THROWS_AS(json::parse(R"({"a":{"x":1,"x":2}})", options), ser_error);
+
+        std::error_code ec;
+        json_decoder<json> decoder(duplicate_key_policy::error);
+        json_string_reader reader(duplicates, decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::duplicate_key);
+        CHECK_FALSE(decoder.is_valid());
+    }
+}
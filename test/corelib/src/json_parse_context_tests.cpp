@@ -0,0 +1,56 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("json_parse_context tests")
+{
+    json_parse_context<json> context;
+
+    SECTION("parse many documents")
+    {
+        std::vector<std::string> docs = {
+            R"({"a":[1,2,{"b":"c"}],"d":-2.5})",
+            R"([true,false,null])",
+            R"("text")",
+            R"(  42  )",
+            R"({"a":[1,2,{"b":"c"}],"d":-2.5})"
+        };
+        for (const auto& doc : docs)
+        {
+            json j = json::parse(context, doc);
+            CHECK(j == json::parse(doc));
+        }
+        CHECK(json::parse(context, "[1,2]") == json::parse("[1,2]"));
+    }
+
+    SECTION("parse after an error")
+    {
+        REQUIRE_THROWS_AS(json::parse(context, std::string(R"({"a":[1,2)")), ser_error);
+        REQUIRE_THROWS_AS(json::parse(context, std::string(R"({"a" 1})")), ser_error);
+        REQUIRE_THROWS_AS(json::parse(context, std::string(R"([1] 2)")), ser_error);
+
+        json j = json::parse(context, std::string(R"({"a":[1,2]})"));
+        CHECK(j == json::parse(R"({"a":[1,2]})"));
+        CHECK(j["a"].size() == 2);
+    }
+}
+
+TEST_CASE("json_parse_context with options")
+{
+    auto options = json_options{}
+        .duplicate_keys(duplicate_key_policy::last_wins)
+        .lossless_number(true);
+    json_parse_context<ojson> context(options);
+
+    ojson j1 = ojson::parse(context, std::string(R"({"b":1,"a":2,"b":3})"));
+    CHECK(j1.to_string() == R"({"b":3,"a":2})");
+
+    ojson j2 = ojson::parse(context, std::string(R"([1.50,2])"));
+    CHECK(j2[0].as<std::string>() == "1.50");
+}
@@ -11,6 +11,7 @@
 #include <utility>
 #include <ctime>
 #include <fstream>
+#include <memory>
 
 using namespace jsoncons;
 
@@ -338,3 +339,16 @@ TEST_CASE("test_diagnostics_visitor", "")
         CHECK(os.str() == expected.str());
     }
 }
+
+TEST_CASE("json_decoder move")
+{
+    std::string input = R"({"a":1,"b":{"c":[true,null]}})";
+
+    std::unique_ptr<json_decoder<json>> original(new json_decoder<json>());
+    json_decoder<json> decoder(std::move(*original));
+    original.reset();
+
+    json_string_reader reader(input, decoder);
+    reader.read();
+    CHECK(decoder.get_result() == json::parse(input));
+}
@@ -0,0 +1,124 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_push_reader.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("json_push_reader tests")
+{
+    std::vector<json> values;
+    json_push_reader<json> reader([&](json&& j){values.push_back(std::move(j));});
+
+    SECTION("one value in one chunk")
+    {
+        reader.update(R"({"a":[1,2.5,-3e2],"b":"text"})");
+        REQUIRE(values.size() == 1);
+        CHECK(values[0] == json::parse(R"({"a":[1,2.5,-3e2],"b":"text"})"));
+        CHECK_FALSE(reader.in_value());
+        reader.finish();
+        CHECK(values.size() == 1);
+    }
+
+    SECTION("a value split at every position")
+    {
+        std::string input = R"({"name":"Jörg \"quoted\"","n":[12345,-6.75e-3,true,false,null],"empty":{}})";
+        json expected = json::parse(input);
+
+        for (std::size_t i = 0; i < input.size(); ++i)
+        {
+            values.clear();
+            reader.update(input.data(), i);
+            CHECK(values.empty());
+            reader.update(input.data() + i, input.size() - i);
+            REQUIRE(values.size() == 1);
+            CHECK(values[0] == expected);
+        }
+    }
+
+    SECTION("one byte at a time")
+    {
+        std::string input = R"([1, "two", {"three" : 3.0}])";
+        for (char c : input)
+        {
+            reader.update(&c, 1);
+        }
+        REQUIRE(values.size() == 1);
+        CHECK(values[0] == json::parse(input));
+    }
+
+    SECTION("concatenated values")
+    {
+        reader.update(R"({"a":1}[2]"three")");
+        CHECK(values.size() == 3);
+        reader.update(" 4");
+        CHECK(values.size() == 3); // the number may continue
+        CHECK(reader.in_value());
+        reader.update("5 6");
+        CHECK(values.size() == 4);
+        reader.finish();
+        REQUIRE(values.size() == 5);
+        CHECK(values[0] == json::parse(R"({"a":1})"));
+        CHECK(values[1] == json::parse("[2]"));
+        CHECK(values[2].as<std::string>() == "three");
+        CHECK(values[3].as<int>() == 45);
+        CHECK(values[4].as<int>() == 6);
+        CHECK(reader.value_count() == 5);
+    }
+
+    SECTION("whitespace and line breaks between values")
+    {
+        reader.update("\r\n{}\r");
+        reader.update("\n\t[]  \n");
+        reader.finish();
+        CHECK(values.size() == 2);
+    }
+
+    SECTION("incomplete value at end")
+    {
+        reader.update(R"({"a":[1,2)");
+        std::error_code ec;
+        reader.finish(ec);
+        CHECK(ec == json_errc::unexpected_eof);
+        CHECK(values.empty());
+    }
+
+    SECTION("syntax error and reset")
+    {
+        std::error_code ec;
+        reader.update("[1,2]{\"a\" 1}", ec);
+        CHECK(ec == json_errc::expected_colon);
+        CHECK(values.size() == 1);
+
+        reader.update("[3]", ec);
+        CHECK(values.size() == 1); // ignored until reset
+
+        reader.reset();
+        ec = std::error_code();
+        reader.update("[3]", ec);
+        CHECK_FALSE(ec);
+        REQUIRE(values.size() == 2);
+        CHECK(values[1] == json::parse("[3]"));
+    }
+
+    SECTION("throws ser_error")
+    {
+        REQUIRE_THROWS_AS(reader.update("[1,]"), ser_error);
+    }
+}
+
+TEST_CASE("json_push_reader with options")
+{
+    std::vector<ojson> values;
+    auto options = json_options{}
+        .duplicate_keys(duplicate_key_policy::last_wins);
+    json_push_reader<ojson> reader([&](ojson&& j){values.push_back(std::move(j));}, options);
+
+    reader.update(R"({"b":1,"a":2,"b":3})");
+    REQUIRE(values.size() == 1);
+    CHECK(values[0].to_string() == R"({"b":3,"a":2})");
+}
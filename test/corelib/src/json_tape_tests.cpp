@@ -0,0 +1,139 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_tape.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("json_tape navigation")
+{
+    std::string input = R"(
+{
+    "id": 17,
+    "name": "Smith, John",
+    "scores": [1.5, -2, 18446744073709551615],
+    "address": {"city": "Toronto", "zip": null},
+    "active": true,
+    "empty_array": [],
+    "empty_object": {},
+    "records": [{"a":1},{"a":2},[3,[4]]]
+}
+    )";
+
+    json_tape tape = json_tape::parse(input);
+    json_tape::const_reference root = tape.root();
+
+    SECTION("types and sizes")
+    {
+        CHECK(root.is_object());
+        CHECK(root.size() == 8);
+        CHECK(root["scores"].is_array());
+        CHECK(root["scores"].size() == 3);
+        CHECK(root["address"]["zip"].is_null());
+        CHECK(root["empty_array"].empty());
+        CHECK(root["empty_object"].empty());
+        CHECK(root["scores"][0].type() == json_type::double_value);
+        CHECK(root["scores"][1].type() == json_type::int64_value);
+        CHECK(root["scores"][2].type() == json_type::uint64_value);
+    }
+
+    SECTION("as")
+    {
+        CHECK(root.at("id").as<int>() == 17);
+        CHECK(root.at("id").as<double>() == 17.0);
+        CHECK(root.at("name").as<std::string>() == "Smith, John");
+        CHECK(root.at("name").as<string_view>() == "Smith, John");
+        CHECK(root.at("active").as<bool>());
+        CHECK(root["scores"][2].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        CHECK(root["id"].as<std::string>() == "17");
+        std::vector<double> scores = root["scores"].as<std::vector<double>>();
+        CHECK(scores.size() == 3);
+        CHECK(root.get_value_or<int>("missing", 5) == 5);
+    }
+
+    SECTION("find and contains")
+    {
+        CHECK(root.contains("address"));
+        CHECK_FALSE(root.contains("city"));
+        auto it = root["address"].find("city");
+        REQUIRE(it != root["address"].object_range().end());
+        CHECK(it->value().as<std::string>() == "Toronto");
+        CHECK(root["address"].find("country") == root["address"].object_range().end());
+    }
+
+    SECTION("nested arrays are indexed past their descendants")
+    {
+        const auto& records = root["records"];
+        CHECK(records[0]["a"].as<int>() == 1);
+        CHECK(records[1]["a"].as<int>() == 2);
+        CHECK(records[2][1][0].as<int>() == 4);
+    }
+
+    SECTION("ranges")
+    {
+        std::vector<std::string> keys;
+        for (const auto& member : root.object_range())
+        {
+            keys.push_back(std::string(member.key()));
+        }
+        CHECK(keys.size() == 8);
+        CHECK(keys[0] == "id");
+        CHECK(keys[7] == "records");
+
+        double sum = 0;
+        for (auto item : root["scores"].array_range())
+        {
+            if (item.is_double() || item.is_int64())
+            {
+                sum += item.as<double>();
+            }
+        }
+        CHECK(sum == -0.5);
+    }
+
+    SECTION("errors")
+    {
+        REQUIRE_THROWS_AS(root.at("missing"), key_not_found);
+        REQUIRE_THROWS_AS(root["scores"].at(3), std::out_of_range);
+        REQUIRE_THROWS_AS(root["id"].at("x"), not_an_object);
+        REQUIRE_THROWS(json_tape::parse("[1,2"));
+    }
+
+    SECTION("round trip")
+    {
+        json expected = json::parse(input);
+        CHECK(root.to_json<ojson>() == ojson::parse(input));
+        CHECK(json::parse(root.to_string()) == expected);
+
+        std::ostringstream os;
+        os << root;
+        CHECK(json::parse(os.str()) == expected);
+    }
+}
+
+TEST_CASE("json_tape scalars and reuse")
+{
+    json_tape empty;
+    CHECK(empty.empty());
+    CHECK(empty.root().is_null());
+
+    json_tape_decoder decoder;
+
+    json_string_reader reader1("\"text\"", decoder);
+    reader1.read();
+    json_tape t1 = decoder.get_result();
+    CHECK(t1.root().as<std::string>() == "text");
+
+    json_string_reader reader2("[true,false]", decoder);
+    reader2.read();
+    json_tape t2 = decoder.get_result();
+    CHECK(t2.entry_count() == 3);
+    CHECK_FALSE(t2.root()[1].as<bool>());
+
+    CHECK(t1.root().as<std::string>() == "text");
+}
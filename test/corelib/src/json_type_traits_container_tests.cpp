@@ -828,3 +828,138 @@ TEST_CASE("encode/decode std::vector traits")
         CHECK(project2 == project);
     }
 }
+
+TEST_CASE("json_type_traits rvalue container tests")
+{
+    SECTION("std::vector<json> to json")
+    {
+        std::vector<json> v = {json::parse(R"({"a":[1,2]})"), json::parse(R"([3,4])"), json("a string that does not fit inline")};
+        const std::vector<json> expected = v;
+
+        json j(std::move(v));
+        REQUIRE(j.size() == 3);
+        CHECK(j[0] == expected[0]);
+        CHECK(j[1] == expected[1]);
+        CHECK(j[2] == expected[2]);
+        CHECK(v[0].is_null()); // moved from
+        CHECK(v[1].is_null());
+    }
+
+    SECTION("std::vector<std::vector<json>> assigned to json")
+    {
+        std::vector<std::vector<json>> v = {{json::parse(R"({"a":1})")}, {json::parse(R"([2,3])"), json(4)}};
+
+        json j;
+        j = std::move(v);
+        CHECK(j == json::parse(R"([[{"a":1}],[[2,3],4]])"));
+        CHECK(v[0][0].is_null()); // moved from
+    }
+
+    SECTION("std::array<json,2> to json")
+    {
+        std::array<json,2> a = {{json::parse(R"({"a":1})"), json::parse(R"([2,3])")}};
+
+        json j(std::move(a));
+        CHECK(j == json::parse(R"([{"a":1},[2,3]])"));
+        CHECK(a[0].is_null()); // moved from
+    }
+
+    SECTION("std::map<std::string,json> to json")
+    {
+        std::map<std::string,json> m = {{"a", json::parse(R"([1,2])")}, {"b", json::parse(R"({"c":3})")}};
+
+        json j(std::move(m));
+        CHECK(j == json::parse(R"({"a":[1,2],"b":{"c":3}})"));
+        CHECK(m["a"].is_null()); // moved from
+    }
+
+    SECTION("std::map<int,json> to json")
+    {
+        std::map<int,json> m = {{1, json::parse(R"([1,2])")}, {2, json::parse(R"({"c":3})")}};
+
+        json j(std::move(m));
+        CHECK(j == json::parse(R"({"1":[1,2],"2":{"c":3}})"));
+        CHECK(m[1].is_null()); // moved from
+    }
+
+    SECTION("rvalue json as std::vector<json>")
+    {
+        json j = json::parse(R"([{"a":1},[2,3],"a string that does not fit inline"])");
+        const json expected = j;
+
+        auto v = std::move(j).as<std::vector<json>>();
+        REQUIRE(v.size() == 3);
+        CHECK(v[0] == expected[0]);
+        CHECK(v[1] == expected[1]);
+        CHECK(v[2] == expected[2]);
+        CHECK(j[0].is_null()); // moved from
+        CHECK(j[1].is_null());
+    }
+
+    SECTION("rvalue json as std::map<std::string,std::vector<json>>")
+    {
+        json j = json::parse(R"({"a":[{"b":1}],"c":[[2,3]]})");
+
+        auto m = std::move(j).as<std::map<std::string,std::vector<json>>>();
+        REQUIRE(m.size() == 2);
+        CHECK(m["a"][0] == json::parse(R"({"b":1})"));
+        CHECK(m["c"][0] == json::parse(R"([2,3])"));
+        CHECK(j["a"][0].is_null()); // moved from
+    }
+
+    SECTION("rvalue json as std::vector<std::string>")
+    {
+        auto v = json::parse(R"(["a","b","a string that does not fit inline"])").as<std::vector<std::string>>();
+        REQUIRE(v.size() == 3);
+        CHECK(v[2] == "a string that does not fit inline");
+    }
+
+    SECTION("rvalue json as std::array<json,2> and std::deque<json>")
+    {
+        json j = json::parse(R"([{"a":1},[2,3]])");
+        auto a = json(j).as<std::array<json,2>>();
+        CHECK(a[0] == j[0]);
+        CHECK(a[1] == j[1]);
+
+        auto d = json(j).as<std::deque<json>>();
+        CHECK(d[0] == j[0]);
+        CHECK(d[1] == j[1]);
+    }
+
+    SECTION("rvalue json_const_pointer as containers")
+    {
+        json arr = json::parse("[1,2,3]");
+        json obj = json::parse(R"({"a":1,"b":2})");
+        json nested(json_array_arg);
+        nested.emplace_back(json_const_pointer_arg, &arr);
+
+        auto v = json(json_const_pointer_arg, &arr).as<std::vector<int>>();
+        CHECK(v == std::vector<int>{1,2,3});
+        auto d = json(json_const_pointer_arg, &arr).as<std::deque<int>>();
+        CHECK(d.size() == 3);
+        auto a = json(json_const_pointer_arg, &arr).as<std::array<int,3>>();
+        CHECK(a[2] == 3);
+        auto m = json(json_const_pointer_arg, &obj).as<std::map<std::string,int>>();
+        CHECK(m["b"] == 2);
+        json numbered = json::parse(R"({"1":10,"2":20})");
+        auto n = json(json_const_pointer_arg, &numbered).as<std::map<int,int>>();
+        CHECK(n[2] == 20);
+        auto vv = std::move(nested).as<std::vector<std::vector<int>>>();
+        REQUIRE(vv.size() == 1);
+        CHECK(vv[0] == std::vector<int>{1,2,3});
+
+        CHECK(arr == json::parse("[1,2,3]"));
+        CHECK(obj == json::parse(R"({"a":1,"b":2})"));
+    }
+
+    SECTION("lvalue conversions copy")
+    {
+        std::vector<json> v = {json::parse(R"({"a":1})")};
+        json j(v);
+        CHECK(v[0] == json::parse(R"({"a":1})"));
+
+        auto w = j.as<std::vector<json>>();
+        CHECK(j[0] == json::parse(R"({"a":1})"));
+        CHECK(w[0] == j[0]);
+    }
+}
@@ -518,3 +518,66 @@ TEST_CASE("custom_json merge_or_update test")
 }
 
 #endif
+
+TEST_CASE("ojson parse duplicate keys")
+{
+    std::string small = R"({"b":1,"a":2,"b":3,"c":4,"a":5})";
+
+    // More members than are checked by linear search
+    std::string large = "{";
+    for (int i = 40; i > 0; --i)
+    {
+        large += "\"k" + std::to_string(i) + "\":" + std::to_string(i) + ",";
+    }
+    large += R"("k7":-7,"k40":-40})";
+
+    auto keys = [](const ojson& j)
+    {
+        std::string s;
+        for (const auto& member : j.object_range())
+        {
+            s += member.key();
+        }
+        return s;
+    };
+
+    SECTION("first wins")
+    {
+        ojson j = ojson::parse(small);
+        CHECK(keys(j) == "bac");
+        CHECK(j["a"].as<int>() == 2);
+        CHECK(j["b"].as<int>() == 1);
+
+        ojson k = ojson::parse(large);
+        REQUIRE(k.size() == 40);
+        CHECK(k.object_range().begin()->key() == "k40");
+        CHECK(k["k40"].as<int>() == 40);
+        CHECK(k["k7"].as<int>() == 7);
+    }
+
+    SECTION("last wins")
+    {
+        auto options = json_options{}
+            .duplicate_keys(duplicate_key_policy::last_wins);
+
+        ojson j = ojson::parse(small, options);
+        CHECK(keys(j) == "bac");
+        CHECK(j["a"].as<int>() == 5);
+        CHECK(j["b"].as<int>() == 3);
+
+        ojson k = ojson::parse(large, options);
+        REQUIRE(k.size() == 40);
+        CHECK(k.object_range().begin()->key() == "k40");
+        CHECK(k["k40"].as<int>() == -40);
+        CHECK(k["k7"].as<int>() == -7);
+    }
+
+    SECTION("error")
+    {
+        auto options = json_options{}
+            .duplicate_keys(duplicate_key_policy::error);
+        REQUIRE_THROWS_AS(ojson::parse(small, options), ser_error);
+        REQUIRE_THROWS_AS(ojson::parse(large, options), ser_error);
+        CHECK(ojson::parse(R"({"b":1,"a":2})", options).size() == 2);
+    }
+}
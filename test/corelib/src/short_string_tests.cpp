@@ -30,3 +30,51 @@ TEST_CASE("test_small_string")
 }
 
 
+
+TEMPLATE_TEST_CASE("test short string node sizes", "",
+    (basic_json<char,node_size_policy<sorted_policy,24>>),
+    (basic_json<char,node_size_policy<order_preserving_policy,32>>),
+    (basic_json<wchar_t,node_size_policy<sorted_policy,32>>))
+{
+    using json_type = TestType;
+    using char_type = typename json_type::char_type;
+    using string_type = std::basic_string<char_type>;
+
+    const std::size_t max_length = (sizeof(json_type) - 2)/sizeof(char_type) - 1;
+
+    SECTION("lengths up to and past max_length")
+    {
+        for (std::size_t length = 0; length <= max_length + 1; ++length)
+        {
+            string_type s(length, 'a');
+            json_type j(s);
+            CHECK(j.storage_kind() == (length <= max_length ? json_storage_kind::short_string_value : json_storage_kind::long_string_value));
+            CHECK(j.as_string_view().size() == length);
+            CHECK(j.template as<string_type>() == s);
+
+            json_type k(j);
+            CHECK(k.template as<string_type>() == s);
+            json_type m;
+            m = std::move(k);
+            CHECK(m == j);
+        }
+    }
+
+    SECTION("parse")
+    {
+        std::string input = R"({"date":"2023-10-01T12:00:00Z","tags":["enumeration_value"]})";
+        auto j = json_type::parse(string_type(input.begin(), input.end()));
+        CHECK(j.at(string_type{'d','a','t','e'}).as_string_view().size() == 20);
+    }
+}
+
+TEST_CASE("test node_size_policy with interned keys")
+{
+    using json_type = basic_json<char,node_size_policy<interned_key_policy<sorted_policy>,24>>;
+
+    CHECK(sizeof(json_type) == 24);
+    json_type j = json_type::parse(R"([{"name":"a twenty char string"},{"name":"b"}])");
+    CHECK(j[0]["name"].storage_kind() == json_storage_kind::short_string_value);
+    CHECK(j[0]["name"].as<std::string>() == "a twenty char string");
+    CHECK(j[0].object_range().begin()->key().is_same_entry(j[1].object_range().begin()->key()));
+}
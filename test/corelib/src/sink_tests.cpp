@@ -0,0 +1,144 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/sink.hpp>
+#include <catch/catch.hpp>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+    template <class T>
+    std::basic_string<T> to_string(const jsoncons::chunked_buffer<T>& buf)
+    {
+        std::basic_string<T> s;
+        for (std::size_t i = 0; i < buf.segment_count(); ++i)
+        {
+            auto seg = buf.segment(i);
+            s.append(seg.data(), seg.size());
+        }
+        return s;
+    }
+
+} // namespace
+
+TEST_CASE("chunked_buffer tests")
+{
+    jsoncons::chunked_buffer<char> buf(4);
+
+    SECTION("append across blocks")
+    {
+        std::string expected = "0123456789";
+        buf.append(expected.data(), 3);
+        buf.append(expected.data() + 3, 7);
+        buf.push_back('a');
+        expected.push_back('a');
+
+        CHECK(buf.size() == expected.size());
+        CHECK(buf.segment_count() == 3);
+        CHECK(buf.segment(0).size() == 4);
+        CHECK(to_string(buf) == expected);
+    }
+
+    SECTION("segments are not moved by appending")
+    {
+        buf.append("abcd", 4);
+        const char* first = buf.segment(0).data();
+        for (int i = 0; i < 100; ++i)
+        {
+            buf.push_back('x');
+        }
+        CHECK(buf.segment(0).data() == first);
+        CHECK(buf.size() == 104);
+    }
+
+    SECTION("clear")
+    {
+        buf.append("abcdef", 6);
+        buf.clear();
+        CHECK(buf.empty());
+        CHECK(buf.segment_count() == 0);
+    }
+}
+
+TEST_CASE("chunked_sink with json encoder")
+{
+    jsoncons::json j = jsoncons::json::parse(R"({"name":"Smith, John","values":[1,2.5,"a long string value"],"ok":true})");
+
+    std::string expected;
+    j.dump(expected);
+
+    jsoncons::chunked_buffer<char> buf(8);
+    {
+        jsoncons::basic_compact_json_encoder<char,jsoncons::chunked_sink<char>> encoder(buf);
+        j.dump(encoder);
+    }
+    CHECK(buf.segment_count() > 1);
+    CHECK(to_string(buf) == expected);
+}
+
+#if defined(JSONCONS_HAS_POSIX_IO)
+
+TEST_CASE("fd_sink tests")
+{
+    std::FILE* f = std::tmpfile();
+    REQUIRE(f != nullptr);
+
+    auto read_back = [f]() -> std::string
+    {
+        std::rewind(f);
+        std::string s;
+        int c;
+        while ((c = std::fgetc(f)) != EOF)
+        {
+            s.push_back(static_cast<char>(c));
+        }
+        return s;
+    };
+
+    SECTION("small buffer")
+    {
+        std::string expected;
+        {
+            jsoncons::fd_sink<char> sink(fileno(f), 8);
+            for (int i = 0; i < 10; ++i)
+            {
+                std::string s = std::to_string(i) + "abc";
+                sink.append(s.data(), s.size());
+                sink.push_back(',');
+                expected += s;
+                expected.push_back(',');
+            }
+            std::string large(100, 'z');
+            sink.append(large.data(), large.size());
+            expected += large;
+        }
+        CHECK(read_back() == expected);
+    }
+
+    SECTION("json encoder")
+    {
+        jsoncons::json j = jsoncons::json::parse(R"({"a":[1,2,3],"b":"some text"})");
+        std::string expected;
+        j.dump(expected);
+        {
+            jsoncons::basic_compact_json_encoder<char,jsoncons::fd_sink<char>> encoder(fileno(f));
+            j.dump(encoder);
+        }
+        CHECK(read_back() == expected);
+    }
+
+    SECTION("bad file descriptor")
+    {
+        jsoncons::fd_sink<char> sink(-1);
+        sink.push_back('a');
+        REQUIRE_THROWS_AS(sink.flush(), std::system_error);
+    }
+
+    std::fclose(f);
+}
+
+#endif
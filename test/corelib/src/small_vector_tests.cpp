@@ -0,0 +1,142 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/small_vector.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace jsoncons;
+
+TEST_CASE("small_vector tests")
+{
+    using vector_type = small_vector<std::string,std::allocator<std::string>,2*sizeof(std::string)>;
+
+    SECTION("inline then heap")
+    {
+        vector_type v;
+        CHECK(v.is_inline());
+        CHECK(v.capacity() == 2);
+        v.push_back("a");
+        v.emplace_back("b");
+        CHECK(v.is_inline());
+        v.emplace_back(v[0]); // argument refers to an element
+        CHECK_FALSE(v.is_inline());
+        REQUIRE(v.size() == 3);
+        CHECK(v[2] == "a");
+
+        v.erase(v.begin(), v.begin() + 2);
+        v.shrink_to_fit();
+        CHECK(v.is_inline());
+        REQUIRE(v.size() == 1);
+        CHECK(v[0] == "a");
+    }
+
+    SECTION("reserve")
+    {
+        vector_type v;
+        v.reserve(2);
+        CHECK(v.is_inline());
+        v.reserve(10);
+        CHECK(v.capacity() == 10);
+        CHECK(v.empty());
+    }
+
+    SECTION("insert and erase")
+    {
+        vector_type v = {"b", "d"};
+        auto it = v.insert(v.begin(), "a");
+        CHECK(*it == "a");
+        std::vector<std::string> more = {"c"};
+        it = v.insert(v.begin() + 2, more.begin(), more.end());
+        CHECK(*it == "c");
+        v.emplace(v.end(), "e");
+        CHECK(v == vector_type({"a", "b", "c", "d", "e"}));
+        it = v.erase(v.begin() + 1);
+        CHECK(*it == "c");
+        CHECK(v == vector_type({"a", "c", "d", "e"}));
+    }
+
+    SECTION("copy, move and swap")
+    {
+        vector_type small = {"a"};
+        vector_type large = {"x", "y", "z"};
+
+        vector_type copy(small);
+        CHECK(copy == small);
+
+        vector_type moved(std::move(large));
+        CHECK(moved.size() == 3);
+        CHECK(large.empty());
+        CHECK(large.is_inline());
+
+        small.swap(moved);
+        CHECK(small == vector_type({"x", "y", "z"}));
+        CHECK(moved == vector_type({"a"}));
+        CHECK(moved.is_inline());
+
+        vector_type assigned;
+        assigned = small;
+        CHECK(assigned == small);
+        assigned = std::move(moved);
+        CHECK(assigned == vector_type({"a"}));
+        CHECK(vector_type({"a"}) < vector_type({"a", "b"}));
+    }
+
+    SECTION("resize")
+    {
+        vector_type v;
+        v.resize(3, "a");
+        CHECK(v == vector_type({"a", "a", "a"}));
+        v.resize(1);
+        CHECK(v.size() == 1);
+        v.clear();
+        CHECK(v.empty());
+    }
+}
+
+TEST_CASE("json small arrays and objects")
+{
+    json j = json::parse(R"({"point":[1,2],"wrapper":{"id":3},"long":[1,2,3,4]})");
+
+    SECTION("grow past inline storage")
+    {
+        json& point = j["point"];
+        point.push_back(3);
+        point.insert(point.array_range().begin(), 0);
+        CHECK(point == json::parse("[0,1,2,3]"));
+
+        json& wrapper = j["wrapper"];
+        wrapper.insert_or_assign("name", "n");
+        wrapper.insert_or_assign("a", true);
+        CHECK(wrapper == json::parse(R"({"a":true,"id":3,"name":"n"})"));
+    }
+
+    SECTION("shrink back to inline storage")
+    {
+        json& a = j["long"];
+        a.erase(a.array_range().begin() + 1, a.array_range().end());
+        a.shrink_to_fit();
+        CHECK(a == json::parse("[1]"));
+        CHECK(a.capacity() == 2);
+    }
+
+    SECTION("copy and swap")
+    {
+        json k = j;
+        CHECK(k == j);
+        k["point"].swap(k["long"]);
+        CHECK(k["point"] == json::parse("[1,2,3,4]"));
+        CHECK(k["long"] == json::parse("[1,2]"));
+    }
+
+    SECTION("ojson")
+    {
+        ojson o = ojson::parse(R"({"z":{"id":1},"a":[true,false]})");
+        o["z"].insert_or_assign("b", 2);
+        o["a"].push_back(null_type());
+        CHECK(o.to_string() == R"({"z":{"id":1,"b":2},"a":[true,false,null]})");
+    }
+}
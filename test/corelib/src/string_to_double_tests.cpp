@@ -9,6 +9,9 @@
 #include <utility>
 #include <ctime>
 #include <cwchar>
+#include <cmath>
+#include <limits>
+#include <string>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -53,3 +56,72 @@ TEST_CASE("test_exponent")
 
 }
 
+
+TEST_CASE("test decimal_to_double")
+{
+    SECTION("agrees with the nearest double")
+    {
+        std::vector<std::pair<std::string,double>> cases = {
+            {"0", 0.0},
+            {"-0.0", -0.0},
+            {"1", 1.0},
+            {"0.1", 0.1},
+            {"-12.25e2", -1225.0},
+            {"1E+2", 100.0},
+            {"9007199254740993", 9007199254740992.0},
+            {"2.2250738585072011e-308", 2.2250738585072011e-308},
+            {"4.9406564584124654e-324", 4.9406564584124654e-324},
+            {"1.7976931348623157e308", 1.7976931348623157e308},
+            {"1e-400", 0.0},
+            {"123456789012345678901234567890", 123456789012345678901234567890.0},
+            {"0.000000000000000000000000000001", 1e-30}
+        };
+        for (const auto& item : cases)
+        {
+            double val = -1;
+            REQUIRE(jsoncons::detail::decimal_to_double(item.first.data(), item.first.data() + item.first.size(), val));
+            CHECK(val == item.second);
+            CHECK(std::signbit(val) == std::signbit(item.second));
+        }
+        double val = 0;
+        std::string s = "1e400";
+        REQUIRE(jsoncons::detail::decimal_to_double(s.data(), s.data() + s.size(), val));
+        CHECK(val == std::numeric_limits<double>::infinity());
+    }
+
+    SECTION("rejects other syntax")
+    {
+        std::vector<std::string> cases = {"", "-", "+1", " 1", "1.", ".5", "1e", "1e+", "0x10", "1.5x", "nan", "inf"};
+        for (const auto& s : cases)
+        {
+            double val = 0;
+            CHECK_FALSE(jsoncons::detail::decimal_to_double(s.data(), s.data() + s.size(), val));
+        }
+    }
+
+    SECTION("falls back when the first 19 digits don't decide")
+    {
+        // Halfway between 1 and the next double, plus a little in the 40th digit
+        std::string s = "1.000000000000000111022302462515654042364";
+        double val = 0;
+        CHECK_FALSE(jsoncons::detail::decimal_to_double(s.data(), s.data() + s.size(), val));
+
+        jsoncons::detail::chars_to to_double;
+        CHECK(to_double(s.data(), s.size()) == std::nextafter(1.0, 2.0));
+        CHECK(json::parse(s).as<double>() == std::nextafter(1.0, 2.0));
+    }
+}
+
+TEST_CASE("test json parser numbers")
+{
+    json j = json::parse(R"([0, -0, 18446744073709551615, 18446744073709551616, -9223372036854775808, -9223372036854775809, 1.5e3, -0.25, 12345678901234567890123e-3])");
+    CHECK(j[0].as<uint64_t>() == 0);
+    CHECK(j[1].as<int64_t>() == 0);
+    CHECK(j[2].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+    CHECK(j[3].tag() == semantic_tag::bigint);
+    CHECK(j[4].as<int64_t>() == (std::numeric_limits<int64_t>::lowest)());
+    CHECK(j[5].tag() == semantic_tag::bigint);
+    CHECK(j[6].as<double>() == 1500.0);
+    CHECK(j[7].as<double>() == -0.25);
+    CHECK(j[8].as<double>() == 12345678901234567890.123);
+}
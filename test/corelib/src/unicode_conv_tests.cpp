@@ -57,3 +57,93 @@ BOOST_AUTO_TEST_CASE( test1 )
 }
 #endif
 
+
+namespace {
+
+    // The byte by byte validation that unicode_traits::validate must agree with
+    unicode_traits::convert_result<char> validate_bytewise(const char* data, std::size_t length)
+    {
+        const char* last = data + length;
+        while (data != last) 
+        {
+            std::size_t len = static_cast<std::size_t>(unicode_traits::trailing_bytes_for_utf8[static_cast<uint8_t>(*data)]) + 1;
+            if (len > (std::size_t)(last - data))
+            {
+                return unicode_traits::convert_result<char>{data, unicode_traits::conv_errc::source_exhausted};
+            }
+            auto result = unicode_traits::is_legal_utf8(data, len);
+            if (result != unicode_traits::conv_errc())
+            {
+                return unicode_traits::convert_result<char>{data, result};
+            }
+            data += len;
+        }
+        return unicode_traits::convert_result<char>{data, unicode_traits::conv_errc()};
+    }
+
+} // namespace
+
+TEST_CASE("unicode_traits::validate utf8")
+{
+    SECTION("ascii, latin and cjk text")
+    {
+        std::string ascii(100, 'a');
+        CHECK(unicode_traits::validate(ascii.data(), ascii.size()).ec == unicode_traits::conv_errc());
+
+        std::string text = ascii + "caf\xc3\xa9 \xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e \xf0\x9f\x98\x80" + ascii;
+        auto result = unicode_traits::validate(text.data(), text.size());
+        CHECK(result.ec == unicode_traits::conv_errc());
+        CHECK(result.ptr == text.data() + text.size());
+
+        std::string truncated = ascii + "\xe6\x97";
+        result = unicode_traits::validate(truncated.data(), truncated.size());
+        CHECK(result.ec == unicode_traits::conv_errc::source_exhausted);
+        CHECK(result.ptr == truncated.data() + ascii.size());
+
+        std::string surrogate = ascii + "\xed\xa0\x80" + ascii;
+        result = unicode_traits::validate(surrogate.data(), surrogate.size());
+        CHECK(result.ec == unicode_traits::conv_errc::source_illegal);
+        CHECK(result.ptr == surrogate.data() + ascii.size());
+    }
+
+    SECTION("agrees with byte by byte validation")
+    {
+        const uint8_t values[] = {0x00,0x41,0x7f,0x80,0x8f,0x90,0x9f,0xa0,0xbf,0xc0,0xc2,0xf4,0xff};
+        const std::string prefix = "0123456789abcdefXYZ";
+        std::string s;
+        std::size_t mismatches = 0;
+        for (int b0 = 0; b0 < 256; ++b0)
+        {
+            for (auto b1 : values)
+            {
+                for (auto b2 : values)
+                {
+                    for (auto b3 : values)
+                    {
+                        s = prefix;
+                        s.push_back(static_cast<char>(b0));
+                        s.push_back(static_cast<char>(b1));
+                        s.push_back(static_cast<char>(b2));
+                        s.push_back(static_cast<char>(b3));
+                        auto expected = validate_bytewise(s.data(), s.size());
+                        auto actual = unicode_traits::validate(s.data(), s.size());
+                        if (expected.ec != actual.ec || expected.ptr != actual.ptr)
+                        {
+                            ++mismatches;
+                        }
+                    }
+                }
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+
+    SECTION("convert copies the valid prefix")
+    {
+        std::string input = "abc\xc3\xa9\x80" "def";
+        std::string output;
+        auto result = unicode_traits::convert(input.data(), input.size(), output);
+        CHECK(result.ec == unicode_traits::conv_errc::source_illegal);
+        CHECK(output == std::string("abc\xc3\xa9"));
+    }
+}
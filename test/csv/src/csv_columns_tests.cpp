@@ -0,0 +1,172 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <catch/catch.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+#include <cmath>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("decode_csv_columns with header")
+{
+    std::string input = R"(id,price,ok,name
+1,1.5,true,"a, b"
+2,,false,c
+3,2.25,true,
+)";
+
+    auto options = csv::csv_options{}
+        .assume_header(true);
+    csv::csv_columns columns = csv::decode_csv_columns(input, options);
+
+    REQUIRE(columns.size() == 4);
+    CHECK(columns.row_count() == 3);
+
+    const csv::csv_column& id = columns.at("id");
+    CHECK(id.type() == csv::csv_column_type::integer_t);
+    CHECK(id.integer_values() == std::vector<int64_t>{1, 2, 3});
+
+    const csv::csv_column& price = columns.at("price");
+    CHECK(price.type() == csv::csv_column_type::float_t);
+    REQUIRE(price.float_values().size() == 3);
+    CHECK(price.float_values()[0] == 1.5);
+    CHECK(std::isnan(price.float_values()[1]));
+    CHECK(price.is_null(1));
+    CHECK_FALSE(price.is_null(2));
+    CHECK(price.float_values()[2] == 2.25);
+
+    const csv::csv_column& ok = columns.at("ok");
+    CHECK(ok.type() == csv::csv_column_type::boolean_t);
+    CHECK(ok.boolean_values() == std::vector<bool>{true, false, true});
+
+    const csv::csv_column& name = columns.at("name");
+    CHECK(name.type() == csv::csv_column_type::string_t);
+    CHECK(name.string_value(0) == "a, b");
+    CHECK(name.string_value(1) == "c");
+    CHECK(name.is_null(2));
+    CHECK(name.string_data() == "a, bc");
+    CHECK(name.string_offsets() == std::vector<std::size_t>{0, 4, 5, 5});
+
+    CHECK(columns.find("missing") == columns.end());
+    CHECK_THROWS_AS(columns.at("missing"), key_not_found);
+}
+
+TEST_CASE("decode_csv_columns widening")
+{
+    std::string input = "a,b,c\n1,true,1\n2.5,x,\n3,false,y\n4,,\n";
+
+    std::istringstream is(input);
+    auto options = csv::csv_options{}
+        .assume_header(true);
+    csv::csv_columns columns = csv::decode_csv_columns(is, options);
+    REQUIRE(columns.size() == 3);
+
+    CHECK(columns[0].type() == csv::csv_column_type::float_t);
+    CHECK(columns[0].float_values() == std::vector<double>{1.0, 2.5, 3.0, 4.0});
+
+    CHECK(columns[1].type() == csv::csv_column_type::string_t);
+    CHECK(columns[1].string_value(0) == "true");
+    CHECK(columns[1].string_value(1) == "x");
+    CHECK(columns[1].string_value(2) == "false");
+
+    CHECK(columns[2].type() == csv::csv_column_type::string_t);
+    CHECK(columns[2].string_value(0) == "1");
+    CHECK(columns[2].is_null(1));
+    CHECK(columns[2].string_value(2) == "y");
+
+    std::string input2 = "a,b\n1,x\n,y\n2.5,z\n";
+    csv::csv_columns columns2 = csv::decode_csv_columns(input2, options);
+    REQUIRE(columns2.size() == 2);
+    CHECK(columns2[0].type() == csv::csv_column_type::float_t);
+    REQUIRE(columns2[0].float_values().size() == 3);
+    CHECK(columns2[0].float_values()[0] == 1.0);
+    CHECK(std::isnan(columns2[0].float_values()[1]));
+    CHECK(columns2[0].float_values()[2] == 2.5);
+}
+
+TEST_CASE("decode_csv_columns with null values")
+{
+    auto options = csv::csv_options{}
+        .assume_header(true);
+
+    SECTION("only nulls")
+    {
+        csv::csv_columns columns = csv::decode_csv_columns(std::string("a,b\n1,\n2,\n"), options);
+        const csv::csv_column& b = columns.at("b");
+        CHECK(b.type() == csv::csv_column_type::string_t);
+        REQUIRE(b.size() == 2);
+        CHECK(b.is_null(0));
+        CHECK(b.is_null(1));
+        CHECK(b.string_value(0).empty());
+        CHECK(b.string_value(1).empty());
+        CHECK(b.string_offsets() == std::vector<std::size_t>{0, 0, 0});
+    }
+
+    SECTION("nulls before the first value")
+    {
+        csv::csv_columns columns = csv::decode_csv_columns(std::string("a,b,c\n1,,\n2,,\n3,4,x\n"), options);
+
+        const csv::csv_column& b = columns.at("b");
+        CHECK(b.type() == csv::csv_column_type::integer_t);
+        CHECK(b.integer_values() == std::vector<int64_t>{0, 0, 4});
+        CHECK(b.string_offsets().empty());
+
+        const csv::csv_column& c = columns.at("c");
+        CHECK(c.type() == csv::csv_column_type::string_t);
+        CHECK(c.string_value(2) == "x");
+        CHECK(c.string_offsets() == std::vector<std::size_t>{0, 0, 0, 1});
+    }
+}
+
+TEST_CASE("decode_csv_columns with column_types")
+{
+    std::string input = "1,2,3\n4,,6\n7,8\n";
+
+    auto options = csv::csv_options{}
+        .column_names("x,y,z")
+        .column_types("integer,float,string");
+    csv::csv_columns columns = csv::decode_csv_columns(input, options);
+    REQUIRE(columns.size() == 3);
+    CHECK(columns.row_count() == 3);
+
+    CHECK(columns.at("x").integer_values() == std::vector<int64_t>{1, 4, 7});
+    CHECK(columns.at("y").type() == csv::csv_column_type::float_t);
+    CHECK(columns.at("y").is_null(1));
+    CHECK(columns.at("y").float_values()[2] == 8.0);
+    CHECK(columns.at("z").string_value(0) == "3");
+    CHECK(columns.at("z").is_null(2));
+}
+
+TEST_CASE("decode_csv_columns without header")
+{
+    std::string input = "1,a\n2,b\n";
+
+    csv::csv_columns columns = csv::decode_csv_columns(input);
+    REQUIRE(columns.size() == 2);
+    CHECK(columns.row_count() == 2);
+    CHECK(columns[0].name().empty());
+    CHECK(columns[0].integer_values() == std::vector<int64_t>{1, 2});
+    CHECK(columns[1].string_value(1) == "b");
+}
+
+TEST_CASE("decode_csv_columns with m_columns mapping")
+{
+    std::string input = "a,b\n1,x\n2,y\n";
+
+    auto options = csv::csv_options{}
+        .assume_header(true)
+        .mapping_kind(csv::csv_mapping_kind::m_columns);
+    csv::csv_columns columns = csv::decode_csv_columns(input, options);
+
+    ojson expected = csv::decode_csv<ojson>(input, options);
+    REQUIRE(columns.size() == expected.size());
+    CHECK(columns.at("a").integer_values() == std::vector<int64_t>{1, 2});
+    CHECK(columns.at("b").string_value(0) == "x");
+    CHECK(columns.at("b").string_value(1) == "y");
+}
@@ -1616,3 +1616,54 @@ TEST_CASE("csv_parser number detection")
     }
 }
 
+
+TEST_CASE("csv_parser long fields")
+{
+    std::string long_text(100, 'x');
+    std::string data = "id;text;quoted;list\n";
+    data += "1;" + long_text + ";'" + long_text + ";\nstill quoted ''here'' " + long_text + "';a|b|" + long_text + "\n";
+    data += "2;" + long_text + "y;'short';" + long_text + "|z\n";
+
+    auto options = csv::csv_options{}
+        .assume_header(true)
+        .field_delimiter(';')
+        .quote_char('\'')
+        .quote_escape_char('\'')
+        .subfield_delimiter('|')
+        .mapping_kind(csv::csv_mapping_kind::n_objects);
+
+    json expected = json::parse(R"(
+[
+    {"id" : 1, "text" : ")" + long_text + R"(", "quoted" : ")" + long_text + R"(;\nstill quoted 'here' )" + long_text + R"(", "list" : ["a","b",")" + long_text + R"("]},
+    {"id" : 2, "text" : ")" + long_text + R"(y", "quoted" : "short", "list" : [")" + long_text + R"(","z"]}
+]
+    )");
+
+    SECTION("whole input")
+    {
+        json j = csv::decode_csv<json>(data, options);
+        CHECK(j == expected);
+    }
+
+    SECTION("chunked input")
+    {
+        for (std::size_t chunk_size : {1, 7, 16, 33})
+        {
+            json_decoder<json> decoder;
+            csv::csv_parser parser(options);
+
+            std::size_t offset = 0;
+            while (!parser.stopped())
+            {
+                if (parser.source_exhausted() && offset < data.size())
+                {
+                    std::size_t length = (std::min)(chunk_size, data.size() - offset);
+                    parser.update(data.data() + offset, length);
+                    offset += length;
+                }
+                parser.parse_some(decoder);
+            }
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+}
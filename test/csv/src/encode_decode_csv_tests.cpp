@@ -234,6 +234,32 @@ TEMPLATE_TEST_CASE("test_csv_encoder_reset", "",
     CHECK(f.string2() == "h5,h6\n5,6\n");
 }
 
+TEST_CASE("encode_csv objects with keys in different order")
+{
+    ojson j = ojson::parse(R"(
+[
+    {"a":1,"b":"x,y","c":true},
+    {"c":false,"a":null,"b":2.5},
+    {"a":3},
+    {"d":9,"c":"z","a":[1,2]}
+]
+    )");
+
+    SECTION("header from first object")
+    {
+        std::string s;
+        csv::encode_csv(j, s, csv::csv_options{}.subfield_delimiter(';'));
+        CHECK(s == "a,b,c\n1,\"x,y\",true\nnull,2.5,false\n3,,\n1;2,,z\n");
+    }
+
+    SECTION("header from column_names")
+    {
+        std::string s;
+        csv::encode_csv(j, s, csv::csv_options{}.column_names("c,a,e"));
+        CHECK(s == "c,a,e\ntrue,1,\nfalse,null,\n,3,\nz,12,\n");
+    }
+}
+
 namespace { namespace ns {
 
     struct Person
@@ -290,3 +316,30 @@ TEST_CASE("encode_csv allocator_set overloads")
 }
 
 #endif
+
+TEST_CASE("csv encoder with chunked_sink")
+{
+    std::string input = R"(a,b,c
+1,"x, y",3.5
+4,z,6
+)";
+    auto options = csv::csv_options{}
+        .assume_header(true);
+    json j = csv::decode_csv<json>(input, options);
+
+    std::string expected;
+    csv::encode_csv(j, expected);
+
+    chunked_buffer<char> buf(4);
+    {
+        csv::basic_csv_encoder<char,chunked_sink<char>> encoder(buf);
+        j.dump(encoder);
+    }
+    std::string result;
+    for (std::size_t i = 0; i < buf.segment_count(); ++i)
+    {
+        auto seg = buf.segment(i);
+        result.append(seg.data(), seg.size());
+    }
+    CHECK(result == expected);
+}
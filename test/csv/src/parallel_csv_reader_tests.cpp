@@ -0,0 +1,246 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <catch/catch.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+#include <jsoncons_ext/csv/parallel_csv_reader.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    ojson parallel_decode(const std::string& input, const csv::csv_options& options, std::size_t num_threads)
+    {
+        csv::parallel_csv_reader reader(input, options, num_threads, 16);
+        json_decoder<ojson> decoder;
+        reader.read(decoder);
+        return decoder.get_result();
+    }
+
+    std::string make_input(std::size_t rows)
+    {
+        std::string input = "id,name,note\n";
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            input += std::to_string(i);
+            input += ",name";
+            input += std::to_string(i);
+            if (i % 3 == 0)
+            {
+                input += ",\"multi\nline, \"\"quoted\"\"\"\n";
+            }
+            else if (i % 5 == 0)
+            {
+                input += ",\"ends with \r\n\"\r\n";
+            }
+            else
+            {
+                input += ",plain\n";
+            }
+        }
+        return input;
+    }
+
+    // Throws std::bad_alloc when used on a thread other than the one that created the reader
+    std::thread::id& allocating_thread()
+    {
+        static std::thread::id id;
+        return id;
+    }
+
+    template <class T>
+    struct same_thread_allocator
+    {
+        using value_type = T;
+
+        same_thread_allocator() = default;
+
+        template <class U>
+        same_thread_allocator(const same_thread_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            if (std::this_thread::get_id() != allocating_thread())
+            {
+                throw std::bad_alloc();
+            }
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const same_thread_allocator&, const same_thread_allocator&) noexcept
+        {
+            return true;
+        }
+
+        friend bool operator!=(const same_thread_allocator&, const same_thread_allocator&) noexcept
+        {
+            return false;
+        }
+    };
+}
+
+TEST_CASE("parallel_csv_reader matches decode_csv")
+{
+    std::string input = make_input(200);
+
+    SECTION("n_objects")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+        ojson expected = csv::decode_csv<ojson>(input, options);
+        for (std::size_t n : {1, 2, 3, 7})
+        {
+            CHECK(parallel_decode(input, options, n) == expected);
+        }
+    }
+
+    SECTION("n_rows")
+    {
+        auto options = csv::csv_options{}
+            .mapping_kind(csv::csv_mapping_kind::n_rows);
+        ojson expected = csv::decode_csv<ojson>(input, options);
+        for (std::size_t n : {1, 2, 3, 7})
+        {
+            CHECK(parallel_decode(input, options, n) == expected);
+        }
+    }
+
+    SECTION("n_rows with header")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .mapping_kind(csv::csv_mapping_kind::n_rows);
+        ojson expected = csv::decode_csv<ojson>(input, options);
+        for (std::size_t n : {2, 5})
+        {
+            CHECK(parallel_decode(input, options, n) == expected);
+        }
+    }
+
+    SECTION("m_columns")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .mapping_kind(csv::csv_mapping_kind::m_columns);
+        ojson expected = csv::decode_csv<ojson>(input, options);
+        for (std::size_t n : {2, 5})
+        {
+            CHECK(parallel_decode(input, options, n) == expected);
+        }
+    }
+
+    SECTION("comments and header lines")
+    {
+        std::string text = "# a comment\n# another\n" + input;
+        auto options = csv::csv_options{}
+            .comment_starter('#')
+            .header_lines(2)
+            .column_names("a,b,c");
+        ojson expected = csv::decode_csv<ojson>(text, options);
+        for (std::size_t n : {2, 4})
+        {
+            CHECK(parallel_decode(text, options, n) == expected);
+        }
+    }
+}
+
+TEST_CASE("parallel_csv_reader read_chunks")
+{
+    std::string input = make_input(100);
+    auto options = csv::csv_options{}
+        .assume_header(true);
+
+    std::istringstream is(input);
+    csv::parallel_csv_reader reader(is, options, 4, 16);
+    CHECK(reader.chunk_count() == 4);
+
+    std::vector<json> chunks = reader.read_chunks<json>();
+    REQUIRE(chunks.size() == 4);
+
+    json expected = csv::decode_csv<json>(input, options);
+    std::size_t index = 0;
+    for (const auto& chunk : chunks)
+    {
+        REQUIRE(chunk.is_array());
+        for (const auto& row : chunk.array_range())
+        {
+            CHECK(row == expected[index]);
+            ++index;
+        }
+    }
+    CHECK(index == expected.size());
+}
+
+TEST_CASE("parallel_csv_reader errors")
+{
+    std::string input = "a,b\n1,2\n3,4\n5,6\n7,8\n9,\"10\"x\n";
+    auto options = csv::csv_options{}
+        .assume_header(true);
+
+    csv::parallel_csv_reader reader(input, options, 2, 4);
+    CHECK(reader.chunk_count() == 2);
+
+    std::error_code ec;
+    std::vector<json> chunks = reader.read_chunks<json>(ec);
+    CHECK(ec == csv::csv_errc::unexpected_char_between_fields);
+    CHECK(chunks.empty());
+
+    std::size_t expected_line = 0;
+    try
+    {
+        csv::decode_csv<json>(input, options);
+    }
+    catch (const ser_error& e)
+    {
+        expected_line = e.line();
+    }
+    try
+    {
+        json_decoder<json> decoder;
+        reader.read(decoder);
+        CHECK(false);
+    }
+    catch (const ser_error& e)
+    {
+        CHECK(e.code() == csv::csv_errc::unexpected_char_between_fields);
+        CHECK(e.line() == expected_line);
+        CHECK(e.line() == 6);
+    }
+}
+
+TEST_CASE("parallel_csv_reader exception on another thread")
+{
+    std::string input = make_input(100);
+    auto options = csv::csv_options{}
+        .assume_header(true);
+
+    allocating_thread() = std::this_thread::get_id();
+    csv::basic_parallel_csv_reader<char,same_thread_allocator<char>> reader(input, options, 4, 16);
+    REQUIRE(reader.chunk_count() == 4);
+
+    SECTION("read")
+    {
+        json_decoder<ojson> decoder;
+        CHECK_THROWS_AS(reader.read(decoder), std::bad_alloc);
+    }
+
+    SECTION("read_chunks")
+    {
+        CHECK_THROWS_AS(reader.read_chunks<json>(), std::bad_alloc);
+    }
+}
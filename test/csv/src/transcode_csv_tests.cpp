@@ -0,0 +1,244 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <catch/catch.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Reads count consecutive top level values
+    template <class Parser>
+    std::vector<json> read_values(Parser& parser, std::size_t count)
+    {
+        std::vector<json> values;
+        json_decoder<json> decoder;
+        basic_item_event_visitor_to_json_visitor<char,std::allocator<char>> adaptor(decoder);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::error_code ec;
+            parser.reset();
+            parser.parse(adaptor, ec);
+            REQUIRE_FALSE(ec);
+            REQUIRE(decoder.is_valid());
+            values.push_back(decoder.get_result());
+        }
+        return values;
+    }
+
+    std::vector<json> read_msgpack_values(const std::vector<uint8_t>& data, std::size_t count)
+    {
+        msgpack::basic_msgpack_parser<bytes_source> parser(data);
+        return read_values(parser, count);
+    }
+
+    std::vector<json> read_cbor_values(const std::vector<uint8_t>& data, std::size_t count)
+    {
+        cbor::basic_cbor_parser<bytes_source> parser(data);
+        return read_values(parser, count);
+    }
+
+} // namespace
+
+TEST_CASE("transcode_csv_sequence to msgpack")
+{
+    std::string input = R"(id,price,ok,name
+1,1.5,true,"a, b"
+2,,false,c
+3,2.25,true,
+)";
+
+    SECTION("n_objects")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        std::vector<uint8_t> data;
+        msgpack::msgpack_bytes_encoder encoder(data);
+        csv::transcode_csv_sequence(input, encoder, options);
+
+        json expected = csv::decode_csv<json>(input, options);
+        std::vector<json> values = read_msgpack_values(data, 3);
+        REQUIRE(expected.size() == values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            CHECK(expected[i] == values[i]);
+        }
+    }
+
+    SECTION("n_rows")
+    {
+        auto options = csv::csv_options{}
+            .mapping_kind(csv::csv_mapping_kind::n_rows);
+
+        std::stringstream is(input);
+        std::vector<uint8_t> data;
+        msgpack::msgpack_bytes_encoder encoder(data);
+        csv::transcode_csv_sequence(is, encoder, options);
+
+        json expected = csv::decode_csv<json>(input, options);
+        std::vector<json> values = read_msgpack_values(data, 4);
+        REQUIRE(expected.size() == values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            CHECK(expected[i] == values[i]);
+        }
+    }
+
+    SECTION("subfields")
+    {
+        std::string subfields = R"(name,scores
+a,1;2;3
+b,4
+)";
+        auto options = csv::csv_options{}
+            .assume_header(true)
+            .subfield_delimiter(';');
+
+        std::vector<uint8_t> data;
+        msgpack::msgpack_bytes_encoder encoder(data);
+        csv::transcode_csv_sequence(subfields, encoder, options);
+
+        json expected = csv::decode_csv<json>(subfields, options);
+        std::vector<json> values = read_msgpack_values(data, 2);
+        CHECK(expected[0] == values[0]);
+        CHECK(expected[1] == values[1]);
+    }
+}
+
+TEST_CASE("transcode_csv m_columns blocks")
+{
+    std::string input = R"(id,price,name
+1,1.5,a
+2,2.5,b
+3,,c
+)";
+
+    auto options = csv::csv_options{}
+        .assume_header(true)
+        .mapping_kind(csv::csv_mapping_kind::m_columns);
+
+    SECTION("blocks of two rows to msgpack")
+    {
+        std::vector<uint8_t> data;
+        msgpack::msgpack_bytes_encoder encoder(data);
+        csv::transcode_csv_sequence(input, encoder, options, 2);
+
+        std::vector<json> values = read_msgpack_values(data, 2);
+        CHECK(values[0] == json::parse(R"({"id":[1,2],"price":[1.5,2.5],"name":["a","b"]})"));
+        CHECK(values[1] == json::parse(R"({"id":[3],"price":[null],"name":["c"]})"));
+    }
+
+    SECTION("all rows to cbor typed arrays")
+    {
+        std::vector<uint8_t> data;
+        auto cbor_options = cbor::cbor_options{}
+            .use_typed_arrays(true);
+        cbor::cbor_bytes_encoder encoder(data, cbor_options);
+        csv::transcode_csv(input, encoder, options);
+
+        // id is written as a tagged typed array (tags 64 to 87), price has a null
+        std::size_t typed_arrays = 0;
+        for (std::size_t i = 0; i + 1 < data.size(); ++i)
+        {
+            if (data[i] == 0xd8 && data[i+1] >= 64 && data[i+1] <= 87)
+            {
+                ++typed_arrays;
+            }
+        }
+        CHECK(typed_arrays == 1);
+
+        std::vector<json> values = read_cbor_values(data, 1);
+        CHECK(values[0] == json::parse(R"({"id":[1,2,3],"price":[1.5,2.5,null],"name":["a","b","c"]})"));
+    }
+
+    SECTION("blocks of two rows to cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::cbor_bytes_encoder encoder(data);
+        csv::transcode_csv(input, encoder, options, 2);
+
+        REQUIRE_FALSE(data.empty());
+        CHECK(data.front() == 0x9f); // indefinite length array
+        CHECK(cbor::decode_cbor<json>(data) == json::parse(R"([{"id":[1,2],"price":[1.5,2.5],"name":["a","b"]},{"id":[3],"price":[null],"name":["c"]}])"));
+    }
+}
+
+TEST_CASE("transcode_csv to cbor")
+{
+    std::string input = R"(id,price,ok,name
+1,1.5,true,"a, b"
+2,,false,c
+3,2.25,true,
+)";
+
+    SECTION("n_objects")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        std::vector<uint8_t> data;
+        cbor::cbor_bytes_encoder encoder(data);
+        csv::transcode_csv(input, encoder, options);
+
+        REQUIRE_FALSE(data.empty());
+        CHECK(data.front() == 0x9f); // indefinite length array
+        CHECK(cbor::decode_cbor<json>(data) == csv::decode_csv<json>(input, options));
+    }
+
+    SECTION("n_rows")
+    {
+        auto options = csv::csv_options{}
+            .mapping_kind(csv::csv_mapping_kind::n_rows);
+
+        std::stringstream is(input);
+        std::vector<uint8_t> data;
+        cbor::cbor_bytes_encoder encoder(data);
+        csv::transcode_csv(is, encoder, options);
+
+        CHECK(cbor::decode_cbor<json>(data) == csv::decode_csv<json>(input, options));
+    }
+
+    SECTION("empty")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        std::vector<uint8_t> data;
+        cbor::cbor_bytes_encoder encoder(data);
+        csv::transcode_csv(std::string("id,price\n"), encoder, options);
+
+        CHECK(cbor::decode_cbor<json>(data) == csv::decode_csv<json>(std::string("id,price\n"), options));
+    }
+
+    SECTION("msgpack needs a sequence")
+    {
+        auto options = csv::csv_options{}
+            .assume_header(true);
+
+        std::vector<uint8_t> data;
+        msgpack::msgpack_bytes_encoder encoder(data);
+        CHECK_THROWS_AS(csv::transcode_csv(input, encoder, options), ser_error);
+    }
+}
+
+TEST_CASE("transcode_csv error")
+{
+    std::string input = "a,b\n1,\"10\"x\n";
+
+    std::vector<uint8_t> data;
+    msgpack::msgpack_bytes_encoder encoder(data);
+    auto options = csv::csv_options{}
+        .assume_header(true);
+    REQUIRE_THROWS_AS(csv::transcode_csv_sequence(input, encoder, options), ser_error);
+}
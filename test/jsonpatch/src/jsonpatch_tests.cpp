@@ -194,3 +194,48 @@ TEST_CASE("jsonpatch - remove two items from array")
 
 
 
+
+TEST_CASE("jsonpatch copy_on_write_policy tests")
+{
+    using cjson = jsoncons::basic_json<char,jsoncons::copy_on_write_policy<jsoncons::sorted_policy>>;
+
+    cjson source = cjson::parse(R"(
+        {"baz" : "qux", "foo" : ["bar","baz"], "nested" : {"a" : [1,2,3], "b" : [4,5,6]}}
+    )");
+    const cjson expected_source = source;
+
+    SECTION("apply patch to a copy")
+    {
+        cjson patch = cjson::parse(R"(
+            [{"op" : "test", "path" : "/baz", "value" : "qux"}, {"op" : "add", "path" : "/nested/a/-", "value" : 4}]
+        )");
+
+        cjson target = source;
+        std::error_code ec;
+        jsonpatch::apply_patch(target, patch, ec);
+        REQUIRE_FALSE(ec);
+
+        CHECK(target["nested"]["a"].size() == 4);
+        CHECK(source == expected_source);
+
+        const cjson& t = target;
+        const cjson& s = source;
+        CHECK(std::addressof(t["foo"][0]) == std::addressof(s["foo"][0]));
+        CHECK(std::addressof(t["nested"]["b"][0]) == std::addressof(s["nested"]["b"][0]));
+    }
+
+    SECTION("failed patch of a copy")
+    {
+        cjson patch = cjson::parse(R"(
+            [{"op" : "remove", "path" : "/nested/a"}, {"op" : "test", "path" : "/baz", "value" : "quux"}]
+        )");
+
+        cjson target = source;
+        std::error_code ec;
+        jsonpatch::apply_patch(target, patch, ec);
+        CHECK(ec == jsonpatch::jsonpatch_errc::test_failed);
+
+        CHECK(target == expected_source);
+        CHECK(source == expected_source);
+    }
+}
@@ -84,3 +84,30 @@ TEST_CASE("mergepatch tests")
     }
 }
 
+
+TEST_CASE("mergepatch copy_on_write_policy tests")
+{
+    using cjson = jsoncons::basic_json<char,jsoncons::copy_on_write_policy<jsoncons::sorted_policy>>;
+
+    cjson source = cjson::parse(R"(
+        {"title" : "Goodbye!", "author" : {"givenName" : "John", "familyName" : "Doe"}, "tags" : ["example","sample"], "content" : "This will be unchanged"}
+    )");
+    const cjson expected_source = source;
+
+    cjson patch = cjson::parse(R"(
+        {"title" : "Hello!", "phoneNumber" : "+01-123-456-7890", "author" : {"familyName" : null}}
+    )");
+
+    cjson target = source;
+    jsoncons::mergepatch::apply_merge_patch(target, patch);
+
+    cjson expected = cjson::parse(R"(
+        {"title" : "Hello!", "author" : {"givenName" : "John"}, "tags" : ["example","sample"], "content" : "This will be unchanged", "phoneNumber" : "+01-123-456-7890"}
+    )");
+    CHECK(target == expected);
+    CHECK(source == expected_source);
+
+    const cjson& t = target;
+    const cjson& s = source;
+    CHECK(std::addressof(t["tags"][0]) == std::addressof(s["tags"][0]));
+}
@@ -169,3 +169,292 @@ TEST_CASE("encode_msgpack allocator_set overloads")
 }
 
 #endif
+
+TEST_CASE("msgpack encoded_size and fixed size buffer")
+{
+    json j = json::parse(R"(
+    {
+        "name" : "John Smith",
+        "photo" : null,
+        "tags" : ["a", "bb", "ccc", 1, -1000, 1.5, true],
+        "scores" : {"math" : 95, "physics" : 83.25}
+    }
+    )");
+    j["photo"] = json(byte_string_arg, std::vector<uint8_t>(300, 'x'));
+
+    std::vector<uint8_t> expected;
+    msgpack::encode_msgpack(j, expected);
+
+    SECTION("json encoded_size")
+    {
+        CHECK(msgpack::encoded_size(j) == expected.size());
+    }
+    SECTION("custom encoded_size")
+    {
+        ns::Person person{"John Smith"};
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(person, data);
+        CHECK(msgpack::encoded_size(person) == data.size());
+    }
+    SECTION("pre-reserved container")
+    {
+        std::vector<uint8_t> data;
+        data.reserve(msgpack::encoded_size(j));
+        const uint8_t* p = data.data();
+        msgpack::encode_msgpack(j, data);
+        CHECK(data.data() == p);
+        CHECK(data == expected);
+    }
+    SECTION("fixed size buffer")
+    {
+        std::vector<uint8_t> buffer(1024, 0xff);
+        std::size_t n = msgpack::encode_msgpack(j, jsoncons::span<uint8_t>(buffer.data(), buffer.size()));
+        REQUIRE(n == expected.size());
+        CHECK(std::equal(expected.begin(), expected.end(), buffer.begin()));
+        CHECK(buffer[n] == 0xff);
+    }
+    SECTION("buffer too small")
+    {
+        std::vector<uint8_t> buffer(expected.size() - 1);
+        REQUIRE_THROWS_WITH(msgpack::encode_msgpack(j, jsoncons::span<uint8_t>(buffer.data(), buffer.size())),
+                            Catch::Matchers::Contains(msgpack::make_error_code(msgpack::msgpack_errc::buffer_too_small).message()));
+    }
+}
+
+TEST_CASE("msgpack_batch_encoder and msgpack_batch_decoder")
+{
+    std::vector<json> records;
+    records.push_back(json::parse(R"({"id":1,"name":"Alice","tags":["x","y"]})"));
+    records.push_back(json::parse(R"({"id":2,"name":"Bob","tags":["x","y"]})"));
+    records.push_back(json::parse(R"([1.5,"Alice",null,true])"));
+
+    SECTION("json records")
+    {
+        std::vector<uint8_t> expected;
+        std::vector<std::size_t> expected_offsets;
+        for (const auto& rec : records)
+        {
+            expected_offsets.push_back(expected.size());
+            msgpack::encode_msgpack(rec, expected);
+        }
+
+        std::vector<uint8_t> data;
+        msgpack::msgpack_batch_encoder encoder(data);
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            CHECK(encoder.encode(records[i]) == expected_offsets[i]);
+        }
+        CHECK(encoder.offsets() == expected_offsets);
+        CHECK(data == expected);
+
+        msgpack::msgpack_batch_decoder<json> decoder;
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            std::size_t end = i+1 < records.size() ? expected_offsets[i+1] : data.size();
+            std::vector<uint8_t> record(data.begin()+expected_offsets[i], data.begin()+end);
+            CHECK(decoder.decode(record) == records[i]);
+        }
+    }
+    SECTION("custom records and reset")
+    {
+        std::vector<uint8_t> data1;
+        msgpack::msgpack_batch_encoder encoder(data1);
+        encoder.encode(ns::Person{"John Smith"});
+        encoder.encode(ns::Person{"Jane Doe"});
+        CHECK(encoder.offsets().size() == 2);
+
+        std::vector<uint8_t> data2;
+        encoder.reset(data2);
+        CHECK(encoder.offsets().empty());
+        encoder.encode(ns::Person{"Jane Doe"});
+        CHECK(encoder.offsets() == std::vector<std::size_t>{0});
+
+        std::vector<uint8_t> record(data1.begin()+encoder.offsets()[0], data1.end());
+        CHECK(data2 == std::vector<uint8_t>(data1.begin()+static_cast<std::ptrdiff_t>(data1.size()-data2.size()), data1.end()));
+        CHECK(msgpack::decode_msgpack<ns::Person>(data2).name == "Jane Doe");
+    }
+    SECTION("decoder recovers after error")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(records[0], data);
+        std::vector<uint8_t> truncated(data.begin(), data.begin()+static_cast<std::ptrdiff_t>(data.size()/2));
+
+        msgpack::msgpack_batch_decoder<json> decoder;
+        std::error_code ec;
+        decoder.decode(truncated, ec);
+        CHECK(ec);
+        ec = std::error_code();
+        CHECK(decoder.decode(data, ec) == records[0]);
+        CHECK_FALSE(ec);
+    }
+}
+
+TEST_CASE("msgpack columnar_arrays")
+{
+    json j = json::parse(R"(
+{
+    "readings" : [
+        {"sensor" : "a1", "count" : 1, "temperature" : 20.5, "ok" : true},
+        {"sensor" : "b2", "count" : 300, "temperature" : 21.25, "ok" : false},
+        {"sensor" : "c3", "count" : 70000, "temperature" : 19.1, "ok" : true},
+        {"sensor" : "a1", "count" : -5, "temperature" : 22.0, "ok" : null}
+    ],
+    "other" : [{"a" : 1}, {"b" : 2}],
+    "empty" : []
+}
+    )");
+
+    auto options = msgpack::msgpack_options{}
+        .columnar_arrays(true);
+
+    SECTION("round trip")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(j, data, options);
+
+        std::vector<uint8_t> row_data;
+        msgpack::encode_msgpack(j, row_data);
+        CHECK(data != row_data);
+
+        CHECK(msgpack::decode_msgpack<json>(data, options) == j);
+    }
+
+    SECTION("smaller for many rows")
+    {
+        json rows(json_array_arg);
+        for (int i = 0; i < 100; ++i)
+        {
+            json row;
+            row.try_emplace("id", i);
+            row.try_emplace("value", i*0.5);
+            rows.push_back(std::move(row));
+        }
+
+        CHECK(msgpack::encoded_size(rows, options) < msgpack::encoded_size(rows));
+
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(rows, data, options);
+        CHECK(msgpack::decode_msgpack<json>(data, options) == rows);
+    }
+
+    SECTION("cursor")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(j.at("readings"), data, options);
+
+        msgpack::msgpack_bytes_cursor cursor(data, options);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        CHECK(cursor.current().size() == 4);
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("count"));
+        cursor.next();
+        CHECK(cursor.current().get<int>() == 300);
+        cursor.next();
+        cursor.next();
+        CHECK_FALSE(cursor.current().get<bool>());
+        cursor.next();
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("b2"));
+        cursor.next();
+        cursor.next();
+        CHECK(cursor.current().get<double>() == 21.25);
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.reset(data);
+        cursor.skip();
+        CHECK(cursor.done());
+    }
+
+    SECTION("tagged values are written row by row")
+    {
+        json rows(json_array_arg);
+        for (int i = 0; i < 3; ++i)
+        {
+            json row;
+            row.try_emplace("time", "2023-01-01T00:00:00Z", semantic_tag::datetime);
+            row.try_emplace("value", i);
+            rows.push_back(std::move(row));
+        }
+
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(rows, data, options);
+        std::vector<uint8_t> row_data;
+        msgpack::encode_msgpack(rows, row_data);
+        CHECK(data == row_data);
+    }
+
+    SECTION("doubles outside the range of float")
+    {
+        json rows(json_array_arg);
+        const double values[] = {1.5, 1e300, -1e300, 3.5e38};
+        for (double d : values)
+        {
+            json row;
+            row.try_emplace("value", d);
+            rows.push_back(std::move(row));
+        }
+
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(rows, data, options);
+        CHECK(msgpack::decode_msgpack<json>(data, options) == rows);
+    }
+
+    SECTION("not decoded without option")
+    {
+        std::vector<uint8_t> data;
+        msgpack::encode_msgpack(j.at("readings"), data, options);
+
+        json other = msgpack::decode_msgpack<json>(data);
+        CHECK(other.is_byte_string());
+        CHECK(other.tag() == semantic_tag::ext);
+        CHECK(other.ext_tag() == msgpack::columnar_array_ext_type);
+    }
+}
+
+namespace {
+
+    // A user supplied sink with push_back but no append
+    class push_back_only_sink
+    {
+        std::vector<uint8_t>& buffer_;
+    public:
+        using value_type = uint8_t;
+
+        push_back_only_sink(std::vector<uint8_t>& buffer)
+            : buffer_(buffer)
+        {
+        }
+
+        void push_back(uint8_t ch)
+        {
+            buffer_.push_back(ch);
+        }
+
+        void flush()
+        {
+        }
+    };
+
+} // namespace
+
+TEST_CASE("msgpack encode to sink without append")
+{
+    json j;
+    j["name"] = "Jane Doe";
+    j["data"] = json(byte_string_arg, std::vector<uint8_t>{'a','b','c'});
+
+    std::vector<uint8_t> expected;
+    msgpack::encode_msgpack(j, expected);
+
+    std::vector<uint8_t> buffer;
+    msgpack::basic_msgpack_encoder<push_back_only_sink> encoder(buffer);
+    j.dump(encoder);
+
+    CHECK(buffer == expected);
+}
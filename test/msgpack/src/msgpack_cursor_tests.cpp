@@ -386,3 +386,61 @@ TEMPLATE_TEST_CASE("msgpack_cursor reset test", "",
         CHECK(cursor.done());
     }
 }
+
+TEST_CASE("msgpack_cursor skip test")
+{
+    ojson j = ojson::parse(R"(
+    {
+        "first": [1, {"x": "skipped string", "y": [1.5, -2, true, null, 300, -40000]}, "abc"],
+        "second": {"c": -5, "d": "skipped too"},
+        "third": 10
+    }
+    )");
+    std::vector<uint8_t> data;
+    msgpack::encode_msgpack(j, data);
+
+    SECTION("nested containers")
+    {
+        msgpack::msgpack_bytes_cursor cursor(data);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("first"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("second"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("third"));
+        cursor.next();
+        cursor.skip(); // not a container, same as next
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.done());
+    }
+
+    SECTION("skip root")
+    {
+        msgpack::msgpack_bytes_cursor cursor(data);
+        std::error_code ec;
+        cursor.skip(ec);
+        REQUIRE_FALSE(ec);
+        CHECK(cursor.done());
+    }
+
+    SECTION("unexpected eof")
+    {
+        data.resize(20);
+
+        msgpack::msgpack_bytes_cursor cursor(data);
+        cursor.next();
+        cursor.next();
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == msgpack::msgpack_errc::unexpected_eof);
+    }
+}
+
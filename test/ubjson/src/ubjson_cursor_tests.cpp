@@ -413,3 +413,94 @@ TEMPLATE_TEST_CASE("ubjson_cursor reset test", "",
         CHECK(cursor.done());
     }
 }
+
+TEST_CASE("ubjson_cursor skip test")
+{
+    SECTION("nested containers")
+    {
+        ojson j = ojson::parse(R"(
+        {
+            "first": [1, {"x": "skipped string", "y": [1.5, -2, true, null]}, "abc"],
+            "second": {"c": -5, "d": "skipped too"},
+            "third": 10
+        }
+        )");
+        std::vector<uint8_t> data;
+        ubjson::encode_ubjson(j, data);
+
+        ubjson::ubjson_bytes_cursor cursor(data);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        CHECK(cursor.current().get<std::string>() == std::string("first"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("second"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("third"));
+        cursor.next();
+        CHECK(cursor.current().get<int>() == 10);
+        cursor.skip(); // not a container, same as next
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.done());
+    }
+
+    SECTION("strongly typed and indefinite containers")
+    {
+        std::vector<uint8_t> data = {
+            '{',
+                'i',1,'a', '[','$','l','#','i',3, 0,0,0,1, 0,0,0,2, 0,0,0,3, // "a": [1,2,3] as int32
+                'i',1,'b', '{','$','S','#','i',1, 'i',1,'k', 'i',2,'v','w', // "b": {"k":"vw"}
+                'i',1,'c', '[', '[',']', 'S','i',1,'z', ']', // "c": [[],"z"]
+                'i',1,'d', 'T',
+            '}'
+        };
+
+        ubjson::ubjson_bytes_cursor cursor(data);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.next();
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("b"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_object);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("c"));
+        cursor.next();
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        cursor.skip();
+        REQUIRE(cursor.current().event_type() == staj_event_type::key);
+        CHECK(cursor.current().get<std::string>() == std::string("d"));
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::bool_value);
+        cursor.next();
+        CHECK(cursor.current().event_type() == staj_event_type::end_object);
+        cursor.next();
+        CHECK(cursor.done());
+    }
+
+    SECTION("strongly typed count too large")
+    {
+        std::vector<uint8_t> data = {
+            '[',
+                '[','$','L','#','L', 0x20,0,0,0,0,0,0,1, 0,0,0,0,0,0,0,1,
+            ']'
+        };
+        auto options = ubjson::ubjson_options{}
+            .max_items((std::numeric_limits<std::size_t>::max)());
+
+        ubjson::ubjson_bytes_cursor cursor(data, options);
+        REQUIRE(cursor.current().event_type() == staj_event_type::begin_array);
+        std::error_code ec;
+        cursor.skip(ec);
+        CHECK(ec == ubjson::ubjson_errc::number_too_large);
+    }
+}